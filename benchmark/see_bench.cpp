@@ -0,0 +1,96 @@
+/**
+ * @file see_bench.cpp
+ * @brief Exact SEE vs threshold SEE (see_ge) throughput on search-shaped
+ *        captures (user-036).
+ *
+ * Build with -DHUGINN_BENCHMARKS=ON. Collects every capture from the bench
+ * positions and from positions a few random plies away from them (so both
+ * quiet openings and tactical middlegames are represented), then times the
+ * question every search call site asks — "is SEE >= 0?" — answered both ways.
+ * Checks that the two agree on every capture before timing.
+ *
+ * Usage: see_bench [iterations=2000]
+ *
+ * @author MTDuke71
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "init.hpp"
+#include "movegen.hpp"
+#include "position.hpp"
+#include "see.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Capture {
+    Position pos;
+    S_MOVE move;
+};
+
+template <typename Body>
+double time_ns_per_call(const std::vector<Capture>& captures, int iterations, Body body) {
+    const auto start = Clock::now();
+    for (int it = 0; it < iterations; ++it)
+        for (const auto& c : captures) body(c);
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return ns / (static_cast<double>(iterations) * captures.size());
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 2000;
+    Huginn::init();
+
+    std::mt19937 rng(0x5EE);
+    std::vector<Capture> captures;
+    for (const auto& fen : Huginn::bench_positions()) {
+        Position pos;
+        if (!pos.set_from_fen(fen)) continue;
+        for (int ply = 0; ply < 8; ++ply) {
+            S_MOVELIST list;
+            generate_legal_moves(pos, list);
+            if (list.count == 0) break;
+            for (int i = 0; i < list.count; ++i) {
+                if (list.moves[i].is_capture() && !list.moves[i].is_promotion())
+                    captures.push_back({pos, list.moves[i]});
+            }
+            pos.MakeMove(list.moves[rng() % list.count]);
+        }
+    }
+    // Position copies carry their undo stacks; SEE never reads them.
+    for (auto& c : captures) c.pos.move_history.clear();
+
+    int losing = 0;
+    for (const auto& c : captures) {
+        const bool exact = Huginn::see(c.pos, c.move) >= 0;
+        if (exact != Huginn::see_ge(c.pos, c.move, 0)) {
+            std::cerr << "mismatch: " << c.pos.to_fen() << ' ' << c.move.to_string() << '\n';
+            return 1;
+        }
+        losing += !exact;
+    }
+
+    std::cout << captures.size() << " captures (" << losing << " losing)\n";
+    long long sink = 0;
+    const double exact = time_ns_per_call(captures, iterations, [&](const Capture& c) {
+        sink += Huginn::see(c.pos, c.move) >= 0;
+    });
+    const double ge = time_ns_per_call(captures, iterations, [&](const Capture& c) {
+        sink += Huginn::see_ge(c.pos, c.move, 0);
+    });
+    std::cout << std::fixed << std::setprecision(1)
+              << "  see() >= 0        " << std::setw(7) << exact << " ns/call\n"
+              << "  see_ge(..., 0)    " << std::setw(7) << ge << " ns/call"
+              << "  (sink " << (sink & 0xFFFF) << ")\n";
+    return 0;
+}
@@ -1,177 +1,76 @@
 /**
  * @file attack_tables.cpp
- * @brief Implementation of pre-computed attack table generation
- * 
- * This file generates the attack bitboards for non-sliding pieces at startup.
- * The initialization functions use traditional move pattern logic to generate
- * the bitboard representations, creating a fast lookup table for runtime use.
- * 
- * ## Implementation Strategy
- * 
- * **Knight patterns**: Use traditional +/- 2,1 and +/- 1,2 offset pattern
- * **King patterns**: Use 8-direction offset pattern for adjacent squares  
- * **Pawn patterns**: Use diagonal capture patterns with color-specific direction
- * 
- * ## Performance Design
- * 
- * - **One-time cost**: Initialization happens once at engine startup
- * - **Runtime benefit**: O(1) lookup replaces O(k) pattern calculation
- * - **Memory efficiency**: ~6KB total for all non-sliding attack tables
- * - **Cache friendly**: Linear arrays with optimal memory layout
- * 
+ * @brief Compile-time self-checks for the leaper attack tables
+ *
+ * The knight, king and pawn tables are generated at compile time by the
+ * constexpr generators in attack_tables.hpp (user-030); there is nothing left
+ * to initialize at startup. This translation unit holds the static_asserts
+ * that used to be implicit in "the runtime loop ran": if a generator or offset
+ * list is ever edited incorrectly, the build fails here instead of search
+ * quietly missing attacks.
+ *
+ * ## What is checked
+ *
+ * - **Spot values**: corner/centre squares against hand-written bitboards
+ * - **Totals**: 336 knight and 420 king attack pairs over the whole board
+ * - **Symmetry**: knight/king attacks are mutual; a white pawn on A attacks B
+ *   exactly when a black pawn on B attacks A
+ * - **Edges**: no pawn attacks from the last rank it could never stand on
+ *
  * @author MTDuke71
- * @version 1.0
- * @see attack_tables.hpp for interface documentation
+ * @version 2.0
+ * @see attack_tables.hpp for the tables and generators
  */
 
 #include "attack_tables.hpp"
-#include "bitboard.hpp"
-#include "square.hpp"
 
-// ============================================================================
-// ATTACK TABLE STORAGE
-// ============================================================================
+#include <bit>
 
-/// Knight attack table: indexed by square (0-63)
-uint64_t knight_attacks[64];
+namespace {
 
-/// King attack table: indexed by square (0-63)
-uint64_t king_attacks[64];
+constexpr int W = static_cast<int>(Color::White);
+constexpr int B = static_cast<int>(Color::Black);
 
-/// Pawn attack table: indexed by [color][square]
-uint64_t pawn_attacks[2][64];
-
-// ============================================================================
-// KNIGHT ATTACK GENERATION
-// ============================================================================
-
-/**
- * @brief Generate knight attack bitboard for a specific square
- * @param square The square to generate knight attacks for (0-63)
- * @return Bitboard representing all squares a knight on 'square' can attack
- */
-static uint64_t generate_knight_attacks(int square) {
-    uint64_t attacks = 0ULL;
-    
-    // Knight moves: 8 possible L-shaped moves
-    // Each move is +/- 2 in one direction, +/- 1 in the other
-    const int knight_moves[8][2] = {
-        {-2, -1}, {-2, +1},  // Up 2, left/right 1
-        {-1, -2}, {-1, +2},  // Up 1, left/right 2  
-        {+1, -2}, {+1, +2},  // Down 1, left/right 2
-        {+2, -1}, {+2, +1}   // Down 2, left/right 1
-    };
-    
-    int file = square % 8;
-    int rank = square / 8;
-    
-    for (int i = 0; i < 8; i++) {
-        int new_rank = rank + knight_moves[i][0];
-        int new_file = file + knight_moves[i][1];
-        
-        // Check if the new position is within board bounds
-        if (new_rank >= 0 && new_rank < 8 && new_file >= 0 && new_file < 8) {
-            int target_square = new_rank * 8 + new_file;
-            setBit(attacks, target_square);
-        }
-    }
-    
-    return attacks;
+constexpr int total_attacks(const std::array<uint64_t, 64>& table) {
+    int total = 0;
+    for (uint64_t bb : table) total += std::popcount(bb);
+    return total;
 }
 
-// ============================================================================
-// KING ATTACK GENERATION  
-// ============================================================================
-
-/**
- * @brief Generate king attack bitboard for a specific square
- * @param square The square to generate king attacks for (0-63)
- * @return Bitboard representing all squares a king on 'square' can attack
- */
-static uint64_t generate_king_attacks(int square) {
-    uint64_t attacks = 0ULL;
-    
-    // King moves: 8 possible adjacent squares
-    const int king_moves[8][2] = {
-        {-1, -1}, {-1,  0}, {-1, +1},  // Up row: left, center, right
-        { 0, -1},           { 0, +1},  // Same row: left, right
-        {+1, -1}, {+1,  0}, {+1, +1}   // Down row: left, center, right
-    };
-    
-    int file = square % 8;
-    int rank = square / 8;
-    
-    for (int i = 0; i < 8; i++) {
-        int new_rank = rank + king_moves[i][0];
-        int new_file = file + king_moves[i][1];
-        
-        // Check if the new position is within board bounds
-        if (new_rank >= 0 && new_rank < 8 && new_file >= 0 && new_file < 8) {
-            int target_square = new_rank * 8 + new_file;
-            setBit(attacks, target_square);
-        }
-    }
-    
-    return attacks;
+constexpr bool is_mutual(const std::array<uint64_t, 64>& table) {
+    for (int a = 0; a < 64; a++)
+        for (int b = 0; b < 64; b++)
+            if (((table[a] >> b) & 1ULL) != ((table[b] >> a) & 1ULL)) return false;
+    return true;
 }
 
-// ============================================================================
-// PAWN ATTACK GENERATION
-// ============================================================================
-
-/**
- * @brief Generate pawn attack bitboard for a specific square and color
- * @param square The square to generate pawn attacks for (0-63)
- * @param color The color of the pawn (WHITE or BLACK)
- * @return Bitboard representing squares the pawn can capture
- */
-static uint64_t generate_pawn_attacks(int square, Color color) {
-    uint64_t attacks = 0ULL;
-    
-    int file = square % 8;
-    int rank = square / 8;
-    
-    // Determine attack direction based on color
-    int rank_direction = (color == Color::White) ? +1 : -1;  // White moves up, Black moves down
-    int attack_rank = rank + rank_direction;
-    
-    // Check if attack rank is within bounds
-    if (attack_rank >= 0 && attack_rank < 8) {
-        // Left diagonal capture
-        if (file > 0) {  // Not on A-file
-            int left_attack_square = attack_rank * 8 + (file - 1);
-            setBit(attacks, left_attack_square);
-        }
-        
-        // Right diagonal capture  
-        if (file < 7) {  // Not on H-file
-            int right_attack_square = attack_rank * 8 + (file + 1);
-            setBit(attacks, right_attack_square);
-        }
-    }
-    
-    return attacks;
+constexpr bool pawn_tables_mirror() {
+    for (int a = 0; a < 64; a++)
+        for (int b = 0; b < 64; b++)
+            if (((pawn_attacks[W][a] >> b) & 1ULL) != ((pawn_attacks[B][b] >> a) & 1ULL)) return false;
+    return true;
 }
 
-// ============================================================================
-// INITIALIZATION FUNCTIONS
-// ============================================================================
+// Spot values (a1 = 0, h8 = 63).
+static_assert(knight_attacks[0]  == 0x0000000000020400ULL, "knight a1 -> b3, c2");
+static_assert(knight_attacks[63] == 0x0020400000000000ULL, "knight h8 -> g6, f7");
+static_assert(knight_attacks[28] == 0x0000284400442800ULL, "knight e4 -> 8 squares");
+static_assert(king_attacks[0]    == 0x0000000000000302ULL, "king a1 -> a2, b1, b2");
+static_assert(king_attacks[28]   == 0x0000003828380000ULL, "king e4 -> 8 squares");
+static_assert(pawn_attacks[W][12] == 0x0000000000280000ULL, "white pawn e2 -> d3, f3");
+static_assert(pawn_attacks[B][52] == 0x0000280000000000ULL, "black pawn e7 -> d6, f6");
+static_assert(pawn_attacks[W][8]  == 0x0000000000020000ULL, "white pawn a2 -> b3 only");
 
-void init_attack_tables() {
-    // Initialize knight attack table
-    for (int square = 0; square < 64; square++) {
-        knight_attacks[square] = generate_knight_attacks(square);
-    }
-    
-    // Initialize king attack table
-    for (int square = 0; square < 64; square++) {
-        king_attacks[square] = generate_king_attacks(square);
-    }
-    
-    // Initialize pawn attack tables for both colors
-    for (int square = 0; square < 64; square++) {
-        pawn_attacks[static_cast<int>(Color::White)][square] = generate_pawn_attacks(square, Color::White);
-        pawn_attacks[static_cast<int>(Color::Black)][square] = generate_pawn_attacks(square, Color::Black);
-    }
-}
+// Whole-board totals.
+static_assert(total_attacks(knight_attacks) == 336, "knight attack pair count");
+static_assert(total_attacks(king_attacks) == 420, "king attack pair count");
+static_assert(total_attacks(pawn_attacks[W]) == 98, "white pawn attack pair count");
+static_assert(total_attacks(pawn_attacks[B]) == 98, "black pawn attack pair count");
+
+// Structure.
+static_assert(is_mutual(knight_attacks), "knight attacks must be symmetric");
+static_assert(is_mutual(king_attacks), "king attacks must be symmetric");
+static_assert(pawn_tables_mirror(), "white/black pawn attacks must mirror each other");
+static_assert(pawn_attacks[W][63] == 0 && pawn_attacks[B][0] == 0, "no pawn attacks off the board");
 
+} // namespace
@@ -23,14 +23,11 @@
  * **Memory usage**: ~6KB for non-sliding pieces (minimal footprint)
  * **Lookup speed**: O(1) direct array access (fastest possible)
  * **Cache efficiency**: Linear memory layout for optimal cache usage
- * **Initialization**: One-time setup during engine startup
+ * **Initialization**: None — generated at compile time (user-030)
  * 
  * ## Usage Examples
  * 
  * ```cpp
- * // Initialize attack tables (call once at startup)
- * init_attack_tables();
- * 
  * // Get knight attacks from e4
  * uint64_t knight_moves = knight_attacks[SQ_E4];
  * 
@@ -49,24 +46,80 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include "chess_types.hpp"
 #include "bitboard.hpp"
 
 // ============================================================================
-// ATTACK TABLE DECLARATIONS
+// COMPILE-TIME GENERATORS
+// ============================================================================
+//
+// user-030: the leaper tables used to be filled by init_attack_tables() at
+// startup. They are pure functions of the square, so they are now built by
+// the constexpr generators below and baked into the binary; attack_tables.cpp
+// static_asserts their shape in place of a runtime check.
+
+namespace AttackGen {
+
+/// @brief Bitboard of the on-board squares reached from @p square by the
+///        given (rank, file) offsets.
+template <int N>
+constexpr uint64_t leaper_attacks(int square, const int (&offsets)[N][2]) {
+    uint64_t attacks = 0ULL;
+    const int rank = square / 8;
+    const int file = square % 8;
+    for (int i = 0; i < N; i++) {
+        const int r = rank + offsets[i][0];
+        const int f = file + offsets[i][1];
+        if (r >= 0 && r < 8 && f >= 0 && f < 8) attacks |= 1ULL << (r * 8 + f);
+    }
+    return attacks;
+}
+
+constexpr int KNIGHT_OFFSETS[8][2] = {
+    {-2, -1}, {-2, +1}, {-1, -2}, {-1, +2},
+    {+1, -2}, {+1, +2}, {+2, -1}, {+2, +1}
+};
+
+constexpr int KING_OFFSETS[8][2] = {
+    {-1, -1}, {-1,  0}, {-1, +1},
+    { 0, -1},           { 0, +1},
+    {+1, -1}, {+1,  0}, {+1, +1}
+};
+
+// Pawns capture diagonally forward: up the board for White, down for Black.
+constexpr int WHITE_PAWN_OFFSETS[2][2] = { {+1, -1}, {+1, +1} };
+constexpr int BLACK_PAWN_OFFSETS[2][2] = { {-1, -1}, {-1, +1} };
+
+template <int N>
+constexpr std::array<uint64_t, 64> make_leaper_table(const int (&offsets)[N][2]) {
+    std::array<uint64_t, 64> table{};
+    for (int sq = 0; sq < 64; sq++) table[sq] = leaper_attacks(sq, offsets);
+    return table;
+}
+
+} // namespace AttackGen
+
+// ============================================================================
+// ATTACK TABLES
 // ============================================================================
 
 /// Pre-computed knight attack patterns for each square (64 entries)
-extern uint64_t knight_attacks[64];
+inline constexpr std::array<uint64_t, 64> knight_attacks =
+    AttackGen::make_leaper_table(AttackGen::KNIGHT_OFFSETS);
 
 /// Pre-computed king attack patterns for each square (64 entries) 
-extern uint64_t king_attacks[64];
+inline constexpr std::array<uint64_t, 64> king_attacks =
+    AttackGen::make_leaper_table(AttackGen::KING_OFFSETS);
 
 /// Pre-computed pawn attack patterns [color][square] (2x64 entries)
 /// pawn_attacks[WHITE][square] = squares that a white pawn on 'square' attacks
 /// pawn_attacks[BLACK][square] = squares that a black pawn on 'square' attacks
-extern uint64_t pawn_attacks[2][64];
+inline constexpr std::array<std::array<uint64_t, 64>, 2> pawn_attacks = {
+    AttackGen::make_leaper_table(AttackGen::WHITE_PAWN_OFFSETS),
+    AttackGen::make_leaper_table(AttackGen::BLACK_PAWN_OFFSETS)
+};
 
 // ============================================================================
 // SLIDING PIECE ATTACK FUNCTIONS (Implemented in bitboard.hpp/cpp)
@@ -79,25 +132,6 @@ extern uint64_t pawn_attacks[2][64];
 //
 // These will be implemented with magic bitboards in Phase 3 of the migration.
 
-// ============================================================================
-// INITIALIZATION AND UTILITY FUNCTIONS
-// ============================================================================
-
-/**
- * @brief Initialize all attack tables (call once at engine startup)
- * 
- * This function pre-computes all attack patterns for non-sliding pieces.
- * It must be called before using any of the attack table arrays.
- * 
- * **Initialization order:**
- * 1. Knight attack patterns for all 64 squares
- * 2. King attack patterns for all 64 squares
- * 3. Pawn attack patterns for both colors and all 64 squares
- * 
- * **Performance**: Takes ~1ms to initialize, saves thousands of cycles per lookup
- */
-void init_attack_tables();
-
 // ============================================================================
 // INLINE CONVENIENCE FUNCTIONS
 // ============================================================================
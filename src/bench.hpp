@@ -0,0 +1,51 @@
+/**
+ * @file bench.hpp
+ * @brief Built-in fixed-depth benchmark (`bench`) — a deterministic node-count
+ *        signature plus NPS over a fixed, diverse position set.
+ *
+ * BACKLOG user-026: performance/regression tracking used to go through
+ * benchmark/benchmark.py driving a hard-coded Windows `huginn.exe` path and
+ * scraping UCI output. `bench` runs entirely in-process: every position is
+ * searched to a fixed depth by a freshly constructed Engine (no book, no
+ * tablebases, no time management), so the total node count is a stable
+ * signature of the search — any change to it means search behaviour changed.
+ */
+#pragma once
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace Huginn {
+
+/// Defaults for `bench [depth] [hash] [threads]`.
+constexpr int BENCH_DEFAULT_DEPTH   = 9;
+constexpr int BENCH_DEFAULT_HASH_MB = 16;
+constexpr int BENCH_DEFAULT_THREADS = 1;
+
+/// @brief Per-run bench result (summed over all positions).
+struct BenchResult {
+    uint64_t nodes = 0;         ///< Total nodes searched — the deterministic signature.
+    uint64_t elapsed_ms = 0;    ///< Wall-clock time for all searches.
+    int positions = 0;          ///< Number of positions searched.
+    uint64_t fail_highs = 0;    ///< Beta cutoffs in the main search (SearchInfo::fh).
+    uint64_t first_move_fail_highs = 0;  ///< ... of which by the first move searched (fhf).
+    uint64_t nps() const { return elapsed_ms ? nodes * 1000 / elapsed_ms : nodes * 1000; }
+    /// Move-ordering quality: fraction of cutoffs made by the first move (fhf/fh).
+    double first_move_cut_rate() const {
+        return fail_highs ? static_cast<double>(first_move_fail_highs) / fail_highs : 0.0;
+    }
+};
+
+/// @brief The built-in bench position set (FENs; ~50 openings, middlegames, endgames).
+const std::vector<std::string>& bench_positions();
+
+/// @brief Search every bench position to @p depth with a fresh @p hash_mb MB
+///        engine and print one progress line per position plus the summary
+///        (`Nodes searched`, `Nodes/second`, first-move cut rate) to @p out.
+///        The search's own `info` output is suppressed for the duration.
+/// @param threads Accepted for command-line compatibility; the engine is
+///        single-threaded, so values other than 1 are reported and ignored.
+BenchResult run_bench(int depth, int hash_mb, int threads, std::ostream& out);
+
+} // namespace Huginn
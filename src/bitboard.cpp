@@ -88,12 +88,13 @@ bool is_set(Bitboard bb, int square) {
 // BACKLOG #24: bishop_attacks/rook_attacks delegate to real magic bitboards
 // (src/magic_bitboards.{hpp,cpp}). The old ray-walker was removed in the #26
 // follow-up — magic init has its own ray walker for table population.
-/// @brief Bishop attack set from @p square given board @p occupancy (magic lookup).
-uint64_t bishop_attacks(int square, uint64_t occupancy) {
-    return Magic::magic_bishop_attacks(square, occupancy);
+// user-027: routed through the build-selected backend (magic or PEXT).
+/// @brief Bishop attack set from @p square given board @p occupancy (magic/PEXT lookup).
+PEXT_TARGET uint64_t bishop_attacks(int square, uint64_t occupancy) {
+    return Magic::slider_bishop_attacks(square, occupancy);
 }
 
-/// @brief Rook attack set from @p square given board @p occupancy (magic lookup).
-uint64_t rook_attacks(int square, uint64_t occupancy) {
-    return Magic::magic_rook_attacks(square, occupancy);
+/// @brief Rook attack set from @p square given board @p occupancy (magic/PEXT lookup).
+PEXT_TARGET uint64_t rook_attacks(int square, uint64_t occupancy) {
+    return Magic::slider_rook_attacks(square, occupancy);
 }
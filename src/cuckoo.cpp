@@ -0,0 +1,142 @@
+/**
+ * @file cuckoo.cpp
+ * @brief Cuckoo reversible-move table construction and the upcoming-repetition
+ *        probe (user-035).
+ *
+ * @see cuckoo.hpp for the idea and the table layout.
+ */
+
+#include "cuckoo.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "attack_tables.hpp"
+#include "bitboard.hpp"
+#include "position.hpp"
+#include "zobrist.hpp"
+
+namespace Cuckoo {
+
+namespace {
+
+struct Slot {
+    uint64_t key = 0;
+    uint8_t from = 0;
+    uint8_t to = 0;
+    uint64_t between = 0;
+};
+
+/// Empty-board reach of @p type from @p sq (pawns excluded: never reversible).
+uint64_t empty_board_moves(PieceType type, int sq) {
+    switch (type) {
+        case PieceType::Knight: return knight_attacks[sq];
+        case PieceType::Bishop: return bishop_attacks(sq, 0);
+        case PieceType::Rook:   return rook_attacks(sq, 0);
+        case PieceType::Queen:  return queen_attacks(sq, 0);
+        case PieceType::King:   return king_attacks[sq];
+        default:                return 0;
+    }
+}
+
+/// Squares strictly between two squares on a shared rank, file or diagonal.
+uint64_t squares_between(int s1, int s2) {
+    const uint64_t b1 = 1ULL << s1, b2 = 1ULL << s2;
+    if (rook_attacks(s1, 0) & b2) return rook_attacks(s1, b2) & rook_attacks(s2, b1);
+    if (bishop_attacks(s1, 0) & b2) return bishop_attacks(s1, b2) & bishop_attacks(s2, b1);
+    return 0;
+}
+
+} // namespace
+
+void init_cuckoo() {
+    if (Initialized) return;
+
+    std::vector<Slot> table(SIZE);
+    int count = 0;
+    for (int color = 0; color < 2; ++color) {
+        for (int t = int(PieceType::Knight); t <= int(PieceType::King); ++t) {
+            const PieceType type = static_cast<PieceType>(t);
+            const int row = t + (color ? 6 : 0);   // Zobrist row scheme (BACKLOG #50)
+            for (int s1 = 0; s1 < 64; ++s1) {
+                for (int s2 = s1 + 1; s2 < 64; ++s2) {
+                    if (!(empty_board_moves(type, s1) & (1ULL << s2))) continue;
+                    Slot slot;
+                    slot.key = Zobrist::Piece[row][s1] ^ Zobrist::Piece[row][s2] ^ Zobrist::Side;
+                    slot.from = static_cast<uint8_t>(s1);
+                    slot.to = static_cast<uint8_t>(s2);
+                    slot.between = (type == PieceType::Knight || type == PieceType::King)
+                                       ? 0 : squares_between(s1, s2);
+                    // Cuckoo insertion: take the slot, re-home whatever was there
+                    // to its other hash, until an empty slot absorbs the chain.
+                    int i = h1(slot.key);
+                    for (int kicks = 0;; ++kicks) {
+                        std::swap(table[i], slot);
+                        if (slot.key == 0) break;
+                        if (kicks > SIZE) {
+                            std::cerr << "Cuckoo: insertion cycle — table too small\n";
+                            std::abort();
+                        }
+                        i = (i == h1(slot.key)) ? h2(slot.key) : h1(slot.key);
+                    }
+                    ++count;
+                }
+            }
+        }
+    }
+    if (count != REVERSIBLE_MOVE_COUNT) {
+        std::cerr << "Cuckoo: " << count << " reversible moves, expected "
+                  << REVERSIBLE_MOVE_COUNT << '\n';
+        std::abort();
+    }
+
+    for (int i = 0; i < SIZE; ++i) {
+        Keys[i] = table[i].key;
+        From[i] = table[i].from;
+        To[i] = table[i].to;
+        Between[i] = table[i].between;
+    }
+    Initialized = true;
+}
+
+bool upcoming_repetition(const Position& pos) {
+    // Same window as repetition_count_in_history: the current path is
+    // move_history[0 .. pos.ply) (never .size(), BACKLOG #44), and nothing
+    // before the last irreversible move can recur.
+    const int end = std::min<int>(pos.halfmove_clock, pos.ply);
+    if (end < 3) return false;
+
+    const uint64_t key = pos.zobrist_key;
+    const uint64_t own = pos.color_bitboards[int(pos.side_to_move)];
+    const uint64_t occupied = pos.occupied_bitboard;
+
+    for (int i = 1; i <= end; ++i) {
+        const S_UNDO& undo = pos.move_history[pos.ply - i];
+        // A null move breaks the chain: positions behind it were never
+        // reachable by the moves actually played.
+        if (undo.move.move == 0) return false;
+        if (i < 3 || (i & 1) == 0) continue;   // only odd distances flip the side
+
+        const int slot = find(key ^ undo.zobrist_key);
+        if (slot < 0) continue;
+
+        const uint64_t ends = (1ULL << From[slot]) | (1ULL << To[slot]);
+        const uint64_t on_ends = occupied & ends;
+        if (Between[slot] & occupied) continue;          // path blocked
+        if (on_ends == 0 || on_ends == ends) continue;   // need one piece, one empty square
+        if (!(on_ends & own)) continue;                  // must be our piece to move
+
+        // The move reaches the position i plies back. It is a draw only if
+        // that completes a threefold: the target occurred once more in the
+        // window (same side to move, so an even distance further back).
+        for (int j = i + 2; j <= end; j += 2) {
+            if (pos.move_history[pos.ply - j].zobrist_key == undo.zobrist_key) return true;
+        }
+    }
+    return false;
+}
+
+} // namespace Cuckoo
@@ -0,0 +1,75 @@
+/**
+ * @file cuckoo.hpp
+ * @brief Cuckoo table of reversible-move Zobrist keys for O(1) upcoming-
+ *        repetition detection (user-035).
+ *
+ * repetition_count_in_history() (search.cpp) finds repetitions that have
+ * already happened. This table answers the forward question: can the side to
+ * move play ONE reversible move that lands on a position already on the path?
+ *
+ * For every piece that can move back and forth between two squares on an
+ * empty board (knight, bishop, rook, queen, king — pawns never move back), the
+ * Zobrist delta of that move is
+ *
+ *     Piece[pc][s1] ^ Piece[pc][s2] ^ Side
+ *
+ * There are 3668 such (piece, s1 < s2) pairs. They are stored in a two-hash
+ * cuckoo table of 8192 slots, so membership of a key is at most two loads.
+ * If `current_key ^ key_i_plies_back` is in the table, a single move of that
+ * piece between those squares converts one position into the other. Whether
+ * the move is actually playable (path clear, piece belongs to the side to
+ * move) and whether it completes a threefold is checked by
+ * upcoming_repetition().
+ *
+ * Built from the runtime Zobrist keys, so init_cuckoo() must run after
+ * Zobrist::init_zobrist() (Huginn::init() does both, in that order).
+ *
+ * @see Marcel van Kervinck, "The cuckoo hash for game cycle detection" (2013).
+ */
+#pragma once
+
+#include <cstdint>
+
+class Position;
+
+namespace Cuckoo {
+
+constexpr int SIZE = 8192;                 ///< Slots; two hash functions of 13 bits each.
+constexpr int REVERSIBLE_MOVE_COUNT = 3668;///< (piece, s1 < s2) pairs; init aborts on mismatch.
+
+inline uint64_t Keys[SIZE];    ///< Move key per slot (0 = empty).
+inline uint8_t From[SIZE];     ///< Lower square of the slot's move (sq64).
+inline uint8_t To[SIZE];       ///< Higher square of the slot's move (sq64).
+inline uint64_t Between[SIZE]; ///< Squares strictly between From and To (0 for leapers).
+inline bool Initialized = false;
+
+/// @brief First / second cuckoo hash of a move key.
+constexpr int h1(uint64_t key) { return static_cast<int>(key & (SIZE - 1)); }
+constexpr int h2(uint64_t key) { return static_cast<int>((key >> 16) & (SIZE - 1)); }
+
+/// @brief Slot holding @p move_key, or -1 if it is not a reversible-move key.
+inline int find(uint64_t move_key) {
+    int slot = h1(move_key);
+    if (Keys[slot] == move_key) return slot;
+    slot = h2(move_key);
+    if (Keys[slot] == move_key) return slot;
+    return -1;
+}
+
+/// @brief Fill the table from the Zobrist piece/side keys. Idempotent; aborts
+///        if the move count or the cuckoo insertion comes out wrong.
+void init_cuckoo();
+
+/**
+ * @brief True if the side to move has a reversible move that completes a
+ *        threefold repetition.
+ *
+ * The target must lie within the halfmove-clock window, must not be behind a
+ * null move, and must already have occurred twice. That is the same
+ * condition under which the child's own repetition check
+ * (repetition_count_in_history >= 3) would return the draw, so the answer
+ * matches what searching that move would find.
+ */
+bool upcoming_repetition(const Position& pos);
+
+} // namespace Cuckoo
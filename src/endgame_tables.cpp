@@ -0,0 +1,418 @@
+/**
+ * @file endgame_tables.cpp
+ * @brief Endgame table indexing, file format and probing (user-048). See endgame_tables.hpp.
+ */
+#include "endgame_tables.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "attack_tables.hpp"
+#include "bitboard.hpp"
+#include "movegen.hpp"
+
+namespace Huginn {
+namespace Egtb {
+
+namespace {
+
+constexpr char MAGIC[8] = {'H', 'G', 'N', 'E', 'G', 'T', 'B', '1'};
+constexpr std::size_t HEADER_BYTES = 16;
+constexpr std::size_t DIR_ENTRY_BYTES = 32;
+constexpr std::size_t NAME_BYTES = 16;
+constexpr std::size_t TABLE_ALIGN = 64;
+
+constexpr const char* EXTRA_ORDER = "QRBNP";  // strongest first
+
+int strength_rank(char c) {
+    const char* at = std::strchr(EXTRA_ORDER, c);
+    return (c != '\0' && at) ? int(at - EXTRA_ORDER) : -1;
+}
+
+PieceType letter_type(char c) {
+    switch (c) {
+        case 'Q': return PieceType::Queen;
+        case 'R': return PieceType::Rook;
+        case 'B': return PieceType::Bishop;
+        case 'N': return PieceType::Knight;
+        case 'P': return PieceType::Pawn;
+        default:  return PieceType::None;
+    }
+}
+
+std::string sorted_extras(std::string s) {
+    std::sort(s.begin(), s.end(), [](char a, char b) { return strength_rank(a) < strength_rank(b); });
+    return s;
+}
+
+// True if side @p a should be White: more pieces, or as many and stronger
+bool stronger_or_equal(const std::string& a, const std::string& b) {
+    if (a.size() != b.size()) return a.size() > b.size();
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i]) return strength_rank(a[i]) < strength_rank(b[i]);
+    }
+    return true;
+}
+
+// a1-d1-d4 triangle for the white king of pawnless tables
+struct Triangle {
+    std::array<int8_t, 64> index{};
+    std::array<int8_t, 10> square{};
+    constexpr Triangle() {
+        int n = 0;
+        for (int sq = 0; sq < 64; ++sq) {
+            const int file = sq & 7, rank = sq >> 3;
+            if (file <= 3 && rank <= file) {
+                index[sq] = int8_t(n);
+                square[n++] = int8_t(sq);
+            } else {
+                index[sq] = -1;
+            }
+        }
+    }
+};
+constexpr Triangle TRIANGLE;
+
+int transpose(int sq) { return ((sq & 7) << 3) | (sq >> 3); }
+
+void put_u32(std::ostream& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.put(char((v >> (8 * i)) & 0xFF));
+}
+void put_u64(std::ostream& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.put(char((v >> (8 * i)) & 0xFF));
+}
+uint64_t get_le(const unsigned char* p, int bytes) {
+    uint64_t v = 0;
+    for (int i = bytes - 1; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+} // namespace
+
+std::string canonical_name(const std::string& white_extras, const std::string& black_extras, bool* swapped) {
+    const std::string w = sorted_extras(white_extras);
+    const std::string b = sorted_extras(black_extras);
+    const bool swap = !stronger_or_equal(w, b);
+    if (swapped) *swapped = swap;
+    return swap ? "K" + b + "K" + w : "K" + w + "K" + b;
+}
+
+bool parse_layout(const std::string& name, TableLayout& layout) {
+    if (name.size() < 2 || name.size() > std::size_t(MAX_PIECES) || name[0] != 'K') return false;
+    const std::size_t second_king = name.find('K', 1);
+    if (second_king == std::string::npos) return false;
+    const std::string w = name.substr(1, second_king - 1);
+    const std::string b = name.substr(second_king + 1);
+    for (char c : w + b) {
+        if (strength_rank(c) < 0) return false;
+    }
+    if (sorted_extras(w) != w || sorted_extras(b) != b || !stronger_or_equal(w, b)) return false;
+
+    layout = TableLayout{};
+    layout.name = name;
+    layout.pieces[0] = Piece::WhiteKing;
+    layout.pieces[1] = Piece::BlackKing;
+    int n = 2;
+    for (char c : w) layout.pieces[n++] = make_piece(Color::White, letter_type(c));
+    for (char c : b) layout.pieces[n++] = make_piece(Color::Black, letter_type(c));
+    layout.count = n;
+    layout.pawns = name.find('P') != std::string::npos;
+    layout.identical_pair = (n == 4 && layout.pieces[2] == layout.pieces[3]);
+
+    uint32_t size = layout.pawns ? 32 : 10;
+    for (int i = 1; i < n; ++i) size *= 64;
+    layout.size = size * 2;
+    return true;
+}
+
+uint32_t encode(const TableLayout& layout, const int* squares, Color stm) {
+    int sq[MAX_PIECES];
+    const int n = layout.count;
+    std::copy(squares, squares + n, sq);
+
+    // Symmetry: bring the white king into its slot region
+    if ((sq[0] & 7) > 3) {
+        for (int i = 0; i < n; ++i) sq[i] ^= 7;
+    }
+    if (!layout.pawns) {
+        if ((sq[0] >> 3) > 3) {
+            for (int i = 0; i < n; ++i) sq[i] ^= 56;
+        }
+        if ((sq[0] >> 3) > (sq[0] & 7)) {
+            for (int i = 0; i < n; ++i) sq[i] = transpose(sq[i]);
+        }
+    }
+
+    const auto index_of = [&](int* s) {
+        if (layout.identical_pair && s[2] > s[3]) std::swap(s[2], s[3]);
+        uint32_t index = layout.pawns ? uint32_t((s[0] >> 3) * 4 + (s[0] & 7)) : uint32_t(TRIANGLE.index[s[0]]);
+        for (int i = 1; i < n; ++i) index = index * 64 + uint32_t(s[i]);
+        return index * 2 + (stm == Color::Black ? 1 : 0);
+    };
+    uint32_t index = index_of(sq);
+    if (!layout.pawns && (sq[0] >> 3) == (sq[0] & 7)) {
+        // King on the diagonal: the position and its transpose are the same
+        // entry, the lower index
+        int t[MAX_PIECES];
+        for (int i = 0; i < n; ++i) t[i] = transpose(sq[i]);
+        index = std::min(index, index_of(t));
+    }
+    return index;
+}
+
+void decode(const TableLayout& layout, uint32_t index, int* squares, Color& stm) {
+    stm = (index & 1) ? Color::Black : Color::White;
+    index >>= 1;
+    for (int i = layout.count - 1; i >= 1; --i) {
+        squares[i] = int(index & 63);
+        index >>= 6;
+    }
+    squares[0] = layout.pawns ? int((index / 4) * 8 + index % 4) : int(TRIANGLE.square[index]);
+}
+
+bool to_result(uint8_t value, EgtbResult& out) {
+    if (value == ILLEGAL) return false;
+    if (value == DRAW) {
+        out = EgtbResult{0, 0};
+        return true;
+    }
+    const int d = value - DTM_BASE;
+    out = EgtbResult{(d & 1) ? 1 : -1, d};
+    return true;
+}
+
+bool write_file(const std::string& path,
+                const std::vector<std::pair<std::string, const std::vector<uint8_t>*>>& tables) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    const auto align = [](uint64_t v) { return (v + TABLE_ALIGN - 1) / TABLE_ALIGN * TABLE_ALIGN; };
+    out.write(MAGIC, sizeof(MAGIC));
+    put_u32(out, uint32_t(tables.size()));
+    put_u32(out, 0);
+
+    uint64_t offset = align(HEADER_BYTES + DIR_ENTRY_BYTES * tables.size());
+    for (const auto& [name, data] : tables) {
+        char field[NAME_BYTES] = {};
+        std::memcpy(field, name.data(), std::min(name.size(), NAME_BYTES - 1));
+        out.write(field, NAME_BYTES);
+        put_u64(out, offset);
+        put_u64(out, data->size());
+        offset = align(offset + data->size());
+    }
+    for (const auto& [name, data] : tables) {
+        while (uint64_t(out.tellp()) % TABLE_ALIGN != 0) out.put('\0');
+        out.write(reinterpret_cast<const char*>(data->data()), std::streamsize(data->size()));
+    }
+    return bool(out);
+}
+
+} // namespace Egtb
+
+namespace {
+
+// Piece counts per (side, non-king type), two bits each: a ≤4-man position
+// has at most two of anything
+uint32_t material_key(const std::array<std::array<int, int(PieceType::_Count)>, 2>& counts) {
+    uint32_t key = 0;
+    for (int c = 0; c < 2; ++c) {
+        for (int t = int(PieceType::Pawn); t <= int(PieceType::Queen); ++t) {
+            key = (key << 2) | uint32_t(counts[c][t] & 3);
+        }
+    }
+    return key;
+}
+
+// Fold one child's result into the parent's best result so far; true if it improved
+bool fold_child(const EgtbResult& child, EgtbResult& best, bool& have) {
+    EgtbResult mine{-child.wdl, child.wdl == 0 ? 0 : child.dtm + 1};
+    const auto better = [](const EgtbResult& a, const EgtbResult& b) {
+        if (a.wdl != b.wdl) return a.wdl > b.wdl;
+        if (a.wdl > 0) return a.dtm < b.dtm;   // mate sooner
+        if (a.wdl < 0) return a.dtm > b.dtm;   // get mated later
+        return false;
+    };
+    if (have && !better(mine, best)) return false;
+    best = mine;
+    have = true;
+    return true;
+}
+
+bool has_legal_ep_capture(const Position& pos) {
+    if (pos.ep_square < 0) return false;
+    const int us = int(pos.side_to_move);
+    if (!(pawn_attacks[us ^ 1][pos.ep_square] & pos.piece_bitboards[us][int(PieceType::Pawn)])) return false;
+    Position copy = pos;
+    S_MOVELIST list;
+    generate_all_moves(copy, list);
+    for (int i = 0; i < list.count; ++i) {
+        if (list.moves[i].is_en_passant() && copy.MakeMove(list.moves[i])) {
+            copy.TakeMove();
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool EndgameTables::load(const std::string& path) {
+    clear();
+    if (!file_.open(path)) {
+        std::cerr << "Error: Could not open endgame table file: " << path << std::endl;
+        return false;
+    }
+    const unsigned char* base = file_.data();
+    const std::size_t bytes = file_.size();
+    if (bytes < Egtb::HEADER_BYTES || std::memcmp(base, Egtb::MAGIC, sizeof(Egtb::MAGIC)) != 0) {
+        std::cerr << "Error: Not an endgame table file: " << path << std::endl;
+        clear();
+        return false;
+    }
+    const uint32_t count = uint32_t(Egtb::get_le(base + 8, 4));
+    if (Egtb::HEADER_BYTES + std::size_t(count) * Egtb::DIR_ENTRY_BYTES > bytes) {
+        std::cerr << "Error: Truncated endgame table directory: " << path << std::endl;
+        clear();
+        return false;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        const unsigned char* entry = base + Egtb::HEADER_BYTES + std::size_t(i) * Egtb::DIR_ENTRY_BYTES;
+        const std::string name(reinterpret_cast<const char*>(entry),
+                               strnlen(reinterpret_cast<const char*>(entry), Egtb::NAME_BYTES));
+        const uint64_t offset = Egtb::get_le(entry + Egtb::NAME_BYTES, 8);
+        const uint64_t size = Egtb::get_le(entry + Egtb::NAME_BYTES + 8, 8);
+        if (offset > bytes || size > bytes - offset || !add_table(name, base + offset, std::size_t(size))) {
+            std::cerr << "Error: Bad endgame table entry '" << name << "' in " << path << std::endl;
+            clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void EndgameTables::clear() {
+    tables_.clear();
+    file_.close();
+    max_pieces_ = 0;
+}
+
+bool EndgameTables::add_table(const std::string& name, const uint8_t* data, std::size_t size) {
+    Table table;
+    if (!Egtb::parse_layout(name, table.layout) || size != table.layout.size) return false;
+    table.data = data;
+
+    std::array<std::array<int, int(PieceType::_Count)>, 2> counts{};
+    for (int i = 2; i < table.layout.count; ++i) {
+        const Piece p = table.layout.pieces[i];
+        ++counts[int(color_of(p))][int(type_of(p))];
+    }
+    max_pieces_ = std::max(max_pieces_, table.layout.count);
+    tables_[material_key(counts)] = std::move(table);
+    return true;
+}
+
+std::string EndgameTables::get_info() const {
+    std::ostringstream out;
+    std::size_t bytes = 0;
+    for (const auto& [key, table] : tables_) bytes += table.layout.size;
+    out << tables_.size() << " tables, up to " << max_pieces_ << " pieces, "
+        << (bytes + (1 << 19)) / (1 << 20) << " MB";
+    return out.str();
+}
+
+bool EndgameTables::probe_value(const Position& pos, uint8_t& value) const {
+    if (pos.castling_rights != 0) return false;
+    const int count = popcount(pos.occupied_bitboard);
+    if (count > std::max(max_pieces_, 2)) return false;
+
+    Piece pieces[Egtb::MAX_PIECES];
+    int squares[Egtb::MAX_PIECES];
+    Bitboard occ = pos.occupied_bitboard;
+    for (int i = 0; i < count; ++i) {
+        squares[i] = pop_lsb(occ);
+        pieces[i] = pos.at_sq64(squares[i]);
+    }
+    return probe_squares(pieces, squares, count, pos.side_to_move, value);
+}
+
+bool EndgameTables::probe_squares(const Piece* pieces, const int* squares, int count, Color stm,
+                                  uint8_t& value) const {
+    if (count == 2) {
+        value = Egtb::DRAW;
+        return true;
+    }
+    if (count > max_pieces_) return false;
+
+    std::array<std::array<int, int(PieceType::_Count)>, 2> counts{};
+    for (int i = 0; i < count; ++i) {
+        if (type_of(pieces[i]) != PieceType::King) ++counts[int(color_of(pieces[i]))][int(type_of(pieces[i]))];
+    }
+    bool swapped = false;
+    auto it = tables_.find(material_key(counts));
+    if (it == tables_.end()) {
+        std::swap(counts[0], counts[1]);
+        it = tables_.find(material_key(counts));
+        if (it == tables_.end()) return false;
+        swapped = true;
+    }
+
+    // Squares in layout order; colours swap (and the board flips) for the
+    // weaker side's tables
+    const Egtb::TableLayout& layout = it->second.layout;
+    int ordered[Egtb::MAX_PIECES];
+    unsigned used = 0;
+    for (int i = 0; i < layout.count; ++i) {
+        const Piece want = swapped ? make_piece(!color_of(layout.pieces[i]), type_of(layout.pieces[i]))
+                                   : layout.pieces[i];
+        int j = 0;
+        while (pieces[j] != want || (used & (1u << j))) ++j;
+        used |= 1u << j;
+        ordered[i] = swapped ? (squares[j] ^ 56) : squares[j];
+    }
+    value = it->second.data[Egtb::encode(layout, ordered, swapped ? !stm : stm)];
+    return true;
+}
+
+bool EndgameTables::probe(const Position& pos, EgtbResult& out) const {
+    if (has_legal_ep_capture(pos)) {
+        // The stored value assumes no en passant right; score the children instead
+        Position copy = pos;
+        return score_children(copy, out, nullptr);
+    }
+    uint8_t value;
+    return probe_value(pos, value) && Egtb::to_result(value, out);
+}
+
+S_MOVE EndgameTables::probe_root(Position& pos, EgtbResult& out) const {
+    uint8_t value;
+    S_MOVE best;
+    if (!probe_value(pos, value) || !score_children(pos, out, &best)) return S_MOVE();
+    return best;
+}
+
+bool EndgameTables::score_children(Position& pos, EgtbResult& out, S_MOVE* best_move) const {
+    S_MOVELIST list;
+    generate_all_moves(pos, list);
+    EgtbResult best;
+    bool have = false;
+    for (int i = 0; i < list.count; ++i) {
+        const S_MOVE move = list.moves[i];
+        if (!pos.MakeMove(move)) continue;
+        EgtbResult child;
+        const bool ok = probe(pos, child);
+        pos.TakeMove();
+        if (!ok) return false;
+        if (fold_child(child, best, have) && best_move) *best_move = move;
+    }
+    if (!have) {
+        // No legal move: mated or stalemated
+        best = in_check(pos) ? EgtbResult{-1, 0} : EgtbResult{0, 0};
+    }
+    out = best;
+    return true;
+}
+
+} // namespace Huginn
@@ -0,0 +1,166 @@
+/**
+ * @file endgame_tables.hpp
+ * @brief Huginn's own endgame tables: exact DTM for every ≤4-man ending (user-048).
+ *
+ * The tables are generated offline by `huginn_egtbgen` (tools/egtbgen), which
+ * runs retrograde analysis over the engine's attack tables, and are stored together
+ * in one file that EndgameTables memory-maps (see mapped_file.hpp). Playing
+ * small endings perfectly therefore needs no third-party tablebase files and
+ * no Fathom build.
+ *
+ * ## Values
+ * One byte per position, from the side to move's point of view:
+ * - `DRAW` (0): draw with best play.
+ * - `ILLEGAL` (1): an index that is not a legal, canonical position.
+ * - `DTM_BASE + d`: mate in `d` plies with best play. The parity carries the
+ *   result: an odd `d` means the side to move mates, and an even `d` means it
+ *   is mated (`d == 0`: checkmated now).
+ *
+ * DTM here ignores the fifty-move rule. The search only trusts a decisive
+ * value when it is reached within the remaining rule-50 budget (see
+ * Engine::probe_endgame_tables).
+ *
+ * ## Layout of one table
+ * A table covers one material signature with the stronger side as White,
+ * e.g. `KRKN`. A probe for the reversed colours flips the board vertically
+ * and swaps the side to move. Pieces are listed as: white king, black king,
+ * white extras (Q, R, B, N, P order), then black extras.
+ *
+ * `index = ((wk * 64 + sq1) * 64 + sq2 ...) * 2 + (black to move)`.
+ * - Pawnless tables: symmetry puts the white king in the a1–d1–d4 triangle
+ *   (10 slots); with the king on the diagonal, a position and its
+ *   transpose share the lower index.
+ * - Tables with pawns: only the left/right mirror applies (32 slots).
+ * - Two identical extras are stored with the lower square first.
+ *
+ * ## File
+ * - Header: magic `HGNEGTB1`, table count (u32), reserved (u32).
+ * - Directory: per table, its name (16 bytes, NUL-padded), offset (u64) and
+ *   size (u64).
+ * - Tables follow at 64-byte-aligned offsets.
+ * - All integers are little-endian.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "chess_types.hpp"
+#include "mapped_file.hpp"
+#include "move.hpp"
+#include "position.hpp"
+
+namespace Huginn {
+
+/// @brief A table hit, from the side to move's point of view.
+struct EgtbResult {
+    int wdl = 0;  ///< +1 win, 0 draw, -1 loss.
+    int dtm = 0;  ///< Plies to mate with best play (odd for a win, even for a loss); 0 for a draw.
+};
+
+namespace Egtb {
+
+constexpr int MAX_PIECES = 4;
+constexpr uint8_t DRAW = 0;
+constexpr uint8_t ILLEGAL = 1;
+constexpr uint8_t DTM_BASE = 2;
+constexpr int MAX_DTM = 255 - DTM_BASE;
+
+/// @brief Piece set and index geometry of one table.
+struct TableLayout {
+    std::string name;                       ///< Canonical name, e.g. "KRKN".
+    int count = 0;                          ///< Pieces including both kings (2..4).
+    std::array<Piece, MAX_PIECES> pieces{}; ///< Index order (see file comment).
+    bool pawns = false;                     ///< Left/right symmetry only.
+    bool identical_pair = false;            ///< pieces[2] == pieces[3].
+    uint32_t size = 0;                      ///< Entries (positions x side to move).
+};
+
+/// @brief Parse a canonical table name ("KQK", "KRKN", ...). False if malformed
+///        or not canonical (the stronger side must come first).
+bool parse_layout(const std::string& name, TableLayout& layout);
+
+/// @brief Canonical name for per-side extras, swapping sides if needed.
+///        @p swapped tells whether White became the second side.
+std::string canonical_name(const std::string& white_extras, const std::string& black_extras, bool* swapped = nullptr);
+
+/// @brief Table index of a position given in layout order. Applies the
+///        symmetry and identical-piece ordering, so any placement of the
+///        layout's pieces maps to its canonical entry.
+uint32_t encode(const TableLayout& layout, const int* squares, Color stm);
+
+/// @brief Inverse of encode() for canonical indices (squares in layout order).
+void decode(const TableLayout& layout, uint32_t index, int* squares, Color& stm);
+
+/// @brief Result of a stored value (false for ILLEGAL).
+bool to_result(uint8_t value, EgtbResult& out);
+
+/// @brief Write @p tables (name, bytes) into one table file.
+bool write_file(const std::string& path,
+                const std::vector<std::pair<std::string, const std::vector<uint8_t>*>>& tables);
+
+} // namespace Egtb
+
+/**
+ * @brief The loaded endgame tables, probed by the search.
+ *
+ * Tables either come from a mapped file (load()) or are registered from
+ * memory (add_table(), used by the generator while it builds larger tables).
+ */
+class EndgameTables {
+public:
+    /// @brief Map a table file, replacing anything loaded. Diagnostics go to stderr.
+    bool load(const std::string& path);
+    void clear();
+
+    /// @brief Register a table held by the caller; @p data must outlive this object.
+    bool add_table(const std::string& name, const uint8_t* data, std::size_t size);
+
+    bool is_loaded() const { return !tables_.empty(); }
+    int max_pieces() const { return max_pieces_; }
+    std::size_t table_count() const { return tables_.size(); }
+    std::string get_info() const;
+
+    /**
+     * @brief Raw stored value for @p pos, ignoring en passant.
+     * @return false if @p pos has castling rights, more pieces than any table,
+     *         or a material signature with no table. KK is always a draw.
+     */
+    bool probe_value(const Position& pos, uint8_t& value) const;
+
+    /// @brief probe_value() for a bare piece list (@p count pieces, both
+    ///        kings included) — the generator's lookup for its child positions.
+    bool probe_squares(const Piece* pieces, const int* squares, int count, Color stm, uint8_t& value) const;
+
+    /// @brief Exact result for @p pos, including a legal en passant capture.
+    bool probe(const Position& pos, EgtbResult& out) const;
+
+    /**
+     * @brief The DTM-best root move: the fastest mate, any drawing move, or
+     *        the slowest loss.
+     * @return Null move if @p pos (or any child) is not covered, or if it
+     *         has no legal move.
+     */
+    S_MOVE probe_root(Position& pos, EgtbResult& out) const;
+
+private:
+    /// One-ply search over the table values of every legal child of @p pos.
+    bool score_children(Position& pos, EgtbResult& out, S_MOVE* best_move) const;
+
+    struct Table {
+        Egtb::TableLayout layout;
+        const uint8_t* data = nullptr;
+    };
+
+    /// Key of a table: piece counts per (side, type), see material_key().
+    std::unordered_map<uint32_t, Table> tables_;
+    MappedFile file_;
+    int max_pieces_ = 0;
+};
+
+} // namespace Huginn
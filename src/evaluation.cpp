@@ -4,7 +4,7 @@
  * 
  * Implements position evaluation functions for the Huginn chess engine, including
  * material counting, piece-square tables, and advanced positional features.
- * The evaluation is based on the VICE tutorial approach with runtime-initialized
+ * The evaluation is based on the VICE tutorial approach with precomputed
  * evaluation masks for passed pawn detection and other positional patterns.
  * 
  * ## Evaluation Components
@@ -16,7 +16,7 @@
  * 
  * ## Performance Features
  * - Pre-computed evaluation masks for faster passed pawn detection
- * - Runtime initialization of position-dependent lookup tables
+ * - Masks generated at compile time and checked by static_assert (user-030)
  * - Optimized evaluation ordering for alpha-beta cutoffs
  * 
  * @author MTDuke71
@@ -29,72 +29,32 @@ namespace Huginn {
 
 namespace EvalParams {
 
-// VICE Part 78: Runtime-initialized evaluation masks (0:58, 1:30, 2:32)
-std::array<uint64_t, 64> WHITE_PASSED_PAWN_MASKS;
-std::array<uint64_t, 64> BLACK_PASSED_PAWN_MASKS;
+// VICE Part 78 passed-pawn masks are constexpr (evaluation.hpp, user-030);
+// these checks replace the old runtime init_evaluation_masks() loop.
+namespace {
 
-/**
- * @brief Initialize evaluation bitmasks for positional analysis
- * 
- * Sets up precomputed bitmasks for passed pawn detection and other positional
- * patterns. This function must be called once during engine initialization before
- * using the evaluation function. Based on VICE Part 78 tutorial approach.
- * 
- * Creates masks for:
- * - White passed pawn detection (squares in front and adjacent files)
- * - Black passed pawn detection (squares behind and adjacent files)
- * - Fast bitboard-based passed pawn evaluation
- */
-void init_evaluation_masks() {
-    // Initialize all masks to 0
-    WHITE_PASSED_PAWN_MASKS.fill(0);
-    BLACK_PASSED_PAWN_MASKS.fill(0);
-    
-    // Iterate through each square on the board (4:48)
+constexpr bool passed_masks_mirror() {
+    // A White pawn on (r, f) sees the Black mask of (7 - r, f) flipped vertically.
     for (int sq = 0; sq < 64; ++sq) {
-        int file = sq % 8;
-        int rank = sq / 8;
-        
-        // White passed pawn masks (0:58)
-        // For each white pawn, mark squares that must be clear for it to be passed
-        uint64_t white_mask = 0ULL;
-        
-        // Check all ranks in front of this pawn
-        for (int r = rank + 1; r <= 7; ++r) {
-            // Same file - pawn must advance
-            white_mask |= (1ULL << (r * 8 + file));
-            
-            // Adjacent files - enemy pawns that could capture
-            if (file > 0) {
-                white_mask |= (1ULL << (r * 8 + (file - 1)));
-            }
-            if (file < 7) {
-                white_mask |= (1ULL << (r * 8 + (file + 1)));
-            }
-        }
-        WHITE_PASSED_PAWN_MASKS[sq] = white_mask;
-        
-        // Black passed pawn masks (2:32)
-        // For each black pawn, mark squares that must be clear for it to be passed
-        uint64_t black_mask = 0ULL;
-        
-        // Check all ranks behind this pawn (from black's perspective)
-        for (int r = rank - 1; r >= 0; --r) {
-            // Same file - pawn must advance
-            black_mask |= (1ULL << (r * 8 + file));
-            
-            // Adjacent files - enemy pawns that could capture  
-            if (file > 0) {
-                black_mask |= (1ULL << (r * 8 + (file - 1)));
-            }
-            if (file < 7) {
-                black_mask |= (1ULL << (r * 8 + (file + 1)));
-            }
-        }
-        BLACK_PASSED_PAWN_MASKS[sq] = black_mask;
+        const int mirrored = (7 - sq / 8) * 8 + sq % 8;
+        uint64_t flipped = 0ULL;
+        for (int b = 0; b < 64; ++b)
+            if ((BLACK_PASSED_PAWN_MASKS[mirrored] >> b) & 1ULL)
+                flipped |= 1ULL << ((7 - b / 8) * 8 + b % 8);
+        if (flipped != WHITE_PASSED_PAWN_MASKS[sq]) return false;
     }
+    return true;
 }
 
+static_assert(WHITE_PASSED_PAWN_MASKS[12] == 0x3838383838380000ULL, "white e2: d-f files, ranks 3-8");
+static_assert(WHITE_PASSED_PAWN_MASKS[8]  == 0x0303030303030000ULL, "white a2: a-b files, ranks 3-8");
+static_assert(BLACK_PASSED_PAWN_MASKS[52] == 0x0000383838383838ULL, "black e7: d-f files, ranks 6-1");
+static_assert(WHITE_PASSED_PAWN_MASKS[60] == 0 && BLACK_PASSED_PAWN_MASKS[4] == 0,
+              "nothing ahead of the last rank");
+static_assert(passed_masks_mirror(), "white/black passed-pawn masks must mirror each other");
+
+} // namespace
+
 } // namespace EvalParams
 
 } // namespace Huginn
@@ -439,21 +439,27 @@ inline constexpr std::array<uint64_t, 8> ISOLATED_PAWN_MASKS = {
     0x4040404040404040ULL  // H-file: only G-file adjacent
 };
 
+/// @brief Build the per-square passed-pawn masks for one side (VICE Part 78):
+///        own + adjacent files, every rank ahead of the pawn in @p rank_step
+///        direction (+1 White, -1 Black). Evaluated at compile time (user-030).
+constexpr std::array<uint64_t, 64> make_passed_pawn_masks(int rank_step) {
+    std::array<uint64_t, 64> masks{};
+    for (int sq = 0; sq < 64; ++sq) {
+        const int file = sq % 8;
+        for (int r = sq / 8 + rank_step; r >= 0 && r <= 7; r += rank_step) {
+            for (int f = file - 1; f <= file + 1; ++f)
+                if (f >= 0 && f <= 7) masks[sq] |= 1ULL << (r * 8 + f);
+        }
+    }
+    return masks;
+}
+
 /// @brief Per-square mask of the squares that must be empty of enemy pawns for
 ///        a White pawn on that square to be passed (own + adjacent files, ahead).
-///        Built at startup by init_evaluation_masks().
-extern std::array<uint64_t, 64> WHITE_PASSED_PAWN_MASKS;
+inline constexpr std::array<uint64_t, 64> WHITE_PASSED_PAWN_MASKS = make_passed_pawn_masks(+1);
 
 /// @brief Black counterpart of WHITE_PASSED_PAWN_MASKS (squares ahead toward rank 1).
-extern std::array<uint64_t, 64> BLACK_PASSED_PAWN_MASKS;
-
-/**
- * @brief Populate the runtime passed-pawn masks (VICE Part 78).
- *
- * Fills WHITE_/BLACK_PASSED_PAWN_MASKS. Call once at startup before any
- * evaluation; the constexpr file/rank/isolated masks need no initialization.
- */
-void init_evaluation_masks();
+inline constexpr std::array<uint64_t, 64> BLACK_PASSED_PAWN_MASKS = make_passed_pawn_masks(-1);
 
 } // namespace EvalParams
 
@@ -9,8 +9,11 @@
  * 
  * ## Initialization Order
  * 1. **Zobrist Tables**: Position hashing for transposition table
- * 2. **Evaluation Masks**: Precomputed patterns for position evaluation
- * 3. **Global State**: Engine-wide flags and configuration
+ * 2. **Slider Tables**: Magic-bitboard attack tables
+ * 3. **Cuckoo Table**: Reversible-move keys for upcoming-repetition detection
+ * 4. **Global State**: Engine-wide flags and configuration
+ *
+ * Evaluation masks and leaper attack tables are generated at compile time.
  * 
  * ## Thread Safety
  * The initialization functions are not thread-safe and should only be called
@@ -21,10 +24,9 @@
  * @see init.hpp for function declarations
  */
 #include "init.hpp"
-#include "attack_tables.hpp"
 #include "zobrist.hpp"
-#include "evaluation.hpp"
 #include "magic_bitboards.hpp"
+#include "cuckoo.hpp"
 
 namespace Huginn {
     
@@ -44,18 +46,17 @@ namespace Huginn {
         // Initialize Zobrist hashing tables
         Zobrist::init_zobrist();
         
-        // Initialize evaluation masks
-        EvalParams::init_evaluation_masks();
+        // Evaluation masks and knight / king / pawn attack tables are
+        // constexpr (user-030) — nothing to do for them here.
 
-        // Initialize attack tables (knight / king / pawn lookup arrays
-        // and sliding-piece scaffolding) for bitboard move generation.
-        init_attack_tables();
-
-        // Initialize real magic-bitboard slider attack tables (BACKLOG #24).
-        // Finds magics via deterministic PRNG seed + verifies every
-        // (square, occupancy) against the ray-walker before returning.
+        // Fill the magic-bitboard slider attack tables (BACKLOG #24) from the
+        // shipped magics (user-029); aborts if a magic collides.
         Magic::init_magic_bitboards();
 
+        // Reversible-move cuckoo table (user-035): built from the Zobrist
+        // keys and the slider tables above, so it comes last.
+        Cuckoo::init_cuckoo();
+
         initialized = true;
     }
 
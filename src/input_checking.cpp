@@ -165,11 +165,10 @@ bool input_is_waiting() {
  */
 
 void read_input(SearchInfo& info) {
-    // #56: this is now the FALLBACK path only — when the UCI layer drives the
-    // search it installs SearchInfo::on_input (UCIInterface::pump_search_input),
-    // which consumes and classifies mid-search lines properly (`isready`
-    // answered without stopping, `stop`/`quit` applied, the rest queued).
-    // Bare-Engine callers (tests, bench) keep the conservative behaviour below.
+    // #56: standalone utility only — the UCI command loop classifies
+    // mid-search lines itself (`isready` answered without stopping,
+    // `stop`/`quit` applied, the rest queued; user-040 runs it on its own
+    // thread). This keeps the conservative behaviour below.
     //
     // CRITICAL: do NOT consume the input line here.
     //
@@ -200,4 +199,91 @@ void read_input(SearchInfo& info) {
     }
 }
 
+// --- StdinReader (user-039) -------------------------------------------------
+
+StdinReader::~StdinReader() {
+    // Never detach: the thread uses this object and the stream. The
+    // process-wide instance is never destroyed (see stdin_reader).
+    if (thread_.joinable()) thread_.join();
+}
+
+void StdinReader::start(std::istream& in, std::atomic<bool>* stop_flag) {
+    bind_stop_flag(stop_flag);
+    if (started_) return;
+    started_ = true;
+    thread_ = std::thread([this, &in] { run(in); });
+}
+
+void StdinReader::bind_stop_flag(std::atomic<bool>* stop_flag) {
+    std::lock_guard<std::mutex> lock(flag_mutex_);
+    stop_flag_ = stop_flag;
+}
+
+void StdinReader::raise_stop_flag() {
+    std::lock_guard<std::mutex> lock(flag_mutex_);
+    if (stop_flag_) stop_flag_->store(true, std::memory_order_relaxed);
+}
+
+void StdinReader::run(std::istream& in) {
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();  // CRLF from Windows GUIs
+        // Raise the stop before queueing: the search sees it at its next
+        // checkup even if the UCI loop has not popped the line yet.
+        const size_t first = line.find_first_not_of(" \t");
+        const size_t last = line.find_first_of(" \t", first);
+        if (first != std::string::npos) {
+            const std::string command = line.substr(first, last == std::string::npos ? std::string::npos : last - first);
+            if (command == "stop" || command == "quit") raise_stop_flag();
+        }
+        push(line);
+    }
+    // EOF: the GUI is gone. Same contract as the old poll: treat it as quit.
+    raise_stop_flag();
+    push("quit");
+}
+
+void StdinReader::push(std::string line) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    // Full ring: the consumer is mid-search and not draining. Wait rather than
+    // drop; GUIs never have 256 commands in flight in practice.
+    while (tail - head_.load(std::memory_order_acquire) >= CAPACITY) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    slots_[tail & MASK] = std::move(line);
+    tail_.store(tail + 1, std::memory_order_release);
+    // Take the lock so a consumer between its empty check and wait() cannot
+    // miss the notify.
+    { std::lock_guard<std::mutex> lock(wait_mutex_); }
+    wait_cv_.notify_one();
+}
+
+bool StdinReader::try_pop(std::string& line) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) return false;
+    line = std::move(slots_[head & MASK]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void StdinReader::wait_pop(std::string& line) {
+    while (!try_pop(line)) {
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        wait_cv_.wait(lock, [this] {
+            return head_.load(std::memory_order_relaxed) != tail_.load(std::memory_order_acquire);
+        });
+    }
+}
+
+bool StdinReader::wait_pop_for(std::string& line, std::chrono::milliseconds timeout) {
+    if (try_pop(line)) return true;
+    {
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        wait_cv_.wait_for(lock, timeout, [this] {
+            return head_.load(std::memory_order_relaxed) != tail_.load(std::memory_order_acquire);
+        });
+    }
+    return try_pop(line);
+}
+
 } // namespace Huginn
@@ -16,10 +16,101 @@
 
 #include "search.hpp"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <istream>
+#include <mutex>
+#include <string>
+#include <thread>
+
 namespace Huginn {
 
+/**
+ * @brief Dedicated stdin reader thread feeding a lock-free line queue (user-039).
+ *
+ * The search used to poll stdin itself: checkup() called input_is_waiting()
+ * (a select() syscall, PeekNamedPipe on Windows) every 32768 nodes, so stop
+ * latency scaled with node rate and the poll cost showed up in profiles. Now
+ * one thread blocks in std::getline and does nothing else:
+ *
+ * - Every line goes into a single-producer / single-consumer ring. The
+ *   consumer is the thread running the UCI loop (the search runs on its own
+ *   worker since user-040), so head/tail atomics are all the
+ *   synchronisation the queue needs.
+ * - A `stop` or `quit` line also raises the engine's should_stop atomic
+ *   right away. The line stays queued, so the UCI loop still sees it in order.
+ * - EOF (the GUI closed the pipe) is queued as `quit`, same contract as before.
+ *
+ * has_pending() is one relaxed load each of head and tail. The idle UCI loop blocks in wait_pop() on a
+ * condition variable instead of spinning. The process-wide instance is
+ * ::stdin_reader. Tests run private instances over a std::istream.
+ */
+class StdinReader {
+public:
+    static constexpr std::size_t CAPACITY = 256;  ///< Lines in flight; a power of two.
+
+    StdinReader() = default;
+    StdinReader(const StdinReader&) = delete;
+    StdinReader& operator=(const StdinReader&) = delete;
+    /// @brief Joins the reader thread, so @p in must have reached EOF (or be
+    ///        closed) first: the thread uses this object and the stream.
+    ~StdinReader();
+
+    /// @brief Start the reader thread on @p in (once; later calls only
+    ///        re-bind @p stop_flag). @p stop_flag, if set, is raised when a
+    ///        `stop`/`quit` line (or EOF) arrives.
+    void start(std::istream& in, std::atomic<bool>* stop_flag = nullptr);
+    /// @brief Raise @p stop_flag (nullptr: none) from now on. Once this
+    ///        returns the reader no longer touches the previous flag.
+    void bind_stop_flag(std::atomic<bool>* stop_flag);
+    /// @brief True once start() has run.
+    bool started() const noexcept { return started_; }
+
+    /// @brief A line is waiting. Relaxed: a stale `false` just means the line
+    ///        is seen at the next check.
+    bool has_pending() const noexcept {
+        return head_.load(std::memory_order_relaxed) != tail_.load(std::memory_order_relaxed);
+    }
+    /// @brief Pop the next line if there is one (consumer side, never blocks).
+    bool try_pop(std::string& line);
+    /// @brief Pop the next line, blocking until one arrives.
+    void wait_pop(std::string& line);
+    /// @brief Pop the next line, blocking at most @p timeout. @return false on timeout.
+    bool wait_pop_for(std::string& line, std::chrono::milliseconds timeout);
+
+private:
+    void push(std::string line);  // producer side (reader thread only)
+    void run(std::istream& in);
+
+    static constexpr std::size_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & MASK) == 0, "CAPACITY must be a power of two");
+
+    std::array<std::string, CAPACITY> slots_;
+    std::atomic<std::size_t> head_{0};  ///< Next slot to pop (written by the consumer).
+    std::atomic<std::size_t> tail_{0};  ///< Next slot to fill (written by the producer).
+    void raise_stop_flag();
+
+    std::atomic<bool>* stop_flag_ = nullptr;  ///< Guarded by flag_mutex_.
+    std::mutex flag_mutex_;              ///< Taken only on stop/quit/EOF and re-binds.
+    std::mutex wait_mutex_;              ///< Only for the idle consumer's sleep.
+    std::condition_variable wait_cv_;
+    std::thread thread_;
+    bool started_ = false;
+};
+
+/// The process-wide reader over std::cin, started by UCIInterface::run().
+/// Deliberately leaked: its thread is usually still blocked in getline at
+/// exit, which cannot be interrupted portably, so it must never be joined.
+inline StdinReader& stdin_reader = *new StdinReader;
+
 /**
  * @brief Check for available input without blocking execution
+ *
+ * user-039: no longer called from the search — the StdinReader thread owns
+ * stdin. Kept as a standalone utility.
  * 
  * Non-blocking function that detects pending input on standard input stream.
  * Enables responsive engine operation during search by allowing periodic
@@ -37,6 +128,9 @@ bool input_is_waiting();
 
 /**
  * @brief Read and process input commands for engine control
+ *
+ * user-039: no longer called from checkup(); a bare Engine search (tests,
+ * bench) does not look at stdin at all.
  * 
  * Reads available input and processes UCI commands ("quit", "stop") to control
  * engine operation. Works with `input_is_waiting()` for responsive command
@@ -1,10 +1,12 @@
 /**
  * @file magic_bitboards.cpp
- * @brief Init-time magic finder + attack table generation.
+ * @brief Attack table generation from the shipped magics, plus the magic
+ *        finder used by the magic_gen tool (user-029).
  * @see magic_bitboards.hpp for the public interface and design notes.
  */
 #include "magic_bitboards.hpp"
 #include "bit_utils.hpp"  // cross-platform __builtin_popcountll / __builtin_ctzll
+#include "magic_numbers.hpp"
 
 #include <array>
 #include <cstdint>
@@ -13,15 +15,22 @@
 #include <iostream>
 #include <vector>
 
+#if ENABLE_PEXT_ATTACKS && defined(_MSC_VER)
+#include <intrin.h>  // __cpuidex
+#endif
+
 namespace Magic {
 
 // ---- Storage (filled by init_magic_bitboards) ----------------------
-uint64_t ROOK_MASKS[64];     ///< Per-square rook relevant-occupancy mask.
-uint64_t BISHOP_MASKS[64];   ///< Per-square bishop relevant-occupancy mask.
-uint64_t ROOK_MAGICS[64];    ///< Per-square rook magic multiplier.
-uint64_t BISHOP_MAGICS[64];  ///< Per-square bishop magic multiplier.
-uint64_t ROOK_ATTACK_TABLE[64][ROOK_TABLE_SIZE_PER_SQ];     ///< Rook attacks indexed by magic hash.
-uint64_t BISHOP_ATTACK_TABLE[64][BISHOP_TABLE_SIZE_PER_SQ]; ///< Bishop attacks indexed by magic hash.
+SquareMagic ROOK_MAGICS[64];                     ///< Per-square rook mask/magic/offset/shift.
+SquareMagic BISHOP_MAGICS[64];                   ///< Per-square bishop mask/magic/offset/shift.
+uint64_t ROOK_ATTACK_TABLE[ROOK_TABLE_SIZE];     ///< Packed rook slices, indexed offset + magic hash.
+uint64_t BISHOP_ATTACK_TABLE[BISHOP_TABLE_SIZE]; ///< Packed bishop slices, indexed offset + magic hash.
+
+#if ENABLE_PEXT_ATTACKS
+uint64_t ROOK_PEXT_TABLE[ROOK_TABLE_SIZE];       ///< Rook attacks indexed by offset + pext(occ, mask).
+uint64_t BISHOP_PEXT_TABLE[BISHOP_TABLE_SIZE];   ///< Bishop attacks indexed by offset + pext(occ, mask).
+#endif
 
 namespace {
 
@@ -135,11 +144,12 @@ struct XorShift64 {
         state ^= state << 17;
         return state;
     }
-    // AND of 2 (popcount ~16) is the sweet spot for fixed-shift magic
-    // bitboards: sparser candidates (AND of 3, popcount ~8) fail to
-    // disperse the 4096 subsets in worst-case corner squares; denser
-    // candidates lose the hit-rate benefit.
-    uint64_t sparse() { return next() & next(); }
+    // AND of 3 (popcount ~8): with per-square shifts every slice is
+    // exactly 2^bits, so there is no slack for collisions and the
+    // sparser candidates the CPW recipe uses converge fastest. (The old
+    // fixed-shift layout wanted AND of 2 — its oversized corner tables
+    // needed denser multipliers to disperse.)
+    uint64_t sparse() { return next() & next() & next(); }
 };
 
 // Hardcoded seed — the only "magic constant" in this file. Any
@@ -160,19 +170,19 @@ constexpr uint64_t MAGIC_SEED = 0x12345678ABCDEFULL;
 // colliding subsets produce the same attack set (those are redundant
 // occupancy patterns from the slider's POV).
 //
-// Writes the discovered magic to *out_magic and fills the per-square
-// attack table at *attack_table.
+// Writes the discovered magic to *out_magic. user-029: this only runs
+// from the magic_gen tool now (`--regen-magics`); the engine starts from
+// the shipped constants in magic_numbers.hpp.
 
 /// @brief Search the PRNG stream for a magic multiplier that perfectly hashes
 ///        every blocker subset of @p mask into `[0, table_size)` via
 ///        `(subset*magic) >> shift` (collisions allowed only when the attack
-///        set matches). Writes the magic to @p out_magic and fills @p attack_table.
+///        set matches). Writes the magic to @p out_magic.
 /// @return true if a magic was found.
 template <typename StepArr>
 bool find_magic_for_square(int sq,
                            uint64_t mask,
                            int shift,
-                           uint64_t* attack_table,
                            int table_size,
                            const StepArr& steps,
                            XorShift64& rng,
@@ -190,34 +200,34 @@ bool find_magic_for_square(int sq,
     }
 
     // Try sparse candidates until one produces a collision-free map.
-    // 1M attempts is far more than the typical convergence (hundreds
-    // to low thousands of tries) — gives us headroom if a particular
-    // PRNG stream wanders through an unproductive region.
-    constexpr int MAX_ATTEMPTS = 1'000'000;
+    // With per-square shifts the slowest square (a rook corner/edge with
+    // 11-12 mask bits and zero slack) needs ~2M raw candidates from this
+    // seed, most rejected by the one-multiply pre-filter; 10M leaves
+    // headroom if a PRNG stream wanders through an unproductive region.
+    constexpr int MAX_ATTEMPTS = 10'000'000;
     std::vector<uint64_t> used(table_size, 0);
-    std::vector<bool> filled(table_size, false);
+    // Per-slot attempt stamp: a slot is "filled" only if stamped by the
+    // current attempt, so no per-attempt clear of the whole slice.
+    std::vector<int> stamp(table_size, -1);
 
     for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
         const uint64_t candidate = rng.sparse();
 
         // Cheap pre-filter: skip candidates whose top byte of
-        // (mask * candidate) has fewer than 4 set bits — those tend
+        // (mask * candidate) has fewer than 6 set bits — those tend
         // not to disperse subsets into the high-bit range we extract.
-        // Threshold relaxed from 6 to 4 after observing fixed-shift
-        // corner squares (12-bit masks) miss valid magics at 6.
-        if (__builtin_popcountll((mask * candidate) & 0xFF00000000000000ULL) < 4) {
+        // (The fixed-shift layout had to relax this to 4; variable
+        // shifts with AND-of-3 candidates are fine at the CPW value.)
+        if (__builtin_popcountll((mask * candidate) & 0xFF00000000000000ULL) < 6) {
             continue;
         }
 
-        // Reset bookkeeping for this attempt.
-        std::fill(filled.begin(), filled.end(), false);
-
         bool ok = true;
         for (int i = 0; i < n_subsets && ok; ++i) {
             const uint64_t idx = (subsets[i] * candidate) >> shift;
-            if (!filled[idx]) {
+            if (stamp[idx] != attempt) {
                 used[idx] = attacks[i];
-                filled[idx] = true;
+                stamp[idx] = attempt;
             } else if (used[idx] != attacks[i]) {
                 ok = false;  // real collision (different attack sets)
             }
@@ -226,10 +236,6 @@ bool find_magic_for_square(int sq,
         }
 
         if (ok) {
-            // Commit: copy filled slots into the public table.
-            for (int i = 0; i < table_size; ++i) {
-                attack_table[i] = filled[i] ? used[i] : 0;
-            }
             *out_magic = candidate;
             return true;
         }
@@ -237,47 +243,147 @@ bool find_magic_for_square(int sq,
     return false;
 }
 
+#if ENABLE_PEXT_ATTACKS
+// ---- PEXT tables (user-027) ----------------------------------------
+//
+// nth_subset_of_mask(mask, n) is exactly the inverse of pext(., mask):
+// pext(nth_subset_of_mask(mask, n), mask) == n. So slot n of a square's
+// slice holds the attacks for its n-th blocker subset — no hashing, no
+// collisions, nothing to search for.
+
+/// @brief Fill one piece type's PEXT table, reusing the fancy-magic slice
+///        offsets (both layouts give square sq exactly 2^popcount(mask) slots).
+///        Slot n copies the magic lookup for the n-th subset (the magic fill
+///        has already checked it), and the CPU's pext must map that subset
+///        back to n or init aborts — so every PEXT lookup is checked in every
+///        build, for less than a ray-walked fill would cost.
+PEXT_TARGET void fill_pext_table(const SquareMagic (&magics)[64], uint64_t* table,
+                                 uint64_t (*magic_lookup)(int, uint64_t), const char* what) {
+    for (int sq = 0; sq < 64; ++sq) {
+        const uint64_t mask = magics[sq].mask;
+        const uint64_t n_subsets = 1ULL << __builtin_popcountll(mask);
+        for (uint64_t n = 0; n < n_subsets; ++n) {
+            const uint64_t occ = nth_subset_of_mask(mask, n);
+            if (_pext_u64(occ, mask) != n) {
+                std::fprintf(stderr, "FATAL: %s pext mismatch sq=%d occ=0x%llx\n",
+                             what, sq, (unsigned long long)occ);
+                std::abort();
+            }
+            table[magics[sq].offset + n] = magic_lookup(sq, occ);
+        }
+    }
+}
+
+/// @brief True if the running CPU implements BMI2 (PEXT). A PEXT build on a
+///        pre-Haswell / pre-Zen CPU would otherwise die of SIGILL mid-search.
+bool cpu_has_bmi2() {
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 8)) != 0;   // CPUID.(EAX=7,ECX=0):EBX bit 8
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2");
+#endif
+}
+#endif
+
 // ---- Verifier ------------------------------------------------------
 //
 // After init, walk every (square, every subset of its mask) and
 // confirm magic_*_attacks() agrees with the ray-walker. Bug catcher:
 // if a magic is silently wrong for some occupancy, the engine would
 // generate illegal moves or miss legal ones in obscure positions.
+// user-027: with ENABLE_PEXT_ATTACKS the PEXT lookups are checked against
+// the same ground truth in the same pass.
+
+/// @brief Abort with a diagnostic if a table lookup disagrees with the ray walker.
+void check_or_die(const char* what, int sq, uint64_t occ, uint64_t got, uint64_t ref) {
+    if (got == ref) return;
+    std::fprintf(stderr,
+        "FATAL: %s mismatch sq=%d occ=0x%llx "
+        "got=0x%llx ref=0x%llx\n",
+        what, sq, (unsigned long long)occ,
+        (unsigned long long)got,
+        (unsigned long long)ref);
+    std::abort();
+}
 
 void verify_or_die() {
     for (int sq = 0; sq < 64; ++sq) {
-        const uint64_t rmask = ROOK_MASKS[sq];
+        const uint64_t rmask = ROOK_MAGICS[sq].mask;
         const int rbits = __builtin_popcountll(rmask);
         for (uint64_t s = 0; s < (1ULL << rbits); ++s) {
             const uint64_t occ = nth_subset_of_mask(rmask, s);
-            const uint64_t magic_result = magic_rook_attacks(sq, occ);
-            const uint64_t ref_result   = ray_attacks(sq, occ, ROOK_STEPS);
-            if (magic_result != ref_result) {
-                std::fprintf(stderr,
-                    "FATAL: rook magic mismatch sq=%d occ=0x%llx "
-                    "magic=0x%llx ref=0x%llx\n",
-                    sq, (unsigned long long)occ,
-                    (unsigned long long)magic_result,
-                    (unsigned long long)ref_result);
-                std::abort();
-            }
+            const uint64_t ref_result = ray_attacks(sq, occ, ROOK_STEPS);
+            check_or_die("rook magic", sq, occ, magic_rook_attacks(sq, occ), ref_result);
+#if ENABLE_PEXT_ATTACKS
+            check_or_die("rook pext", sq, occ, pext_rook_attacks(sq, occ), ref_result);
+#endif
         }
 
-        const uint64_t bmask = BISHOP_MASKS[sq];
+        const uint64_t bmask = BISHOP_MAGICS[sq].mask;
         const int bbits = __builtin_popcountll(bmask);
         for (uint64_t s = 0; s < (1ULL << bbits); ++s) {
             const uint64_t occ = nth_subset_of_mask(bmask, s);
-            const uint64_t magic_result = magic_bishop_attacks(sq, occ);
-            const uint64_t ref_result   = ray_attacks(sq, occ, BISHOP_STEPS);
-            if (magic_result != ref_result) {
-                std::fprintf(stderr,
-                    "FATAL: bishop magic mismatch sq=%d occ=0x%llx "
-                    "magic=0x%llx ref=0x%llx\n",
-                    sq, (unsigned long long)occ,
-                    (unsigned long long)magic_result,
-                    (unsigned long long)ref_result);
+            const uint64_t ref_result = ray_attacks(sq, occ, BISHOP_STEPS);
+            check_or_die("bishop magic", sq, occ, magic_bishop_attacks(sq, occ), ref_result);
+#if ENABLE_PEXT_ATTACKS
+            check_or_die("bishop pext", sq, occ, pext_bishop_attacks(sq, occ), ref_result);
+#endif
+        }
+    }
+}
+
+// ---- Layout + table fill (user-029) --------------------------------
+
+/// @brief Masks, shifts and packed slice offsets for both piece types
+///        (everything in SquareMagic except the magic itself).
+void compute_layout() {
+    uint32_t rook_offset = 0, bishop_offset = 0;
+    for (int sq = 0; sq < 64; ++sq) {
+        SquareMagic& r = ROOK_MAGICS[sq];
+        r.mask   = compute_rook_mask(sq);
+        r.shift  = 64 - __builtin_popcountll(r.mask);
+        r.offset = rook_offset;
+        rook_offset += 1u << (64 - r.shift);
+
+        SquareMagic& b = BISHOP_MAGICS[sq];
+        b.mask   = compute_bishop_mask(sq);
+        b.shift  = 64 - __builtin_popcountll(b.mask);
+        b.offset = bishop_offset;
+        bishop_offset += 1u << (64 - b.shift);
+    }
+    if (rook_offset != ROOK_TABLE_SIZE || bishop_offset != BISHOP_TABLE_SIZE) {
+        std::fprintf(stderr, "FATAL: magic table size mismatch (rook %u, bishop %u)\n",
+                     rook_offset, bishop_offset);
+        std::abort();
+    }
+}
+
+/// @brief Install the shipped @p numbers and fill one piece type's attack
+///        table from them. Every blocker subset writes its ray-walked attack
+///        set to its hashed slot; a slot claimed twice with different attack
+///        sets means a bad magic and aborts. That check covers every subset,
+///        so a clean fill is as strong as verify_or_die() at no extra cost.
+///        (A slider always attacks at least one square, so 0 = empty slot.)
+template <typename StepArr>
+void fill_magic_table(SquareMagic (&magics)[64], const uint64_t (&numbers)[64],
+                      uint64_t* table, const StepArr& steps, const char* what) {
+    for (int sq = 0; sq < 64; ++sq) {
+        SquareMagic& m = magics[sq];
+        m.magic = numbers[sq];
+        const uint64_t n_subsets = 1ULL << (64 - m.shift);
+        for (uint64_t n = 0; n < n_subsets; ++n) {
+            const uint64_t occ = nth_subset_of_mask(m.mask, n);
+            const uint64_t attacks = ray_attacks(sq, occ, steps);
+            uint64_t& slot = table[m.offset + ((occ * m.magic) >> m.shift)];
+            if (slot != 0 && slot != attacks) {
+                std::fprintf(stderr, "FATAL: shipped %s magic collides at sq=%d "
+                                     "(regenerate with magic_gen --regen-magics)\n", what, sq);
                 std::abort();
             }
+            slot = attacks;
         }
     }
 }
@@ -286,45 +392,76 @@ void verify_or_die() {
 
 // ---- Public init ---------------------------------------------------
 
-/// @brief Build all per-square masks, find a magic for every rook and bishop
-///        square, and populate the attack tables. Call once at startup before
-///        magic_rook_attacks / magic_bishop_attacks. Aborts if any magic search
-///        fails (should never happen with the fixed seed).
+/// @brief Build all per-square masks, install the shipped magics
+///        (magic_numbers.hpp), and populate the attack tables. Call once at
+///        startup before magic_rook_attacks / magic_bishop_attacks. Aborts if
+///        a shipped magic does not hash its square collision-free or (PEXT
+///        builds) pext does not map a blocker subset to its slot.
 void init_magic_bitboards() {
     static bool done = false;
     if (done) return;
 
-    // 1. Compute relevant-occupancy masks for all squares.
-    for (int sq = 0; sq < 64; ++sq) {
-        ROOK_MASKS[sq]   = compute_rook_mask(sq);
-        BISHOP_MASKS[sq] = compute_bishop_mask(sq);
+#if ENABLE_PEXT_ATTACKS
+    // user-027: fail loudly up front rather than SIGILL on the first lookup.
+    if (!cpu_has_bmi2()) {
+        std::fprintf(stderr, "FATAL: this binary was built with ENABLE_PEXT_ATTACKS "
+                             "but the CPU does not support BMI2; rebuild with "
+                             "-DENABLE_PEXT_ATTACKS=OFF\n");
+        std::abort();
     }
+#endif
+
+    // 1. Relevant-occupancy masks, shifts, and packed slice offsets.
+    compute_layout();
+
+    // 2. user-029: shipped magics — no startup search. The fill is
+    //    self-checking (see fill_magic_table).
+    fill_magic_table(ROOK_MAGICS, ROOK_MAGIC_NUMBERS, ROOK_ATTACK_TABLE, ROOK_STEPS, "rook");
+    fill_magic_table(BISHOP_MAGICS, BISHOP_MAGIC_NUMBERS, BISHOP_ATTACK_TABLE, BISHOP_STEPS, "bishop");
+
+#if ENABLE_PEXT_ATTACKS
+    // 2b. Dense PEXT tables (user-027) — copied from the magic tables, and
+    //     self-checking like them (see fill_pext_table).
+    fill_pext_table(ROOK_MAGICS, ROOK_PEXT_TABLE, magic_rook_attacks, "rook");
+    fill_pext_table(BISHOP_MAGICS, BISHOP_PEXT_TABLE, magic_bishop_attacks, "bishop");
+#endif
+
+#ifdef DEBUG
+    // 3. Debug builds also run the independent exhaustive ray-walker pass
+    //    (~9 ms, about as long as the rest of init).
+    verify_or_die();
+#endif
 
-    // 2. Find magics (deterministic via fixed PRNG seed).
+    done = true;
+}
+
+/// @brief Exhaustively check every lookup against the ray walker (aborts on
+///        a mismatch). Used by magic_gen and the tests; init runs it in DEBUG.
+void verify_magic_tables() {
+    verify_or_die();
+}
+
+/// @brief Re-run the deterministic PRNG magic search from MAGIC_SEED for every
+///        square (slow: ~0.3 s). Only the magic_gen tool calls this.
+/// @return false if any square exhausted its attempt budget.
+bool search_magics(uint64_t rook_out[64], uint64_t bishop_out[64]) {
+    compute_layout();
     XorShift64 rng(MAGIC_SEED);
     for (int sq = 0; sq < 64; ++sq) {
-        if (!find_magic_for_square(sq, ROOK_MASKS[sq], ROOK_SHIFT,
-                                    ROOK_ATTACK_TABLE[sq],
-                                    ROOK_TABLE_SIZE_PER_SQ,
-                                    ROOK_STEPS, rng,
-                                    &ROOK_MAGICS[sq])) {
-            std::fprintf(stderr, "FATAL: no rook magic found for sq=%d\n", sq);
-            std::abort();
+        const SquareMagic& r = ROOK_MAGICS[sq];
+        if (!find_magic_for_square(sq, r.mask, static_cast<int>(r.shift), 1 << (64 - r.shift),
+                                   ROOK_STEPS, rng, &rook_out[sq])) {
+            std::fprintf(stderr, "no rook magic found for sq=%d\n", sq);
+            return false;
         }
-        if (!find_magic_for_square(sq, BISHOP_MASKS[sq], BISHOP_SHIFT,
-                                    BISHOP_ATTACK_TABLE[sq],
-                                    BISHOP_TABLE_SIZE_PER_SQ,
-                                    BISHOP_STEPS, rng,
-                                    &BISHOP_MAGICS[sq])) {
-            std::fprintf(stderr, "FATAL: no bishop magic found for sq=%d\n", sq);
-            std::abort();
+        const SquareMagic& b = BISHOP_MAGICS[sq];
+        if (!find_magic_for_square(sq, b.mask, static_cast<int>(b.shift), 1 << (64 - b.shift),
+                                   BISHOP_STEPS, rng, &bishop_out[sq])) {
+            std::fprintf(stderr, "no bishop magic found for sq=%d\n", sq);
+            return false;
         }
     }
-
-    // 3. Exhaustive verification before any search code touches these.
-    verify_or_die();
-
-    done = true;
+    return true;
 }
 
 } // namespace Magic
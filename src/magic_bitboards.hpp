@@ -8,30 +8,49 @@
  * attack_detection.cpp, see.cpp, and the mobility eval in search.cpp
  * are unchanged.
  *
- * ## Layout: plain magic, fixed per-piece shifts
+ * ## Layout: "fancy" magic, per-square shifts (user-028)
  *
- * - Rook: every square gets a 4096-entry attack table (= 2^12 since
- *   the rook's worst-case relevant-occupancy mask has 12 bits).
- *   Shift is a constant 52 for all squares.
- * - Bishop: every square gets a 512-entry table (= 2^9). Shift is 55.
+ * Each square's relevant-occupancy mask has between 5 and 12 bits
+ * (rooks 10-12, bishops 5-9), so each square gets exactly
+ * 2^popcount(mask) slots and its own shift (64 - popcount). The
+ * per-square slices are packed back to back into one shared array per
+ * piece type; SquareMagic::offset is where a square's slice starts.
  *
- * Total RAM: 64*4096*8 + 64*512*8 = ~2.25 MB. Larger than fancy magic
- * (~840 KB) but the code is simpler and the working set is still tiny
- * relative to modern caches.
+ * - Rook:   102400 entries (was 64*4096 = 262144 with a uniform shift)
+ * - Bishop:   5248 entries (was 64*512  =  32768)
  *
- * ## Magic provenance
+ * Total RAM: ~840 KB, down from ~2.25 MB (-63%). Everything a lookup
+ * needs besides the attack slot itself — mask, magic, offset, shift —
+ * sits in one 24-byte SquareMagic, so a lookup touches two cache lines
+ * instead of three (see docs/PROFILE_OBSERVATIONS.md for the measurement).
  *
- * Magic numbers are *found* at init from a deterministic 64-bit
- * xorshift PRNG seeded with a hardcoded constant (see MAGIC_SEED in
- * magic_bitboards.cpp). The same seed always yields the same magics,
- * so behaviour is bit-identical across runs and machines — equivalent
- * to a hardcoded magic table, but expressed as ~30 lines of generator
- * code rather than 128 hand-transcribed uint64s.
+ * ## Magic provenance (user-029)
  *
- * After magics are found, every (square, occupancy-subset) is
- * verified against the existing slow_*_attacks ray-walker. A mismatch
- * triggers std::abort — better to fail loudly at init than silently
- * corrupt search.
+ * The magics ship as constexpr tables in magic_numbers.hpp, generated by
+ * the magic_gen tool (`magic_gen --regen-magics`) from the deterministic
+ * xorshift PRNG search seeded with MAGIC_SEED (magic_bitboards.cpp). The
+ * search used to run on every process start (~0.3 s, and the gauntlet
+ * harness launches the engine thousands of times); now init only fills
+ * the tables from the shipped numbers.
+ *
+ * The fill itself is self-checking: a slot claimed by two blocker
+ * subsets with different attack sets aborts, which covers every
+ * (square, occupancy-subset) — better to fail loudly at init than
+ * silently corrupt search. DEBUG builds additionally run the
+ * independent verify_magic_tables() pass.
+ *
+ * ## Optional PEXT backend (user-027, ENABLE_PEXT_ATTACKS)
+ *
+ * On BMI2 hardware `_pext_u64(occupied, mask)` compresses the relevant
+ * blockers straight into a dense index — no multiply, no magic. The PEXT
+ * tables use the same per-square slice sizes as the fancy magics, so they
+ * share SquareMagic::offset. Selected at build time
+ * (-DENABLE_PEXT_ATTACKS=ON → a separate BMI2-only binary); init aborts
+ * with a clear message if that binary lands on a CPU without BMI2. The magic
+ * tables are still built and verified either way, so the two backends can be
+ * benchmarked side by side (benchmark/slider_bench.cpp). The PEXT tables are
+ * copied from the magic tables, and init checks that the CPU's pext maps
+ * every blocker subset to its slot, in release builds too.
  *
  * @see bitboard.cpp for the public bishop_attacks()/rook_attacks()
  *      wrappers that delegate here, plus the slow_*_attacks reference
@@ -41,6 +60,27 @@
 
 #include <cstdint>
 
+// user-027: PEXT/BMI2 slider backend. Source default 0 (portable magic);
+// CMake forwards an explicit 0/1.
+#ifndef ENABLE_PEXT_ATTACKS
+#define ENABLE_PEXT_ATTACKS 0
+#endif
+
+// Marks the functions that execute pext. Only they are compiled for BMI2:
+// the build adds no -mbmi2, so the rest of the binary (init's cpu_has_bmi2()
+// check included) stays baseline x86-64 and cannot SIGILL before that check.
+// Empty for magic builds and for MSVC, whose intrinsics need no target flag.
+#if ENABLE_PEXT_ATTACKS
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#define PEXT_TARGET
+#else
+#define PEXT_TARGET __attribute__((target("bmi2")))
+#endif
+#else
+#define PEXT_TARGET
+#endif
+
 /**
  * @namespace Magic
  * @brief Magic-bitboard slider attack generation.
@@ -52,58 +92,103 @@
  */
 namespace Magic {
 
-// ---- Table dimensions (fixed-shift plain magic) ---------------------
+// ---- Table dimensions (fancy magic) ---------------------------------
 //
-// Worst-case mask popcount: 12 for rooks (corner squares),
-// 9 for bishops (center squares). Using a uniform per-piece shift
-// means every square's attack table is the same size — simple
-// indexing, no per-square pointer arithmetic.
+// Worst-case mask popcount: 12 for rooks (corner squares), 9 for
+// bishops (center squares) — bounds the per-square slice size. The
+// packed totals are the sums of 2^popcount(mask) over all 64 squares.
 constexpr int ROOK_MASK_BITS_MAX   = 12;
 constexpr int BISHOP_MASK_BITS_MAX = 9;
-constexpr int ROOK_SHIFT   = 64 - ROOK_MASK_BITS_MAX;     // 52
-constexpr int BISHOP_SHIFT = 64 - BISHOP_MASK_BITS_MAX;   // 55
-constexpr int ROOK_TABLE_SIZE_PER_SQ   = 1 << ROOK_MASK_BITS_MAX;   // 4096
-constexpr int BISHOP_TABLE_SIZE_PER_SQ = 1 << BISHOP_MASK_BITS_MAX; //  512
+constexpr int ROOK_TABLE_SIZE   = 102400;
+constexpr int BISHOP_TABLE_SIZE = 5248;
+
+/// @brief Everything one square's lookup needs, in one 24-byte record.
+struct SquareMagic {
+    uint64_t mask;     ///< Relevant-occupancy mask (blocker squares, edges excluded).
+    uint64_t magic;    ///< Multiplier: perfect hash of (occ & mask) into the slice.
+    uint32_t offset;   ///< Start of this square's slice in the shared attack table.
+    uint32_t shift;    ///< 64 - popcount(mask).
+};
 
 // ---- Globally-visible tables (populated by init_magic_bitboards) ----
-//
-// MASKS[sq] is the set of squares whose occupancy can block this
-// piece's attacks from sq (excludes edge squares since rays always
-// stop at the edge regardless of occupancy there).
-extern uint64_t ROOK_MASKS[64];
-extern uint64_t BISHOP_MASKS[64];
-
-// MAGICS[sq] is the per-square 64-bit multiplier that produces a
-// collision-free perfect-hash from (occupancy & MASKS[sq]) into
-// [0, TABLE_SIZE_PER_SQ).
-extern uint64_t ROOK_MAGICS[64];
-extern uint64_t BISHOP_MAGICS[64];
-
-// ATTACK_TABLE[sq][index] is the precomputed attack bitboard for the
-// occupancy pattern that produces `index` via the magic transform.
-extern uint64_t ROOK_ATTACK_TABLE[64][ROOK_TABLE_SIZE_PER_SQ];
-extern uint64_t BISHOP_ATTACK_TABLE[64][BISHOP_TABLE_SIZE_PER_SQ];
-
-// Find magics, populate masks + attack tables, verify against
-// ray-walker. std::abort on any verification mismatch.
-// Idempotent: subsequent calls are no-ops.
+extern SquareMagic ROOK_MAGICS[64];
+extern SquareMagic BISHOP_MAGICS[64];
+
+// ATTACK_TABLE[offset + index] is the precomputed attack bitboard for
+// the occupancy pattern that produces `index` via the magic transform.
+extern uint64_t ROOK_ATTACK_TABLE[ROOK_TABLE_SIZE];
+extern uint64_t BISHOP_ATTACK_TABLE[BISHOP_TABLE_SIZE];
+
+// Populate masks + attack tables from the shipped magics
+// (magic_numbers.hpp). std::abort if a magic collides or pext does
+// not map a blocker subset to its PEXT slot. Idempotent: subsequent
+// calls are no-ops.
 void init_magic_bitboards();
 
+// Exhaustive lookup-vs-ray-walker check (magic and, if built, PEXT);
+// std::abort on any mismatch. Called by init only in DEBUG builds (the
+// checks init always runs are cheaper: see init_magic_bitboards).
+void verify_magic_tables();
+
+// user-029: re-run the PRNG magic search (slow; magic_gen --regen-magics).
+bool search_magics(uint64_t rook_out[64], uint64_t bishop_out[64]);
+
 // ---- Hot-path lookups ------------------------------------------------
 //
 // Inline so callers in bitboard.cpp's bishop_attacks/rook_attacks
 // (which themselves are likely to be inlined further) compile down to
 // a mask + multiply + shift + indexed load.
 inline uint64_t magic_rook_attacks(int sq, uint64_t occupied) {
-    const uint64_t blockers = occupied & ROOK_MASKS[sq];
-    const uint64_t index    = (blockers * ROOK_MAGICS[sq]) >> ROOK_SHIFT;
-    return ROOK_ATTACK_TABLE[sq][index];
+    const SquareMagic& m = ROOK_MAGICS[sq];
+    return ROOK_ATTACK_TABLE[m.offset + (((occupied & m.mask) * m.magic) >> m.shift)];
 }
 
 inline uint64_t magic_bishop_attacks(int sq, uint64_t occupied) {
-    const uint64_t blockers = occupied & BISHOP_MASKS[sq];
-    const uint64_t index    = (blockers * BISHOP_MAGICS[sq]) >> BISHOP_SHIFT;
-    return BISHOP_ATTACK_TABLE[sq][index];
+    const SquareMagic& m = BISHOP_MAGICS[sq];
+    return BISHOP_ATTACK_TABLE[m.offset + (((occupied & m.mask) * m.magic) >> m.shift)];
+}
+
+#if ENABLE_PEXT_ATTACKS
+// ---- PEXT backend (user-027) -----------------------------------------
+//
+// Same slice sizes and offsets as the fancy magics; slot n of a slice
+// holds the attacks for the blocker subset pext() maps to n.
+extern uint64_t ROOK_PEXT_TABLE[ROOK_TABLE_SIZE];
+extern uint64_t BISHOP_PEXT_TABLE[BISHOP_TABLE_SIZE];
+
+PEXT_TARGET inline uint64_t pext_rook_attacks(int sq, uint64_t occupied) {
+    const SquareMagic& m = ROOK_MAGICS[sq];
+    return ROOK_PEXT_TABLE[m.offset + _pext_u64(occupied, m.mask)];
+}
+
+PEXT_TARGET inline uint64_t pext_bishop_attacks(int sq, uint64_t occupied) {
+    const SquareMagic& m = BISHOP_MAGICS[sq];
+    return BISHOP_PEXT_TABLE[m.offset + _pext_u64(occupied, m.mask)];
+}
+#endif
+
+// ---- Build-selected backend ------------------------------------------
+//
+// What bishop_attacks()/rook_attacks() in bitboard.cpp delegate to.
+PEXT_TARGET inline uint64_t slider_rook_attacks(int sq, uint64_t occupied) {
+#if ENABLE_PEXT_ATTACKS
+    return pext_rook_attacks(sq, occupied);
+#else
+    return magic_rook_attacks(sq, occupied);
+#endif
+}
+
+PEXT_TARGET inline uint64_t slider_bishop_attacks(int sq, uint64_t occupied) {
+#if ENABLE_PEXT_ATTACKS
+    return pext_bishop_attacks(sq, occupied);
+#else
+    return magic_bishop_attacks(sq, occupied);
+#endif
+}
+
+/// @brief Name of the compiled-in slider backend ("pext" or "magic").
+inline const char* slider_backend_name() {
+    return ENABLE_PEXT_ATTACKS ? "pext" : "magic";
 }
 
 } // namespace Magic
@@ -0,0 +1,55 @@
+/**
+ * @file magic_numbers.hpp
+ * @brief Shipped fancy-magic multipliers for rook and bishop attacks.
+ *
+ * GENERATED by `magic_gen --regen-magics` (tools/magics/magic_gen.cpp) —
+ * do not edit by hand. Index = square (a1 = 0 ... h8 = 63). Each magic
+ * hashes its square's blocker subsets into a 2^popcount(mask)-slot slice
+ * (see magic_bitboards.hpp); init_magic_bitboards() aborts if one
+ * does not.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace Magic {
+
+constexpr uint64_t ROOK_MAGIC_NUMBERS[64] = {
+    0x1080002080400010ULL, 0x0140001001402000ULL, 0x1200200810804200ULL, 0x078014b000810800ULL,
+    0x018018000c008002ULL, 0x1200010802000410ULL, 0xa080420010802100ULL, 0x0200020400902841ULL,
+    0x0080801020804000ULL, 0x0080400020100040ULL, 0x1402808020001000ULL, 0x040a001200200840ULL,
+    0x6048800400808800ULL, 0x0282000402001008ULL, 0x2825000401002200ULL, 0x0202000220488104ULL,
+    0x2000808000400022ULL, 0x0150144020004000ULL, 0x0880220012004080ULL, 0x0800808010000802ULL,
+    0x2540050008001100ULL, 0x4000880120041040ULL, 0x0002040008413002ULL, 0x00260a0010410084ULL,
+    0x0040400080002080ULL, 0x2000200540045000ULL, 0x0020002080100080ULL, 0x140021010010000aULL,
+    0x0914008080040800ULL, 0x1001000900340042ULL, 0x3502151c00081016ULL, 0x0080008200106c01ULL,
+    0x009040008d800620ULL, 0x4900200082804000ULL, 0x1001802004801002ULL, 0x400800808a801000ULL,
+    0x6034004008080080ULL, 0x9000040080800200ULL, 0x0802011004000208ULL, 0x02008020c0800d00ULL,
+    0x0d00400080218000ULL, 0x0210002000484001ULL, 0xc000200500110040ULL, 0x0000080010008080ULL,
+    0x0301000800110006ULL, 0x4000040002008080ULL, 0x8021000a00090004ULL, 0x4200040850820021ULL,
+    0x021142800c210100ULL, 0x0100400a201005c0ULL, 0x140410c08203a200ULL, 0x40828820c0120200ULL,
+    0x0001001004080100ULL, 0x6200800200040080ULL, 0x0000d002c1082400ULL, 0x5018010080540200ULL,
+    0x1001294100108202ULL, 0x8081011080224a02ULL, 0x2a24200010400901ULL, 0x08224820c4100101ULL,
+    0x0102002008100402ULL, 0x0001000802040001ULL, 0x0001000200008421ULL, 0x0006010415204282ULL,
+};
+
+constexpr uint64_t BISHOP_MAGIC_NUMBERS[64] = {
+    0x4490020821002200ULL, 0x0004240084290000ULL, 0x0004042c00500100ULL, 0x0008084100008240ULL,
+    0x4021114000242080ULL, 0x0008410821000011ULL, 0x0000a80410440000ULL, 0x4000e40400884880ULL,
+    0x000e20081008a088ULL, 0x0422040806024610ULL, 0x0000210810808200ULL, 0x0440144104202904ULL,
+    0x0600541044100004ULL, 0x0006020202218010ULL, 0x5000220101201300ULL, 0x0000608a00822040ULL,
+    0x8040080810840080ULL, 0x0408329002080068ULL, 0x14041c4208001300ULL, 0x049040080410c000ULL,
+    0x0204204202010048ULL, 0x0082010940462041ULL, 0x0200900200842010ULL, 0x0210868104188200ULL,
+    0x104804c108211800ULL, 0x010c100185105080ULL, 0x050401081000408aULL, 0x0040040102020808ULL,
+    0x00820020a6008048ULL, 0x0004420043008200ULL, 0x2092008b00441040ULL, 0x0424010040808090ULL,
+    0x40c960080291700cULL, 0x0008410400d00401ULL, 0x8000802080840800ULL, 0x0d03020082380080ULL,
+    0x0204040400001010ULL, 0x0410010200084040ULL, 0x0002808100c41400ULL, 0x0004041282804040ULL,
+    0x00020802080840a8ULL, 0x8109012802402002ULL, 0x0000210440400800ULL, 0x400000a124000800ULL,
+    0x8089080102441404ULL, 0x2022040800220201ULL, 0x0020016101028610ULL, 0x801024a200906841ULL,
+    0x0200822802401014ULL, 0x0400504424200801ULL, 0x0000882402680200ULL, 0x8040021046080000ULL,
+    0x0000102022048010ULL, 0x0a01200202220400ULL, 0x0320848400840080ULL, 0x04a001b10a028024ULL,
+    0x0001024804240200ULL, 0x100020210110100aULL, 0x1000220114020901ULL, 0x04820008c0840400ULL,
+    0x0000100120120480ULL, 0x1000049002107100ULL, 0x0200400508308900ULL, 0x0004213001020080ULL,
+};
+
+} // namespace Magic
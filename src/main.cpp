@@ -1,11 +1,19 @@
 /**
  * @file main.cpp
  * @brief Program entry point — constructs the UCI interface and runs its command loop.
+ *
+ * `huginn bench [depth] [hash] [threads]` runs the built-in fixed-depth
+ * benchmark once and exits instead of entering the UCI loop (user-026).
  */
 #include "uci.hpp"
 
-int main(int /*argc*/, char* /*argv*/[]) {
+int main(int argc, char* argv[]) {
     UCIInterface uci;
+    if (argc > 1 && std::string(argv[1]) == "bench") {
+        std::vector<std::string> tokens(argv + 1, argv + argc);
+        uci.handle_bench(tokens);
+        return 0;
+    }
     uci.run();
     return 0;
 }
@@ -0,0 +1,112 @@
+/**
+ * @file mapped_file.cpp
+ * @brief MappedFile implementation (POSIX mmap / Win32 file mapping).
+ */
+#include "mapped_file.hpp"
+
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Huginn {
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        open_ = std::exchange(other.open_, false);
+#ifdef _WIN32
+        mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    const std::size_t bytes = static_cast<std::size_t>(size.QuadPart);
+    bool ok = true;
+    if (bytes > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (view) {
+            mapping_ = mapping;
+            data_ = static_cast<const unsigned char*>(view);
+        } else {
+            if (mapping) CloseHandle(mapping);
+            ok = false;
+        }
+    }
+    CloseHandle(file);  // the mapping keeps the file open
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    const std::size_t bytes = static_cast<std::size_t>(st.st_size);
+    bool ok = true;
+    if (bytes > 0) {
+        void* view = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        if (view != MAP_FAILED) {
+            madvise(view, bytes, MADV_RANDOM);  // probes touch a few scattered pages
+            data_ = static_cast<const unsigned char*>(view);
+        } else {
+            ok = false;
+        }
+    }
+    ::close(fd);
+#endif
+
+    if (!ok) return false;
+    size_ = bytes;
+    open_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(static_cast<HANDLE>(mapping_));
+        mapping_ = nullptr;
+#else
+        munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+    }
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+}
+
+} // namespace Huginn
@@ -0,0 +1,48 @@
+/**
+ * @file mapped_file.hpp
+ * @brief Read-only memory-mapped file (mmap / MapViewOfFile).
+ *
+ * Shared by the Polyglot book (user-046) and the endgame tables (user-048):
+ * both are large, immutable and probed at scattered offsets, so they are
+ * mapped rather than read, with a random-access hint. Only the pages a probe
+ * touches are ever read from disk, and every engine process mapping the same
+ * file shares one copy in the page cache.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Huginn {
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Map @p path read-only, replacing any current mapping.
+     * @return false if the file cannot be opened or mapped. An empty file
+     *         maps successfully with data() == nullptr and size() == 0.
+     */
+    bool open(const std::string& path);
+    void close();
+
+    const unsigned char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool is_open() const { return open_; }
+
+private:
+    const unsigned char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool open_ = false;
+#ifdef _WIN32
+    void* mapping_ = nullptr;  ///< CreateFileMapping handle (HANDLE).
+#endif
+};
+
+} // namespace Huginn
@@ -39,7 +39,13 @@
  * 
  * **Performance:**
  * - Fast binary search: O(log n) lookup time
- * - Memory efficient: entries loaded on demand or cached
+ * - user-046: the file is memory-mapped and searched in place, in its on-disk
+ *   big-endian layout (Polyglot books are sorted by key by definition) — no
+ *   load-time read/byte-swap/sort pass and no in-RAM copy, so multi-GB books
+ *   open instantly and only the probed pages are ever read. The O(n) key
+ *   order check is verify_key_order(), for tools, not the load path
+ * - The probe key is computed at the root only (PolyglotKeys::compute, one
+ *   pass over the board), so the search's make/unmake carries no second hash
  * - Typical book sizes: 1MB-100MB (10K-1M positions)
  * 
  * @author MTDuke71
@@ -49,10 +55,11 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <random>
 #include <string>
-#include <vector>
-#include <fstream>
+#include "mapped_file.hpp"
 #include "move.hpp"
 #include "position.hpp"
 
@@ -86,7 +93,7 @@ struct PolyglotEntry {
  * Handles loading, parsing, and querying of Polyglot opening book files (.bin format).
  * Provides both deterministic (strongest move) and probabilistic (weighted random)
  * move selection from opening theory. Books are loaded once and kept in memory for
- * fast position lookup during gameplay.
+ * fast position lookup during gameplay. Move-only: it owns the file mapping.
  * 
  * ## Usage Pattern:
  * ```cpp
@@ -100,31 +107,54 @@ struct PolyglotEntry {
  */
 class PolyglotBook {
 private:
-    std::vector<PolyglotEntry> entries;
+    static constexpr std::size_t ENTRY_BYTES = 16;
+
+    MappedFile file;                      ///< Big-endian entries, mapped read-only.
+    std::size_t num_entries = 0;
     bool is_loaded = false;
     std::string book_path;
-    
-    // Convert internal move to Polyglot format
-    uint16_t move_to_polyglot(const S_MOVE& move) const;
+    /// Picks among weighted moves. Per book, so engines on different threads
+    /// (huginn_match slots) never share one; set_seed() makes it repeatable.
+    mutable std::mt19937_64 rng{std::random_device{}()};
     
     // Convert Polyglot move to internal format
     S_MOVE polyglot_to_move(uint16_t poly_move, const Position& pos) const;
     
-    // Binary search for entries with matching key
-    std::vector<const PolyglotEntry*> find_entries(uint64_t key) const;
+    // Binary search: index of the first entry with key >= @p key
+    std::size_t lower_bound(uint64_t key) const;
+    uint64_t key_at(std::size_t i) const;
 
 public:
     PolyglotBook() = default;
     explicit PolyglotBook(const std::string& path) : book_path(path) {}
+    PolyglotBook(const PolyglotBook&) = delete;
+    PolyglotBook& operator=(const PolyglotBook&) = delete;
+    PolyglotBook(PolyglotBook&& other) noexcept;
+    PolyglotBook& operator=(PolyglotBook&& other) noexcept;
     
-    // Generate Polyglot hash key for position (made public for debugging)
+    // Convert internal move to Polyglot format (castling as king-takes-rook;
+    // used by huginn_bookgen, user-047)
+    static uint16_t move_to_polyglot(const S_MOVE& move);
+
+    // Polyglot hash key for position — PolyglotKeys::compute (user-046)
     uint64_t get_polyglot_key(const Position& pos) const;
     
-    // Load opening book from file
+    // Map the opening book file (read-only) — see the Performance note above
     bool load_book(const std::string& path);
+
+    // Every adjacent pair in key order? Reads the whole file (O(n)), so
+    // load_book leaves it to tools: huginn_bookgen checks its output with it
+    bool verify_key_order() const;
+
+    std::size_t size() const { return num_entries; }
+    /// @brief Decoded entry @p i (0 <= i < size()), in key order.
+    PolyglotEntry entry_at(std::size_t i) const;
     
-    // Get book move for position (returns best weighted move)
+    // Get book move for position (weighted random choice)
     S_MOVE get_book_move(const Position& pos) const;
+
+    // Restart the move-choice sequence from @p seed (UCI `BookSeed`; user-050)
+    void set_seed(uint64_t seed) { rng.seed(seed); }
     
     // Check if position is in opening book
     bool has_book_moves(const Position& pos) const;
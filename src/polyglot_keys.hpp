@@ -0,0 +1,57 @@
+/**
+ * @file polyglot_keys.hpp
+ * @brief Polyglot book hashing: the standard Random64 table and key helpers.
+ *
+ * Polyglot uses its OWN Zobrist constants (the published 781-entry Random64
+ * table), independent of the engine's internal Zobrist (zobrist.hpp).
+ * Layout: RandomPiece (0..767), RandomCastle (768..771), RandomEnPassant
+ * (772..779), RandomTurn (780).
+ *
+ * user-046: split out of polyglot_book.cpp so huginn_bookgen and the tests
+ * share one table. The book is only probed at the root, so the key is
+ * computed there with compute() rather than carried through every
+ * make/unmake of the search.
+ */
+#pragma once
+
+#include <cstdint>
+#include "chess_types.hpp"
+
+class Position;
+
+namespace Huginn {
+namespace PolyglotKeys {
+
+extern const uint64_t RANDOM64[781];
+
+constexpr int OFFSET_PIECE = 0;
+constexpr int OFFSET_CASTLE = 768;
+constexpr int OFFSET_EP = 772;
+constexpr int OFFSET_TURN = 780;
+
+/// @brief Polyglot piece kind: black pawn 0, white pawn 1, black knight 2,
+///        ..., white king 11 (PieceType Pawn..King = 1..6).
+constexpr int kind_of(::Piece piece) {
+    return (int(type_of(piece)) - 1) * 2 + (color_of(piece) == Color::White ? 1 : 0);
+}
+
+/// @brief RandomPiece entry for @p piece on @p sq (sq64 = Polyglot's 8*row + file).
+inline uint64_t piece_key(::Piece piece, int sq) {
+    return RANDOM64[OFFSET_PIECE + 64 * kind_of(piece) + sq];
+}
+
+/// @brief XOR of the RandomCastle entries for a castling mask. CASTLE_WK/WQ/
+///        BK/BQ are bits 0..3, the same order as Polyglot's four entries.
+inline uint64_t castle_key(uint8_t rights) {
+    uint64_t key = 0;
+    for (int i = 0; i < 4; ++i) {
+        if (rights & (1u << i)) key ^= RANDOM64[OFFSET_CASTLE + i];
+    }
+    return key;
+}
+
+/// @brief Full-scan Polyglot key of @p pos (pieces, castling, ep file, turn).
+uint64_t compute(const Position& pos);
+
+} // namespace PolyglotKeys
+} // namespace Huginn
@@ -392,6 +392,94 @@ void Position::set_startpos() {
     set_from_fen(start_fen);
 }
 
+/// @brief Answer "would generate_all_moves() emit exactly this encoding?" from
+///        the bitboards alone (user-037). Mirrors movegen_bb.cpp rule by rule,
+///        so a TT/killer/PV move that passes can be made without generating
+///        the list; test_pseudo_legal.cpp checks the equivalence exhaustively.
+bool Position::is_pseudo_legal(const S_MOVE& move) const {
+    const int m = move.move;
+    // Bits above the castle flag are never set; from/to fields are 7 bits wide.
+    if (m <= 0 || (m & ~(MOVE_CASTLE | (MOVE_CASTLE - 1))) != 0) return false;
+    const int from = move.get_from();
+    const int to = move.get_to();
+    if (from >= 64 || to >= 64 || from == to) return false;
+
+    const int us = int(side_to_move);
+    const uint64_t from_bb = 1ULL << from;
+    const uint64_t to_bb = 1ULL << to;
+    if (!(color_bitboards[us] & from_bb)) return false;
+    if (color_bitboards[us] & to_bb) return false;
+
+    PieceType mover = PieceType::None;
+    for (int t = int(PieceType::Pawn); t <= int(PieceType::King); ++t) {
+        if (piece_bitboards[us][t] & from_bb) { mover = PieceType(t); break; }
+    }
+    const PieceType victim = (occupied_bitboard & to_bb) ? type_of(at_sq64(to)) : PieceType::None;
+    const PieceType promoted = move.get_promoted();
+
+    if (move.is_castle()) {
+        if (mover != PieceType::King) return false;
+        // Exact generator encoding: king from e1/e8, two files over, no other field.
+        if ((m & ~(MOVE_CASTLE | MOVE_FROM_MASK | MOVE_TO_MASK)) != 0) return false;
+        const int home = side_to_move == Color::White ? sq64(File::E, Rank::R1) : sq64(File::E, Rank::R8);
+        if (from != home) return false;
+        const bool king_side = (to == home + 2);
+        if (!king_side && to != home - 2) return false;
+        const uint8_t right = side_to_move == Color::White ? (king_side ? CASTLE_WK : CASTLE_WQ)
+                                                           : (king_side ? CASTLE_BK : CASTLE_BQ);
+        if (!(castling_rights & right)) return false;
+        const int rook_sq = king_side ? home + 3 : home - 4;
+        if (!(piece_bitboards[us][int(PieceType::Rook)] & (1ULL << rook_sq))) return false;
+        // Squares between king and rook must be empty (b1 included on O-O-O).
+        const uint64_t path = king_side ? (0x3ULL << (home + 1)) : (0x7ULL << (home - 3));
+        if (occupied_bitboard & path) return false;
+        const Color them = !side_to_move;
+        const int step = king_side ? 1 : -1;
+        return !Huginn::SqAttackedBB(home, *this, them) &&
+               !Huginn::SqAttackedBB(home + step, *this, them) &&
+               !Huginn::SqAttackedBB(home + 2 * step, *this, them);
+    }
+
+    if (mover != PieceType::Pawn) {
+        // Pawn-only flags and a captured field that disagrees with the board.
+        if (move.is_en_passant() || move.is_pawn_start() || promoted != PieceType::None) return false;
+        if (move.get_captured() != victim) return false;
+        switch (mover) {
+            case PieceType::Knight: return (knight_attacks[from] & to_bb) != 0;
+            case PieceType::Bishop: return (bishop_attacks(from, occupied_bitboard) & to_bb) != 0;
+            case PieceType::Rook:   return (rook_attacks(from, occupied_bitboard) & to_bb) != 0;
+            case PieceType::Queen:  return (queen_attacks(from, occupied_bitboard) & to_bb) != 0;
+            case PieceType::King:   return (king_attacks[from] & to_bb) != 0;
+            default:                return false;
+        }
+    }
+
+    const bool white = side_to_move == Color::White;
+    const int forward = white ? 8 : -8;
+    const bool last_rank = white ? to >= 56 : to <= 7;
+
+    if (move.is_en_passant()) {
+        return to == ep_square && move.get_captured() == PieceType::Pawn &&
+               !move.is_pawn_start() && promoted == PieceType::None &&
+               (pawn_attacks[us][from] & to_bb) != 0;
+    }
+    if (move.get_captured() != victim) return false;
+    // Promotion piece required exactly on the last rank, and must be N/B/R/Q.
+    if (last_rank != (promoted != PieceType::None)) return false;
+    if (last_rank && (promoted == PieceType::Pawn || promoted == PieceType::King ||
+                      int(promoted) > int(PieceType::King))) return false;
+
+    if (victim != PieceType::None) {
+        return !move.is_pawn_start() && (pawn_attacks[us][from] & to_bb) != 0;
+    }
+    if (move.is_pawn_start()) {
+        const bool start_rank = white ? (from >= 8 && from < 16) : (from >= 48 && from < 56);
+        return start_rank && to == from + 2 * forward &&
+               !(occupied_bitboard & (1ULL << (from + forward)));
+    }
+    return to == from + forward;
+}
+
 /// @brief Apply a pseudo-legal move with full incremental update (bitboards,
 ///        Zobrist, castling/ep, clocks) and push an undo record, then test
 ///        legality by checking whether the mover's king is left in check.
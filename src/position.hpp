@@ -162,6 +162,18 @@ public:
      */
     int MakeMove(const S_MOVE& move);
 
+    /**
+     * @brief O(1) check that @p move is one generate_all_moves() would emit here. (user-037)
+     * @param move A packed move from an untrusted source (TT entry, killer slot, PV table).
+     * @return true iff the encoding matches exactly: own piece on the from-square,
+     *         a reachable to-square (slider path clear), the captured / ep /
+     *         pawn-start / promotion / castle fields all consistent with the
+     *         board. Castling is checked fully (rights, path, attacked squares),
+     *         as the generator does; every other move may still leave the king
+     *         in check, which MakeMove() reports.
+     */
+    bool is_pseudo_legal(const S_MOVE& move) const;
+
     /// Reverses the most recent MakeMove, popping the undo stack. (VICE #42)
     void TakeMove();
 
@@ -37,9 +37,12 @@
 #include "input_checking.hpp"
 #include "msvc_optimizations.hpp"
 #include "see.hpp"
+#include "cuckoo.hpp"
+#include "uci_output.hpp"
 #include <cassert>
 #include <climits>   // INT_MIN selection sentinel (ENABLE_SEE_ORDER_SPLIT)
 #include <cstdlib>
+#include <cstring>   // memset: pick_next_move's batched mover table
 #include <cmath>     // for std::log used by the LMR-table initializer
 #include <array>
 #include <iostream>
@@ -192,6 +195,73 @@
 #define ENABLE_LMP 0
 #endif
 
+// ENABLE_IIR: user-034 — internal iterative REDUCTIONS in place of the nested
+// IID search. IID (internal_iterative_deepening) answers a TT miss at a PV
+// node with a whole depth-2 search of its own (own move generation, own
+// make/unmake loop) just to find an ordering move — at high depth that
+// re-searches a large subtree that the real search then visits again. Flag
+// ON: no nested search; a node at depth >= IIR_MIN_DEPTH with no TT move
+// (PV or not — a TT miss at a cut node is as much "unknown territory")
+// is searched one ply shallower, and the next iteration's visit finds the
+// entry this one stores. `info.iir_reductions` counts them. CANDIDATE —
+// DEFAULT OFF pending SPRT; the OFF arm is byte-identical to the IID arm.
+// Build the ON arm with -DENABLE_IIR=1.
+#ifndef ENABLE_IIR
+#define ENABLE_IIR 0
+#endif
+
+// ENABLE_UPCOMING_REPETITION: user-035 — cuckoo upcoming-repetition
+// detection. repetition_count_in_history only sees repetitions that have
+// already happened, so a shuffling fortress is searched move by move until
+// the repeat actually lands on the board (the #28/#44 endgames burned their
+// time there). Flag ON: at a non-root node, if the side to move has one
+// reversible move that completes a threefold (Cuckoo::upcoming_repetition —
+// one table lookup per odd ply of the window, see cuckoo.hpp), alpha is
+// raised to the score that move backs up (+CONTEMPT: the repeated node
+// returns -CONTEMPT for ITS side to move) and the node cuts if that already
+// reaches beta. Threefold only, not Stockfish's "any in-tree cycle": a lone
+// repetition is not a draw in this engine (see the #28 Part 2 block in
+// AlphaBeta), and scoring it as one raised nodes +8.6% on the shuffle set
+// in docs/PROFILE_OBSERVATIONS.md. Runs after the draw returns and before the
+// TT probe, like them. CANDIDATE — DEFAULT OFF pending SPRT; build the ON arm
+// with -DENABLE_UPCOMING_REPETITION=1.
+#ifndef ENABLE_UPCOMING_REPETITION
+#define ENABLE_UPCOMING_REPETITION 0
+#endif
+
+// ENABLE_PROBCUT: user-038 — ProbCut. Nothing in the pruning stack uses a
+// search to prove a cutoff at high depth except null move, and null move
+// says nothing when the side to move has a good capture to make. Flag ON: at
+// a non-PV node of depth >= PROBCUT_MIN_DEPTH, captures whose SEE already
+// clears probcut_beta - static eval (probcut_beta = beta + PROBCUT_MARGIN)
+// are tried with a quiescence probe and then a null-window search at
+// depth - PROBCUT_REDUCTION against probcut_beta. One that holds proves with
+// high probability that the full-depth search would fail high too, so the
+// node returns beta and stores a LOWER_BOUND at the reduced depth + 1. A TT
+// entry that is already deep enough and scored below probcut_beta skips the
+// whole attempt. `info.probcut_cuts` counts cutoffs. CANDIDATE — DEFAULT OFF
+// pending SPRT; the OFF arm is byte-identical. Build the ON arm with
+// -DENABLE_PROBCUT=1.
+#ifndef ENABLE_PROBCUT
+#define ENABLE_PROBCUT 0
+#endif
+
+// ENABLE_TT_MOVE_FIRST: user-037 — search the TT move before generating the
+// rest. A node with a TT move used to generate and score the full list only
+// for the TT move (3,000,000 in pick_next_move) to be tried first, and at a
+// cut node that one move is usually all that gets searched. Flag ON: if
+// Position::is_pseudo_legal() accepts the TT move it is searched from a
+// one-entry list; the full list is generated (and the TT move swapped into
+// the slot it already used) only if it did not cut. The rest of the list is
+// then scored with the history/killers the TT move's subtree just updated,
+// so node counts differ from the OFF arm, which is the original loop.
+// CANDIDATE — DEFAULT OFF pending SPRT; build the ON arm with
+// -DENABLE_TT_MOVE_FIRST=1. (is_pseudo_legal() itself and its PV-walk use
+// are unconditional.)
+#ifndef ENABLE_TT_MOVE_FIRST
+#define ENABLE_TT_MOVE_FIRST 0
+#endif
+
 // ENABLE_NMP_VERIFICATION: BACKLOG #43 sub-lever 1. Guard the null-move cutoff
 // against zugzwang false-positives. Huginn's NMP is flat R=4 with NO
 // verification — a genuine over-pruning / tactical-leak suspect (the Stash
@@ -343,6 +413,23 @@
 #ifndef ENABLE_RULE50_TT_GUARD
 #define ENABLE_RULE50_TT_GUARD 1
 #endif
+// ENABLE_QSEARCH_TT: user-033. Quiescence used the TT only for its ordering
+// move (#48). Flag ON: it probes at entry and takes the same bound cutoffs as
+// AlphaBeta (any stored depth >= 0 qualifies), and stores its own result at
+// depth 0 — stand-pat fail-highs as a LOWER bound at the static eval, the
+// final fail-hard result as EXACT / LOWER / UPPER against the entry window.
+// Depth 0 is what AlphaBeta's leaf probe asks for (its depth-0 node is this
+// search), and depth-preferred replacement keeps a depth-0 store from
+// displacing deeper residents; a same-key main-search entry is also never
+// downgraded (the store is skipped). Mate scores use the
+// ENABLE_PLY_TRACKED_TT_MATE ply adjustment; the rule-50 guard
+// (ENABLE_RULE50_TT_GUARD) applies with depth 0, i.e. no TT cutoff or store
+// once the clock itself has reached 100. Node counts move (bench 8614973 →
+// 7705797). CANDIDATE — DEFAULT OFF pending SPRT (the OFF arm is the
+// ordering-move-only original); build the ON arm with -DENABLE_QSEARCH_TT=1.
+#ifndef ENABLE_QSEARCH_TT
+#define ENABLE_QSEARCH_TT 0
+#endif
 // ENABLE_LEGAL_MOVE_ORDINAL: BACKLOG #57 (2026-07-09 audit). The move loop's
 // pseudo-legal index `i` decided PVS first-move treatment, the LMR lateness
 // threshold/row, and fail-high-first telemetry — but illegal (e.g. pinned)
@@ -1197,33 +1284,31 @@ Position Engine::mirrorBoard(const Position& pos) {
     return mirrored_pos;
 }
 
+/// @brief user-043: `info depth d currmove m currmovenumber n` for a root
+///        move about to be searched — only once the search has run
+///        InfoThrottle::CURRMOVE_AFTER_MS, so short searches print none.
+void Engine::report_currmove(const SearchInfo& info, int depth, const S_MOVE& move, int number) {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - info.start_time).count();
+    if (!InfoThrottle::allow_currmove(elapsed)) return;
+    UciLine line;
+    line.str("info depth ").num(depth).str(" currmove ").move(move).str(" currmovenumber ").num(number);
+    line.emit(*info_out);
+}
+
 /// @brief Format an internal score as a UCI `score` token — `mate N` for mate
 ///        scores (≈ ±MATE), else `cp N`. @param side_to_move unused sign hook.
 std::string Engine::format_uci_score(int score, Color side_to_move) const {
-    // Convert engine score to proper UCI format
-    // UCI specification: 
+    // UCI specification:
     // - cp <x>: score from engine's point of view in centipawns
     // - mate <y>: mate in y MOVES (not plies). If engine is getting mated, use negative y
-    
-    // The search returns scores from the side-to-move's perspective:
-    // - Positive score means side-to-move is winning
-    // - Negative score means side-to-move is losing
-    
-    // MATE = 29000, so scores close to +/-MATE are mate scores
-    if (score > MATE - 100) {
-        // Positive mate score: side_to_move (engine) is mating opponent
-        int mate_in_plies = MATE - score;
-        int mate_in_moves = (mate_in_plies + 1) / 2;  // Convert plies to moves
-        return "mate " + std::to_string(mate_in_moves);
-    } else if (score < -MATE + 100) {
-        // Negative mate score: side_to_move (engine) is being mated
-        int mate_in_plies = MATE + score;  // score is negative, so this is MATE - abs(score)
-        int mate_in_moves = (mate_in_plies + 1) / 2;  // Convert plies to moves
-        return "mate -" + std::to_string(mate_in_moves);  // Negative because engine is being mated
-    } else {
-        // Regular centipawn score from engine's perspective
-        return "cp " + std::to_string(score);
-    }
+    // The search returns scores from the side-to-move's perspective, so
+    // side_to_move needs no flip. user-043: UciLine::score is the one
+    // formatter (the search writes it straight into its info line).
+    (void)side_to_move;
+    UciLine line;
+    line.score(score);
+    return std::string(line.view());
 }
 
 /// @brief Long-algebraic UCI string for a move (e.g. "e2e4", "e7e8q").
@@ -1322,10 +1407,10 @@ void Engine::clear_search_tables() {
     // BACKLOG #3: age the continuation-history table by /4 each new search,
     // mirroring search_history above — preserve 25% of cross-search learning
     // while making room for new. Construction zero-inits, so the first search
-    // ages zeros (still zero); no nondeterminism (cf. #30). ~692K int16 ops
+    // ages zeros (still zero); no nondeterminism (cf. #30). ~590K int16 ops
     // once per search — negligible against Mnps search.
-    for (size_t k = 0; k < CH_SIZE; ++k) {
-        continuation_history[k] = static_cast<int16_t>(continuation_history[k] / 4);
+    for (ContHistEntry& sub : continuation_history) {
+        for (int16_t& entry : sub) entry = static_cast<int16_t>(entry / 4);
     }
 #endif
 }
@@ -1447,51 +1532,45 @@ S_MOVE Engine::get_counter_move(const S_MOVE& previous_move) const {
 }
 
 #if ENABLE_CONTINUATION_HISTORY
-// BACKLOG #3: 1-ply continuation history. Both helpers take `pos` at the
-// current node (after TakeMove / before MakeMove), where the parent move's
-// piece sits on prev.get_to() and the current move's piece on move.get_from().
-//
-// Index validity: prev/move squares are sq64; piece_index uses the same
-// history_piece_row() convention as butterfly history (White 1-6, Black
-// 7-12, row 0 unused). A piece of None on prev.get_to() (shouldn't happen
-// for a real parent move, but guard anyway) maps to index 0 and is harmless.
-namespace {
-inline int ch_piece_index(Piece p) { return history_piece_row(p); }
+// user-032: continuation history, 1 and 2 plies back. info.cont_hist[p] is set
+// right after the move at ply p is made, so for the quiet move being scored or
+// updated at info.ply its contexts are the entries at ply-1 and ply-2 — no
+// board lookups, one load per context.
+
+/// @brief Sum of the 1- and 2-ply continuation scores for a quiet move of the
+///        piece in history row @p piece_row to @p to, searched at info.ply.
+int Engine::continuation_score(const SearchInfo& info, int piece_row, int to) const {
+    const int slot = cont_hist_index(piece_row, to);
+    int score = 0;
+    if (info.ply >= 1 && info.ply <= 64 && info.cont_hist[info.ply - 1])
+        score += (*info.cont_hist[info.ply - 1])[slot];
+    if (info.ply >= 2 && info.ply <= 65 && info.cont_hist[info.ply - 2])
+        score += (*info.cont_hist[info.ply - 2])[slot];
+    return score;
 }
 
-/// @brief Reward the (prev-move → this-move) pair on a cutoff — continuation
-///        history (BACKLOG #3, experimental: 1-ply additive was falsified, gated off).
-void Engine::update_continuation_history(const Position& pos, const S_MOVE& prev,
-                                         const S_MOVE& move, int bonus) {
-    if (prev.move == 0 || move.move == 0) return;
-    int prev_to = prev.get_to();
-    int from = move.get_from();
-    int to = move.get_to();
-    if (prev_to < 0 || prev_to >= 64 || from < 0 || from >= 64 || to < 0 || to >= 64) return;
-
-    int pp = ch_piece_index(pos.at_sq64(prev_to));   // parent mover, now resting on prev_to
-    int cp = ch_piece_index(pos.at_sq64(from));       // current mover, back on its from-square
-
-    // Clamp into int16 range to avoid overflow under repeated +/-depth^2 bonuses.
-    size_t idx = ch_index(pp, prev_to, cp, to);
-    int updated = continuation_history[idx] + bonus;
-    if (updated > 32000) updated = 32000;
-    else if (updated < -32000) updated = -32000;
-    continuation_history[idx] = static_cast<int16_t>(updated);
+/// @brief Gravity update of both continuation contexts of a quiet move:
+///        `entry += bonus - entry·|bonus| / CONTHIST_MAX`, which converges on
+///        ±CONTHIST_MAX instead of overflowing and lets fresh results move
+///        saturated entries.
+void Engine::update_continuation_history(SearchInfo& info, int piece_row, int to, int bonus) {
+    bonus = std::clamp(bonus, -CONTHIST_BONUS_MAX, CONTHIST_BONUS_MAX);
+    const int slot = cont_hist_index(piece_row, to);
+    for (int back = 1; back <= 2; ++back) {
+        const int ply = info.ply - back;
+        if (ply < 0 || ply >= 64 || !info.cont_hist[ply]) continue;
+        int16_t& entry = (*info.cont_hist[ply])[slot];
+        entry = static_cast<int16_t>(entry + bonus - entry * std::abs(bonus) / CONTHIST_MAX);
+    }
 }
 
-/// @brief Continuation-history ordering bonus for the (prev → this) move pair (#3).
-int Engine::get_continuation_history(const Position& pos, const S_MOVE& prev,
-                                     const S_MOVE& move) const {
-    if (prev.move == 0 || move.move == 0) return 0;
-    int prev_to = prev.get_to();
-    int from = move.get_from();
-    int to = move.get_to();
-    if (prev_to < 0 || prev_to >= 64 || from < 0 || from >= 64 || to < 0 || to >= 64) return 0;
-
-    int pp = ch_piece_index(pos.at_sq64(prev_to));
-    int cp = ch_piece_index(pos.at_sq64(from));
-    return continuation_history[ch_index(pp, prev_to, cp, to)];
+void Engine::set_continuation_context(SearchInfo& info, const Position& pos, const S_MOVE& move) {
+    if (info.ply < 0 || info.ply >= 64) return;
+    const int to = move.get_to();
+    const Piece moved = pos.at_sq64(to);
+    info.cont_hist[info.ply] = moved == Piece::None
+        ? nullptr
+        : &continuation_history[cont_hist_index(history_piece_row(moved), to)];
 }
 #endif
 
@@ -1683,32 +1762,72 @@ int Engine::pick_next_move(S_MOVELIST& move_list, int move_num, const Position&
         // Get PV move for this position (if any)
         S_MOVE pv_move;
         bool has_pv_move = pv_table.probe_move(pos.zobrist_key, pv_move);
-        
+
+        // user-031: everything below that does not depend on the move is
+        // resolved once per node instead of once per move. The special-move
+        // keys use -1 for "absent" (no encoded move is negative), so the
+        // per-move test is a plain compare with no validity flag.
+        const int tt_key  = tt_move_valid ? static_cast<int>(tt_best_move) : -1;
+        const int pv_key  = has_pv_move ? pv_move.move : -1;
+        const int iid_key = iid_move.move != 0 ? iid_move.move : -1;
+        const bool killer_depth = depth >= 0 && depth < 64;
+        const int killer1 = killer_depth ? search_killers[depth][0].move : -1;
+        const int killer2 = killer_depth ? search_killers[depth][1].move : -1;
+        int counter_key = -1;
+#if ENABLE_PLY_TRACKED_COUNTERMOVE
+        if (info.ply > 0 && info.ply < 64) {
+            const S_MOVE previous_move = info.search_stack[info.ply - 1];
+            if (previous_move.move != 0) {
+                const int counter = get_counter_move(previous_move).move;
+                if (counter != 0) counter_key = counter;
+            }
+        }
+#endif
+
+        // user-031: mover lookup in one batch. at_sq64() scans up to six
+        // piece bitboards with a data-dependent branch per step, and every
+        // capture (attacker) and quiet (history row) needs it. Wide lists
+        // instead spill the side to move's ~16 pieces into a 64-byte local
+        // table once; short quiescence lists keep the direct scan, which is
+        // cheaper than the fill below ~8 moves. Local to this call — not the
+        // persistent board64 cache that #26 reverted.
+        const bool batched = move_list.count >= 8;
+        const int us = static_cast<int>(pos.side_to_move);
+        uint8_t mover_type[64];
+        if (batched) {
+            std::memset(mover_type, 0, sizeof mover_type);
+            for (int t = int(PieceType::Pawn); t <= int(PieceType::King); ++t) {
+                uint64_t bb = pos.piece_bitboards[us][t];
+                while (bb) mover_type[pop_lsb(bb)] = static_cast<uint8_t>(t);
+            }
+        }
+        auto mover_at = [&](int sq) {
+            return batched ? PieceType(mover_type[sq]) : type_of(pos.at_sq64(sq));
+        };
+        // history_piece_row() for the side to move: White 1-6, Black 7-12.
+        const int history_row_base = pos.side_to_move == Color::Black ? 6 : 0;
+
         // Score all moves for ordering
         for (int i = 0; i < move_list.count; i++) {
             S_MOVE& move = move_list.moves[i];
             int score = 0;
             
             // VICE Part 84: TT move gets absolute highest priority (3,000,000) - but only if validated
-            if (tt_move_valid && move.move == static_cast<int>(tt_best_move)) {
+            if (move.move == tt_key) {
                 score = 3000000;
                 
             // VICE Part 64: PV move gets second highest priority (2,000,000)
-            } else if (has_pv_move && move.move == pv_move.move) {
+            } else if (move.move == pv_key) {
                 score = 2000000;
                 
             // IID move gets third highest priority (1,500,000) - between PV and captures
-            } else if (iid_move.move != 0 && move.move == iid_move.move) {
+            } else if (move.move == iid_key) {
                 score = 1500000;
                 
             } else if (move.is_capture()) {
                 // VICE Part 64: Captures get 1,000,000 + MVV-LVA score
                 PieceType victim = move.get_captured();
-                
-                // Get the attacking piece type from the position
-                int from_sq = move.get_from();
-                Piece attacking_piece = pos.at_sq64(from_sq);
-                PieceType attacker = type_of(attacking_piece);
+                PieceType attacker = mover_at(move.get_from());
                 
                 score = 1000000 + get_mvv_lva_score(victim, attacker);
 
@@ -1724,85 +1843,49 @@ int Engine::pick_next_move(S_MOVELIST& move_list, int move_num, const Position&
                 // promotion-captures are exempt like quiescence's SEE-prune
                 // exemption — never bury a promotion below quiets.
                 else if (depth >= 0 && !move.is_promotion() &&
-                         Huginn::see(pos, move) < 0) {
+                         !Huginn::see_ge(pos, move, 0)) {
                     score = -10000000 + get_mvv_lva_score(victim, attacker);
                 }
 #endif
 
-            } else {
-                // Check for killer moves (non-captures only)
-                bool is_killer = false;
-                if (depth >= 0 && depth < 64) {
-                    // VICE Part 64: First killer = 900,000, Second killer = 800,000
-                    if (search_killers[depth][0].move == move.move) {
-                        score = 900000;
-                        is_killer = true;
-                    } else if (search_killers[depth][1].move == move.move) {
-                        score = 800000;
-                        is_killer = true;
-                    }
-                }
-                
-                // Check for counter-move (if not a killer move)
-                bool is_counter_move = false;
-#if ENABLE_PLY_TRACKED_COUNTERMOVE
-                if (!is_killer && info.ply > 0 && info.ply < 64) {
-                    // Get the previous move from search stack
-                    S_MOVE previous_move = info.search_stack[info.ply - 1];
-                    if (previous_move.move != 0) {
-                        S_MOVE counter_move = get_counter_move(previous_move);
-                        if (counter_move.move == move.move) {
-                            // Slot just above the history range (~1K), below
-                            // promotions (25K-90K). BACKLOG #15: 1500 beat 15000
-                            // on t4 (+8.7 vs -10.4 Elo); re-testing 1500 on t7,
-                            // whose stronger ordering favors a gentler bonus.
-                            score = 1500;
-                            is_counter_move = true;
-                        }
-                    }
+            // VICE Part 64: First killer = 900,000, Second killer = 800,000
+            // (non-captures only).
+            } else if (move.move == killer1) {
+                score = 900000;
+            } else if (move.move == killer2) {
+                score = 800000;
+
+            // Counter-move: slot just above the history range (~1K), below
+            // promotions (25K-90K). BACKLOG #15: 1500 beat 15000 on t4
+            // (+8.7 vs -10.4 Elo); re-testing 1500 on t7, whose stronger
+            // ordering favors a gentler bonus.
+            } else if (move.move == counter_key) {
+                score = 1500;
+
+            } else if (move.is_promotion()) {
+                // Promotions: High priority, queen promotion highest
+                PieceType promoted = move.get_promoted();
+                switch (promoted) {
+                    case PieceType::Queen:  score = 90000; break;
+                    case PieceType::Rook:   score = 50000; break;
+                    case PieceType::Bishop: score = 33000; break;
+                    case PieceType::Knight: score = 32000; break;
+                    default: score = 25000; break;
                 }
-#endif
-                
-                if (!is_killer && !is_counter_move) {
-                    if (move.is_promotion()) {
-                        // Promotions: High priority, queen promotion highest
-                        PieceType promoted = move.get_promoted();
-                        switch (promoted) {
-                            case PieceType::Queen:  score = 90000; break;
-                            case PieceType::Rook:   score = 50000; break;
-                            case PieceType::Bishop: score = 33000; break;
-                            case PieceType::Knight: score = 32000; break;
-                            default: score = 25000; break;
-                        }
-                    } else {
-                        // VICE Part 64: History heuristic for remaining quiet moves
-                        int from = move.get_from();
-                        int to = move.get_to();
-                        
-                        if (from >= 0 && from < 64 && to >= 0 && to < 64) {
-                            Piece piece = pos.at_sq64(from);
-                            int piece_index = history_piece_row(piece);
-                            score = search_history[piece_index][to];  // History score
+            } else {
+                // VICE Part 64: History heuristic for remaining quiet moves.
+                // get_from()/get_to() are 7-bit fields but always sq64 for
+                // generated moves.
+                const int to = move.get_to();
+                const int piece_index = history_row_base + int(mover_at(move.get_from()));
+                score = search_history[piece_index][to];  // History score
 #if ENABLE_CONTINUATION_HISTORY
-                            // BACKLOG #3: blend 1-ply continuation history into
-                            // the quiet-move score (additive, same scale as
-                            // butterfly history). Only the parent (ply-1) move
-                            // conditions it; killers/counters/promotions above
-                            // keep their fixed scores. Weight is a tuning knob.
-                            if (info.ply > 0 && info.ply < 64) {
-                                S_MOVE prev = info.search_stack[info.ply - 1];
-                                int contrib = CONTHIST_ORDER_WEIGHT *
-                                              get_continuation_history(pos, prev, move);
-                                if (contrib > CONTHIST_ORDER_CAP) contrib = CONTHIST_ORDER_CAP;
-                                else if (contrib < -CONTHIST_ORDER_CAP) contrib = -CONTHIST_ORDER_CAP;
-                                score += contrib;
-                            }
-#endif
-                        } else {
-                            score = 1000;  // Base score for quiet moves
-                        }
-                    }
-                }
+                // user-032: add the 1- and 2-ply continuation scores.
+                // Gravity-bounded, so the sum stays inside the history
+                // band; killers/counters/promotions keep their fixed
+                // scores.
+                score += continuation_score(info, piece_index, to);
+#endif
             }
             
             move.score = score;
@@ -1819,7 +1902,7 @@ int Engine::pick_next_move(S_MOVELIST& move_list, int move_num, const Position&
     int best_score = -1;
 #endif
     int best_index = move_num;
-    
+
     for (int i = move_num; i < move_list.count; i++) {
         if (move_list.moves[i].score > best_score) {
             best_score = move_list.moves[i].score;
@@ -1853,12 +1936,21 @@ int Engine::evalPosition(const Position& pos) {
 }
 
 /// @brief Periodic search interrupt check: set the stop flag if the time budget
-///        is exceeded or a UCI `stop`/`quit` arrived on stdin. Called every few
-///        thousand nodes (not per node — it polls input).
+///        or node budget is exceeded or stop() was called (UCI `stop`/`quit`).
+///        Called every CHECKUP_INTERVAL nodes (not per node — it reads the clock).
 void Engine::checkup(SearchInfo& info) {
     // Check if we should stop due to time limit
     if (info.quit || info.stopped) return;
 
+    // user-045: schedule the next poll. The call sites used to test
+    // `(nodes & 2047) == 0`, which silently skipped a poll whenever that
+    // node returned before the test (TT cutoff, leaf) — a threshold cannot
+    // be skipped, and it lands the poll exactly on a `go nodes` budget.
+    info.next_checkup = info.nodes + CHECKUP_INTERVAL;
+    if (info.max_nodes > info.nodes && info.max_nodes < info.next_checkup) {
+        info.next_checkup = info.max_nodes;
+    }
+
     // #56: race-free cancellation — stop()/signal_stop() (possibly another
     // thread) raise the engine's atomic; it is translated into info.stopped
     // HERE, on the searching thread, so SearchInfo has a single writer.
@@ -1867,22 +1959,28 @@ void Engine::checkup(SearchInfo& info) {
         return;
     }
 
-    // VICE Part 70: Check for GUI input during search (3:23).
-    // The Windows console poll (GetNumberOfConsoleInputEvents / PeekConsoleInput)
-    // is ~5us — profiling a `go depth` run showed ~6% of total time spent here
-    // because checkup() fires every 2048 nodes. Time management needs that
-    // cadence (steady_clock is cheap), but catching a "stop"/"quit" keystroke
-    // does not, so the input poll is gated 16x coarser. INPUT_CHECK_MASK must be
-    // a multiple of checkup()'s 2048-node interval so it still lands on a call.
-    constexpr uint64_t INPUT_CHECK_MASK = 32767;  // poll stdin every ~32768 nodes
-    if ((info.nodes & INPUT_CHECK_MASK) == 0 && input_is_waiting()) {
-        // #56: the UCI layer installs a pump that answers `isready` without
-        // stopping, applies `stop`/`quit`, and queues other commands. Bare
-        // Engine use keeps read_input()'s any-input-stops fallback.
-        if (info.on_input) info.on_input(info);
-        else read_input(info);
+    // user-045: `go nodes N`. The poll is scheduled at N (above), so the
+    // overrun is only the nodes that returned before reaching a poll site —
+    // and identical on every run, which is what reproducible benchmarking
+    // needs.
+    if (info.max_nodes != 0 && info.nodes >= info.max_nodes) {
+        info.stopped = true;
+        return;
     }
 
+    // user-041: while pondering the clock belongs to the opponent — no time
+    // checks until `ponderhit`. From then on this is an ordinary timed
+    // search, and the time spent pondering counts against the budget
+    // (stop_time is measured from the `go ponder`).
+    if (info.ponder) {
+        if (!ponder_hit.load(std::memory_order_relaxed)) return;
+        info.ponder = false;
+    }
+
+    // VICE Part 70 checked for GUI input here. user-040: the search no longer
+    // looks at stdin at all — the UCI command loop runs on its own thread
+    // and reaches the search only through should_stop (above).
+
     // Skip time management if this is a depth-only search (UCI go depth command)
     if (info.depth_only) return;
     
@@ -1929,9 +2027,14 @@ void Engine::clearForSearch(Engine& engine, SearchInfo& info) {
     info.stopped = false;    // Set stop to zero (false)
     info.quit = false;       // Reset quit flag as well
     info.nodes = 0;          // Reset nodes count
+    // user-045: first poll after CHECKUP_INTERVAL nodes (or at the node
+    // budget); checkup() schedules the rest.
+    info.next_checkup = (info.max_nodes != 0) ? std::min(CHECKUP_INTERVAL, info.max_nodes) : CHECKUP_INTERVAL;
     
-    // Reset engine state for new search
-    engine.should_stop = false;     // Reset stop flag
+    // Reset engine state for new search. should_stop is deliberately left
+    // alone: the UCI layer clears it (Engine::reset) before posting the job
+    // to its worker, and a `stop` landing before the worker gets here must
+    // not be wiped (user-040).
     engine.nodes_searched = 0;      // Reset nodes count
 }
 
@@ -2044,6 +2147,16 @@ int Engine::AlphaBeta(Position& pos, int alpha, int beta, int depth, SearchInfo&
         }
     }
 
+#if ENABLE_UPCOMING_REPETITION
+    // user-035: the side to move can force a repetition — never worse than
+    // the draw it backs up (see the ENABLE_UPCOMING_REPETITION comment).
+    if (!isRoot && alpha < CONTEMPT && Cuckoo::upcoming_repetition(pos)) {
+        alpha = CONTEMPT;
+        info.upcoming_repetitions++;
+        if (alpha >= beta) return alpha;
+    }
+#endif
+
 #if ENABLE_MATE_DISTANCE_PRUNING
     // BACKLOG #43 sub-lever 3: mate-distance pruning. A mate found elsewhere in
     // the tree bounds what THIS node can return. Clamp the window to the mate
@@ -2108,18 +2221,46 @@ int Engine::AlphaBeta(Position& pos, int alpha, int beta, int depth, SearchInfo&
         }
     }
     
-    // Syzygy Tablebase Probe (BACKLOG #10 closure).
-    // Only probe at leaf nodes (depth <= 1). Do NOT store the result in TT:
-    // halfmove_clock is not part of the zobrist key, so the same key can be
-    // reached with different rule50 values, but TB scores are only valid
-    // for the rule50=0 case the safe wrapper requires. Caching a TB score
-    // pollutes the TT for any future visit to the same piece-placement at
-    // a different rule50 — measurable Elo loss in tournament play.
-    if (depth <= 1 && tablebase && tablebase->is_available()) {
+    // user-048: Huginn's own DTM tables. The score is exact, so any depth
+    // may take it; never at the root (searchPosition probes it there) nor in
+    // a singular-extension search, which must exclude a move. Not stored in
+    // the TT for the Syzygy reason below: it depends on the halfmove clock.
+    if (!isRoot && excluded_move == 0 && endgame_tables.is_loaded()) {
+        int egtb_score;
+        if (probe_endgame_tables(pos, info, egtb_score)) {
+            info.tbhits++;
+            return egtb_score;
+        }
+    }
+
+    // Syzygy Tablebase Probe (BACKLOG #10 closure; user-049 policy).
+    // Gated by should_probe_tablebase(): SyzygyProbeLimit / SyzygyProbeDepth,
+    // and only at rule50 == 0 without castling rights — the only positions
+    // the safe Fathom wrapper answers. A hit is stored at MAX_DEPTH, where
+    // every later visit takes the TT cutoff above instead of probing again:
+    // a win is a lower bound (the search may still find a mate), a loss an
+    // upper bound, a draw (cursed / blessed included) exact. A bound that
+    // does not cut here is dropped and the node searched normally.
+    // The Zobrist key does not include the halfmove clock, so the entry also
+    // answers later visits of the same position with rule50 > 0, where the
+    // true result may be a 50-move draw. Only rule50_tt_unsafe (under
+    // ENABLE_RULE50_TT_GUARD) limits that: it refuses the cutoff once
+    // halfmove_clock + depth reaches 100.
+    // The WDL probe yields no move; the entry keeps any TT move this node
+    // already had so move ordering still gets it on a bound that is searched
+    // through later.
+    if (!isRoot && excluded_move == 0 && should_probe_tablebase(pos, depth)) {
         int wdl_score;
         if (probe_tablebase_wdl(pos, wdl_score)) {
             info.tbhits++;  // standard UCI `tbhits`
-            return wdl_score;
+            const uint8_t bound = wdl_score > 1  ? TTEntry::LOWER_BOUND
+                                : wdl_score < -1 ? TTEntry::UPPER_BOUND
+                                                 : TTEntry::EXACT;
+            if (bound == TTEntry::EXACT
+                    || (bound == TTEntry::LOWER_BOUND ? wdl_score >= beta : wdl_score <= alpha)) {
+                tt_table.store(pos.zobrist_key, wdl_score, MAX_DEPTH, bound, tt_hit ? tt_best_move : 0);
+                return wdl_score;
+            }
         }
     }
     
@@ -2141,7 +2282,7 @@ int Engine::AlphaBeta(Position& pos, int alpha, int beta, int depth, SearchInfo&
     }
     
     // Periodically check time and node limits
-    if ((info.nodes & 2047) == 0) {  // Check every 2048 nodes
+    if (info.nodes >= info.next_checkup) {  // every CHECKUP_INTERVAL nodes (user-045)
         checkup(info);
     }
     
@@ -2212,6 +2353,9 @@ int Engine::AlphaBeta(Position& pos, int alpha, int beta, int depth, SearchInfo&
         // (previous_move.move != 0) skips lookup over a null parent move.
         if (info.ply >= 0 && info.ply < 64) {
             info.search_stack[info.ply] = S_MOVE();
+#if ENABLE_CONTINUATION_HISTORY
+            info.cont_hist[info.ply] = nullptr;
+#endif
         }
 
         // Search with reduced depth and narrow window around beta
@@ -2266,6 +2410,70 @@ int Engine::AlphaBeta(Position& pos, int alpha, int beta, int depth, SearchInfo&
         }
     }
 
+#if ENABLE_PROBCUT
+    // user-038: ProbCut (see the ENABLE_PROBCUT comment at the top). After
+    // null move, like it a non-PV, not-in-check, non-mate-window node only.
+    {
+        const int PROBCUT_MIN_DEPTH = 5;
+        const int PROBCUT_REDUCTION = 4;
+        const int PROBCUT_MARGIN = 100;
+        const int probcut_beta = beta + PROBCUT_MARGIN;
+        const int probcut_depth = depth - PROBCUT_REDUCTION;
+        if (!isRoot && !in_check && beta - alpha == 1 && excluded_move == 0 &&
+            depth >= PROBCUT_MIN_DEPTH &&
+            beta > -(MATE - 1000) && probcut_beta < MATE - 1000 &&
+            // A TT score from a search at least this deep says the reduced
+            // search would not reach probcut_beta — don't spend it.
+            !(tt_hit && int(tt_depth) >= probcut_depth && tt_score < probcut_beta)) {
+            S_MOVELIST probcut_moves;
+            generate_all_caps_pseudo(pos, probcut_moves);
+            const int see_threshold = probcut_beta - get_static_eval();
+            for (int i = 0; i < probcut_moves.count; ++i) {
+                pick_next_move(probcut_moves, i, pos, info, -1, S_MOVE{}, tt_hit ? tt_best_move : 0u);
+                const S_MOVE move = probcut_moves.moves[i];
+                if (!Huginn::see_ge(pos, move, see_threshold)) continue;
+
+                if (pos.MakeMove(move) != 1) {
+                    assert_search_position_integrity(pos, "after illegal ProbCut MakeMove rollback");
+                    continue;
+                }
+                assert_search_position_integrity(pos, "after ProbCut MakeMove");
+                if (info.ply >= 0 && info.ply < 64) {
+                    info.search_stack[info.ply] = move;
+                }
+#if ENABLE_CONTINUATION_HISTORY
+                set_continuation_context(info, pos, move);
+#endif
+                ++info.ply;
+                const auto child = capture_search_position(pos);
+                // Quiescence first: a capture that does not even hold there
+                // is not worth the reduced search.
+                int score = -quiescence(pos, -probcut_beta, -probcut_beta + 1, info);
+                if (score >= probcut_beta && probcut_depth > 0) {
+                    score = -AlphaBeta(pos, -probcut_beta, -probcut_beta + 1, probcut_depth, info, true, false);
+                }
+                assert_search_position_unchanged(pos, child, "after ProbCut child search");
+                --info.ply;
+                pos.TakeMove();
+                assert_search_position_integrity(pos, "after ProbCut TakeMove");
+
+                if (info.stopped || info.quit) return 0;
+
+                if (score >= probcut_beta) {
+                    info.probcut_cuts++;
+#if ENABLE_RULE50_TT_GUARD
+                    if (int(pos.halfmove_clock) + probcut_depth + 1 < 100)
+#endif
+                    {
+                        tt_table.store(pos.zobrist_key, beta, probcut_depth + 1, TTEntry::LOWER_BOUND, move.move);
+                    }
+                    return beta;
+                }
+            }
+        }
+    }
+#endif
+
     // Futility Pruning (Forward Pruning at Pre-Frontier Nodes)
     // Skip move search if position evaluation + safety margin is still <= alpha
     // This is safe because even the best possible move won't improve alpha enough
@@ -2364,12 +2572,42 @@ int Engine::AlphaBeta(Position& pos, int alpha, int beta, int depth, SearchInfo&
     // Generate pseudo-legal moves; legality is checked per-move via MakeMove
     // below, and mate/stalemate is detected after the loop via legal_count.
     S_MOVELIST move_list;
+#if ENABLE_TT_MOVE_FIRST
+    // user-037: a TT move that passes is_pseudo_legal() is searched from a
+    // one-entry list; generation is deferred until it fails to cut. Not in an
+    // exclusion search, where the TT move is the one being skipped.
+    bool deferred_generation = false;
+    if (tt_hit && tt_best_move != 0 && tt_best_move != excluded_move) {
+        S_MOVE tt_move;
+        tt_move.move = static_cast<int>(tt_best_move);
+        tt_move.score = 0;
+        if (pos.is_pseudo_legal(tt_move)) {
+            move_list.count = 1;
+            move_list.moves[0] = tt_move;
+            deferred_generation = true;
+        }
+    }
+    if (!deferred_generation) generate_all_moves(pos, move_list);
+#else
     generate_all_moves(pos, move_list);
+#endif
 
     // Internal Iterative Deepening for PV nodes without hash move
     S_MOVE iid_move;
     iid_move.move = 0;
     
+#if ENABLE_IIR
+    // user-034: internal iterative reduction — no TT move to order by, so
+    // search this node one ply shallower instead of running a nested IID
+    // search to manufacture one (see the ENABLE_IIR comment at the top).
+    {
+        const int IIR_MIN_DEPTH = 4;  // same floor as IID's MIN_IID_DEPTH
+        if (!isRoot && depth >= IIR_MIN_DEPTH && !(tt_hit && tt_best_move != 0)) {
+            depth--;
+            info.iir_reductions++;
+        }
+    }
+#else
     // Check if we should perform IID (PV node without hash move)
     if (!isRoot && !tt_hit && depth >= 4) {
         // Likely PV node with full alpha-beta window and no hash move
@@ -2378,6 +2616,7 @@ int Engine::AlphaBeta(Position& pos, int alpha, int beta, int depth, SearchInfo&
             iid_move = internal_iterative_deepening(pos, alpha, beta, depth, info);
         }
     }
+#endif
     
     int best_score = -30000;
     S_MOVE best_move;  // Track best move for transposition table storage
@@ -2395,7 +2634,28 @@ int Engine::AlphaBeta(Position& pos, int alpha, int beta, int depth, SearchInfo&
     const int original_alpha = alpha;
 
     // Try each move
+#if ENABLE_TT_MOVE_FIRST
+    for (int i = 0; i < move_list.count || deferred_generation; ++i) {
+        if (deferred_generation && i == 1) {
+            // user-037: the TT move (slot 0) did not cut — generate the rest.
+            // It is in the list (is_pseudo_legal matches the generator); swap
+            // it back into slot 0 and rescore, so the loop resumes at slot 1.
+            deferred_generation = false;
+            const int searched = move_list.moves[0].move;
+            generate_all_moves(pos, move_list);
+            for (int k = 0; k < move_list.count; ++k) {
+                if (move_list.moves[k].move == searched) {
+                    std::swap(move_list.moves[0], move_list.moves[k]);
+                    break;
+                }
+            }
+            assert(move_list.count > 0 && move_list.moves[0].move == searched);
+            if (move_list.count <= 1) break;
+            pick_next_move(move_list, 0, pos, info, depth, iid_move, tt_best_move);
+        }
+#else
     for (int i = 0; i < move_list.count; ++i) {
+#endif
         // VICE Part 62: Pick best move from remaining moves. BACKLOG #48: the
         // ordering TT move is the one from the node-entry probe above — no re-probe.
         pick_next_move(move_list, i, pos, info, depth, iid_move, tt_hit ? tt_best_move : 0u);
@@ -2446,6 +2706,9 @@ int Engine::AlphaBeta(Position& pos, int alpha, int beta, int depth, SearchInfo&
         if (info.ply >= 0 && info.ply < 64) {
             info.search_stack[info.ply] = move_list.moves[i];
         }
+#if ENABLE_CONTINUATION_HISTORY
+        set_continuation_context(info, pos, move_list.moves[i]);
+#endif
 
 #if ENABLE_LEGAL_MOVE_ORDINAL
         // BACKLOG #57: 0-based ordinal among moves actually searched (legal
@@ -2536,8 +2799,16 @@ int Engine::AlphaBeta(Position& pos, int alpha, int beta, int depth, SearchInfo&
             {
                 const int HISTORY_LMR_GRAIN = 4096;
                 const int to = move_list.moves[i].get_to();
-                const int hist =
-                    search_history[history_piece_row(pos.at_sq64(to))][to];
+                const int piece_row = history_piece_row(pos.at_sq64(to));
+#if ENABLE_CONTINUATION_HISTORY
+                // user-032: judge the quiet by butterfly + continuation
+                // history together. info.ply is still this node's ply, so
+                // the contexts are the moves that led here.
+                const int hist = search_history[piece_row][to] +
+                                 continuation_score(info, piece_row, to);
+#else
+                const int hist = search_history[piece_row][to];
+#endif
                 if (hist >= HISTORY_LMR_GRAIN) {
                     --reduction;
                     info.history_lmr_adjusts++;
@@ -2639,14 +2910,12 @@ int Engine::AlphaBeta(Position& pos, int alpha, int beta, int depth, SearchInfo&
                 if (!move_list.moves[i].is_capture()) {
                     update_search_history(pos, move_list.moves[i], depth);
 #if ENABLE_CONTINUATION_HISTORY
-                    // BACKLOG #3: mirror butterfly history's +depth^2 bonus on
-                    // the parent-conditioned conthist table. pos is at the
-                    // current node here (TakeMove already ran), so prev's piece
-                    // sits on prev.get_to() as the helper expects.
-                    if (info.ply > 0 && info.ply < 64) {
-                        S_MOVE prev = info.search_stack[info.ply - 1];
-                        update_continuation_history(pos, prev, move_list.moves[i], depth * depth);
-                    }
+                    // user-032: reward both continuation contexts. pos is at
+                    // the current node (TakeMove already ran), so the mover is
+                    // back on its from-square.
+                    update_continuation_history(
+                        info, history_piece_row(pos.at_sq64(move_list.moves[i].get_from())),
+                        move_list.moves[i].get_to(), 32 * depth * depth);
 #endif
                 }
 
@@ -2678,11 +2947,10 @@ int Engine::AlphaBeta(Position& pos, int alpha, int beta, int depth, SearchInfo&
             if (!move_list.moves[i].is_capture() && depth > 0) {
                 penalize_search_history(pos, move_list.moves[i], depth);
 #if ENABLE_CONTINUATION_HISTORY
-                // BACKLOG #3: mirror butterfly history's -depth^2 penalty on conthist.
-                if (info.ply > 0 && info.ply < 64) {
-                    S_MOVE prev = info.search_stack[info.ply - 1];
-                    update_continuation_history(pos, prev, move_list.moves[i], -depth * depth);
-                }
+                // user-032: mirror butterfly history's penalty on both contexts.
+                update_continuation_history(
+                    info, history_piece_row(pos.at_sq64(move_list.moves[i].get_from())),
+                    move_list.moves[i].get_to(), -32 * depth * depth);
 #endif
             }
         }
@@ -2818,6 +3086,9 @@ S_MOVE Engine::internal_iterative_deepening(Position& pos, int alpha, int beta,
             if (info.ply >= 0 && info.ply < 64) {
                 info.search_stack[info.ply] = iid_move_list.moves[i];
             }
+#if ENABLE_CONTINUATION_HISTORY
+            set_continuation_context(info, pos, iid_move_list.moves[i]);
+#endif
 
             ++info.ply;
             const auto child = capture_search_position(pos);
@@ -2895,7 +3166,7 @@ int Engine::quiescence(Position& pos, int alpha, int beta, SearchInfo& info, int
     info.nodes++;
 
     // Periodically check time
-    if ((info.nodes & 2047) == 0) {
+    if (info.nodes >= info.next_checkup) {
         checkup(info);
     }
 
@@ -2903,6 +3174,57 @@ int Engine::quiescence(Position& pos, int alpha, int beta, SearchInfo& info, int
         return 0;
     }
 
+#if ENABLE_QSEARCH_TT
+    // user-033: entry probe — one probe serves both the bound cutoff and the
+    // ordering move (previously probed further down for the move only).
+#if ENABLE_RULE50_TT_GUARD
+    // BACKLOG #53 with depth 0: AlphaBeta's halfmove_clock + depth >= 100.
+    const bool q_rule50_tt_unsafe = (int(pos.halfmove_clock) >= 100);
+#else
+    constexpr bool q_rule50_tt_unsafe = false;
+#endif
+    const int q_original_alpha = alpha;
+    uint32_t q_tt_move = 0;
+    bool q_tt_deep = false;   // a main-search entry lives here: don't downgrade it
+    {
+        int tt_score;
+        uint8_t tt_depth, tt_node_type;
+        uint32_t tt_best_move;
+        if (tt_table.probe(pos.zobrist_key, tt_score, tt_depth, tt_node_type, tt_best_move)) {
+            q_tt_move = tt_best_move;
+            q_tt_deep = tt_depth > 0;
+            if (!q_rule50_tt_unsafe) {
+#if ENABLE_PLY_TRACKED_TT_MATE
+                if (tt_score > MATE - 1000) {
+                    tt_score -= info.ply;
+                } else if (tt_score < -MATE + 1000) {
+                    tt_score += info.ply;
+                }
+#endif
+                if (tt_node_type == TTEntry::EXACT) {
+                    return tt_score;
+                } else if (tt_node_type == TTEntry::LOWER_BOUND && tt_score >= beta) {
+                    return beta;
+                } else if (tt_node_type == TTEntry::UPPER_BOUND && tt_score <= alpha) {
+                    return alpha;
+                }
+            }
+        }
+    }
+    // Depth-0 store of this node's result (see the ENABLE_QSEARCH_TT comment).
+    auto q_tt_store = [&](int score, uint8_t node_type, uint32_t move) {
+        if (q_rule50_tt_unsafe || q_tt_deep) return;
+#if ENABLE_PLY_TRACKED_TT_MATE
+        if (score > MATE - 1000) {
+            score = std::min(score + info.ply, MATE - 1);
+        } else if (score < -MATE + 1000) {
+            score = std::max(score - info.ply, -(MATE - 1));
+        }
+#endif
+        tt_table.store(pos.zobrist_key, score, 0, node_type, move);
+    };
+#endif
+
 #if ENABLE_QSEARCH_CHECK_EVASIONS
     // BACKLOG #52: report the true selective depth. info.ply advances through
     // the qsearch recursion (below), so seldepth now extends past the
@@ -2919,6 +3241,10 @@ int Engine::quiescence(Position& pos, int alpha, int beta, SearchInfo& info, int
 
         // Beta cutoff on stand pat
         if (stand_pat >= beta) {
+#if ENABLE_QSEARCH_TT
+            // The static eval itself is a valid lower bound on this node.
+            q_tt_store(stand_pat, TTEntry::LOWER_BOUND, q_tt_move);
+#endif
             return beta;
         }
 
@@ -2945,6 +3271,7 @@ int Engine::quiescence(Position& pos, int alpha, int beta, SearchInfo& info, int
     generate_all_caps_pseudo(pos, move_list);
 #endif
 
+#if !ENABLE_QSEARCH_TT
     // BACKLOG #48: quiescence has no node-entry TT probe, so probe once here
     // for the ordering move (pick_next_move no longer re-probes internally).
     // Same single probe per node as before — just hoisted out of the picker.
@@ -2957,6 +3284,10 @@ int Engine::quiescence(Position& pos, int alpha, int beta, SearchInfo& info, int
             q_tt_move = tt_best_move;
         }
     }
+#endif
+#if ENABLE_QSEARCH_TT
+    uint32_t q_best_move = q_tt_move;  // stored with the result; TT move if nothing raised alpha
+#endif
 
     // Search all frontier moves (captures; in check, every evasion)
 #if ENABLE_QSEARCH_CHECK_EVASIONS
@@ -2995,7 +3326,7 @@ int Engine::quiescence(Position& pos, int alpha, int beta, SearchInfo& info, int
             // from promotion can flip a "bad" capture into a sound one. King
             // captures are never SEE-pruned (king is the most valuable, so
             // SEE wouldn't classify them as losing anyway, but be explicit).
-            if (!move.is_promotion() && Huginn::see(pos, move) < 0) {
+            if (!move.is_promotion() && !Huginn::see_ge(pos, move, 0)) {
                 continue;
             }
         }
@@ -3028,11 +3359,17 @@ int Engine::quiescence(Position& pos, int alpha, int beta, SearchInfo& info, int
         }
 
         if (score >= beta) {
+#if ENABLE_QSEARCH_TT
+            q_tt_store(beta, TTEntry::LOWER_BOUND, static_cast<uint32_t>(move.move));
+#endif
             return beta; // Beta cutoff
         }
 
         if (score > alpha) {
             alpha = score;
+#if ENABLE_QSEARCH_TT
+            q_best_move = static_cast<uint32_t>(move.move);
+#endif
         }
     }
 
@@ -3041,13 +3378,128 @@ int Engine::quiescence(Position& pos, int alpha, int beta, SearchInfo& info, int
     // Same MATE - ply encoding as AlphaBeta's mate leaf. (In check with no
     // legal move is always mate, never stalemate.)
     if (q_in_check && legal_moves == 0 && !info.stopped && !info.quit) {
+#if ENABLE_QSEARCH_TT
+        q_tt_store(-MATE + info.ply, TTEntry::EXACT, 0);
+#endif
         return -MATE + info.ply;
     }
 #endif
 
+#if ENABLE_QSEARCH_TT
+    q_tt_store(alpha, alpha > q_original_alpha ? TTEntry::EXACT : TTEntry::UPPER_BOUND, q_best_move);
+#endif
     return alpha;
 }
 
+/**
+ * @brief Build the PV to display for one root line into @p out (at most
+ *        @p pv_cap moves); returns its length.
+ *
+ * Takes the triangular PV as the prefix, then extends by walking the
+ * transposition table. When a root move bottoms out via a TT cutoff, the
+ * child never populates its own pv_line and the triangular array truncates to
+ * length 1 — but the deeper line still lives in the TT, so pull it out for the
+ * GUI. Repetition / rule-50 truncation runs across both phases: the
+ * *displayed* PV stops at the first position that revisits a prior game
+ * position or reaches the fifty-move draw horizon (GUI validators reject
+ * tails that continue after either terminal condition). One make/unmake walk
+ * per line per depth, not per node. user-044: factored out of searchPosition
+ * so every MultiPV line gets the same walk.
+ */
+int Engine::build_display_pv(Position& pos, const S_MOVE* tri_pv, int tri_len,
+                             int pv_cap, S_MOVE* out) {
+    int pv_moves = 0;
+    // Seen-set baseline: only the actual game-history positions
+    // (move_history[0..pos.ply-1]). The full move_history vector
+    // grows during search and retains stale zobrist keys from the
+    // last move sequence each alpha-beta iteration happened to
+    // try (TakeMove decrements pos.ply but doesn't clear the slot).
+    // Iterating the full vector poisoned the seen-set with stale
+    // keys from the search interior — when one of them collided
+    // with a position our walk visited (e.g. position-after-e2e4
+    // after the search's final tried sequence ran through e2e4),
+    // the walk aborted at one move. pos.ply is the game ply at
+    // root emission, so this gives the correct rep-detection
+    // baseline without false positives.
+    std::unordered_set<uint64_t> seen;
+    seen.reserve(static_cast<size_t>(pos.ply) + static_cast<size_t>(pv_cap));
+    for (int i = 0; i < pos.ply; ++i) {
+        const uint64_t k = pos.move_history[i].zobrist_key;
+        if (k != 0) seen.insert(k);
+    }
+    seen.insert(pos.zobrist_key);
+
+    int made = 0;
+    bool stop = false;
+
+    // Phase 1 — triangular PV prefix (search-truth, definitely legal).
+    for (int i = 0; i < tri_len && pv_moves < pv_cap; ++i) {
+        if (pos.MakeMove(tri_pv[i]) != 1) {
+            assert_search_position_integrity(pos, "after illegal PV-prefix MakeMove rollback");
+            stop = true;
+            break;
+        }
+        assert_search_position_integrity(pos, "after PV-prefix MakeMove");
+        ++made;
+        out[pv_moves++] = tri_pv[i];
+        if (pos.halfmove_clock >= 100) {
+            stop = true;  // keep the draw-creating move, drop the tail
+            break;
+        }
+        if (!seen.insert(pos.zobrist_key).second) {
+            stop = true;  // keep the rep-creating move, drop the tail
+            break;
+        }
+    }
+
+    // Phase 2 — extend via TT walk. Same collision filter the main
+    // search uses (search.cpp:853-868): sanity-check the raw best_move
+    // before calling MakeMove, since a TT collision can hand back a
+    // move whose from-square is empty or wrong-coloured in the current
+    // position. MakeMove != 1 then catches king-in-check cases.
+    while (!stop && pv_moves < pv_cap) {
+        int tt_score;
+        uint8_t tt_depth, tt_type;
+        uint32_t tt_move_raw;
+        if (!tt_table.probe(pos.zobrist_key, tt_score, tt_depth, tt_type, tt_move_raw)) break;
+        if (tt_move_raw == 0) break;
+
+        S_MOVE tt_move;
+        tt_move.move = static_cast<int>(tt_move_raw);
+        tt_move.score = 0;
+
+        const int from = tt_move.get_from();
+        const int to = tt_move.get_to();
+        if (from < 0 || from >= 64 || to < 0 || to >= 64) break;
+
+        // BACKLOG #36: validate the raw TT move against this position
+        // before applying it. A hash collision can hand back a move
+        // that belongs to a *different* position but happens to have a
+        // correctly-coloured from-square — the old check trusted that
+        // and let a bogus move into the displayed PV. Requiring a
+        // pseudo-legal encoding (then MakeMove for king safety) makes
+        // every displayed move genuinely legal. user-037: checked with
+        // is_pseudo_legal() instead of generating the list per PV ply.
+        if (!pos.is_pseudo_legal(tt_move)) break;
+
+        if (pos.MakeMove(tt_move) != 1) {
+            assert_search_position_integrity(pos, "after illegal PV TT-walk MakeMove rollback");
+            break;
+        }
+        assert_search_position_integrity(pos, "after PV TT-walk MakeMove");
+        ++made;
+        out[pv_moves++] = tt_move;
+        if (pos.halfmove_clock >= 100) break;  // fifty-move rule
+        if (!seen.insert(pos.zobrist_key).second) break;  // rep
+    }
+
+    for (int i = 0; i < made; ++i) {
+        pos.TakeMove();
+        assert_search_position_integrity(pos, "after PV display TakeMove");
+    }
+    return pv_moves;
+}
+
 /**
  * @brief Root search driver — iterative deepening + time management + UCI output.
  *
@@ -3065,8 +3517,10 @@ S_MOVE Engine::searchPosition(Position& pos, SearchInfo& info) {
     S_MOVE best_move;
     best_move.move = 0;
     
-    // VICE Part 85: Check opening book first
-    if (opening_book.is_book_loaded() && opening_book.has_book_moves(pos)) {
+    // VICE Part 85: Check opening book first. user-045: not when the GUI
+    // restricted the root with `searchmoves` (nor the TB probe below) — the
+    // returned move could be outside the set.
+    if (info.searchmoves.empty() && opening_book.is_book_loaded() && opening_book.has_book_moves(pos)) {
         S_MOVE book_move = opening_book.get_book_move(pos);
         if (book_move.move != 0) {
             // CRITICAL: Validate that the book move is actually legal in current position
@@ -3083,25 +3537,52 @@ S_MOVE Engine::searchPosition(Position& pos, SearchInfo& info) {
             }
             
             if (book_move_is_legal) {
-                std::cout << "info string Found book move: " << move_to_uci(book_move) << std::endl;
+                *info_out << "info string Found book move: " << move_to_uci(book_move) << std::endl;
                 return book_move;
             } else {
-                std::cout << "info string Book move " << move_to_uci(book_move) << " is illegal, ignoring" << std::endl;
+                *info_out << "info string Book move " << move_to_uci(book_move) << " is illegal, ignoring" << std::endl;
             }
         }
     }
     
     // Syzygy Tablebase Root Probe - Check for perfect endgame move
-    if (tablebase && tablebase->is_available()) {
+    if (info.searchmoves.empty() && tablebase && tablebase->is_available()) {
         S_MOVE tablebase_move = probe_tablebase_root(pos);
         if (tablebase_move.move != 0) {
-            std::cout << "info string Found tablebase move: " << move_to_uci(tablebase_move) << std::endl;
+            *info_out << "info string Found tablebase move: " << move_to_uci(tablebase_move) << std::endl;
             return tablebase_move;
         }
     }
     
+    // user-048: a decisive DTM result at the root is the move to play, mate
+    // distance and all. Draws are searched: the tables see every drawing
+    // move as equal, the search can still pick the one that sets problems.
+    if (info.searchmoves.empty() && endgame_tables.is_loaded()) {
+        EgtbResult result;
+        S_MOVE egtb_move = endgame_tables.probe_root(pos, result);
+        if (egtb_move.move != 0 && result.wdl != 0 && pos.halfmove_clock + result.dtm <= 100) {
+            const int mate_moves = (result.wdl > 0) ? (result.dtm + 1) / 2 : -(result.dtm / 2);
+            *info_out << "info depth 1 score mate " << mate_moves << " nodes 0 tbhits 1 pv "
+                      << move_to_uci(egtb_move) << std::endl;
+            *info_out << "info string Found endgame table move: " << move_to_uci(egtb_move) << std::endl;
+            return egtb_move;
+        }
+    }
+
     // VICE Part 57: Clear everything before starting search
     clearForSearch(*this, info);
+    info_throttle.reset();
+
+    // user-044: MultiPV. Each iteration searches the best `multi_pv` root
+    // lines one after another: line k re-runs the root loop with lines
+    // 0..k-1 excluded, so its best score is the k-th best root move. All
+    // lines share the TT, history and killers, so later lines mostly re-read
+    // subtrees line 0 already searched. multi_pv == 1 is the old search.
+    const int multi_pv = std::clamp(info.multi_pv, 1, MAX_MULTI_PV);
+    root_lines.resize(static_cast<size_t>(multi_pv));
+    info_lines.resize(static_cast<size_t>(multi_pv));
+    for (RootLine& line : root_lines) line.move.move = 0;
+    int lines_held = 0;   // info_lines[0..lines_held) still to print (throttled)
     
     // Set up search parameters
     info.start_time = std::chrono::steady_clock::now();
@@ -3110,7 +3591,8 @@ S_MOVE Engine::searchPosition(Position& pos, SearchInfo& info) {
 #if ENABLE_ASPIRATION
     // #17-r2: centre of the next iteration's aspiration window — the score
     // from the last completed depth (used from ASPIRATION_MIN_DEPTH on).
-    int prev_score = 0;
+    // user-044: one centre per MultiPV line.
+    int prev_scores[MAX_MULTI_PV] = {};
 #endif
 
     // Iterative deepening loop (0:22) - search depth 1, then 2, then 3, etc.
@@ -3135,7 +3617,8 @@ S_MOVE Engine::searchPosition(Position& pos, SearchInfo& info) {
         // while elapsed < budget/2 (i.e. 2*elapsed < budget). (#47: the old gate
         // assumed next≈3x elapsed and bailed at budget/4, leaving ~75% of the
         // clock unused — Huginn finished games with minutes to spare.)
-        if (current_depth > 1 && !info.infinite && !info.depth_only
+        if (info.ponder && ponder_hit.load(std::memory_order_relaxed)) info.ponder = false;
+        if (current_depth > 1 && !info.infinite && !info.depth_only && !info.ponder
                 && info.stop_time != std::chrono::steady_clock::time_point{}) {
             auto now = std::chrono::steady_clock::now();
             auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - info.start_time).count();
@@ -3161,13 +3644,21 @@ S_MOVE Engine::searchPosition(Position& pos, SearchInfo& info) {
         S_MOVELIST move_list;
         generate_all_moves(pos, move_list);
 
-        if (move_list.count == 0) break; // No pseudo-legal moves at all
+        // user-045: `go searchmoves` — drop every root move not listed.
+        if (!info.searchmoves.empty()) {
+            int kept = 0;
+            for (int i = 0; i < move_list.count; ++i) {
+                for (const S_MOVE& allowed : info.searchmoves) {
+                    if (allowed.move == move_list.moves[i].move) {
+                        move_list.moves[kept++] = move_list.moves[i];
+                        break;
+                    }
+                }
+            }
+            move_list.count = kept;
+        }
 
-        int best_score = -30000;
-        S_MOVE depth_best_move;
-        depth_best_move.move = 0;
-        int legal_count = 0;
-        info.pv_length[0] = 0;  // reset root PV for this iteration
+        if (move_list.count == 0) break; // No pseudo-legal moves at all
 
         // Order moves to try previous iteration's best move first for better alpha-beta cutoffs
         if (prev_best.move != 0) {
@@ -3182,39 +3673,163 @@ S_MOVE Engine::searchPosition(Position& pos, SearchInfo& info) {
             }
         }
 
-#if ENABLE_ASPIRATION
-        // #17-r2: aspiration windows. From ASPIRATION_MIN_DEPTH on, search a
-        // narrow window centred on the previous depth's score — the deep
-        // iterations that dominate total cost then run with far more cutoffs.
-        // On a fail (best <= alpha fail-low / best >= beta fail-high) widen the
-        // failed side geometrically (x2) and re-run the root loop; snap to the
-        // full window once delta outgrows ASPIRATION_MAX_DELTA. Mate-range
-        // centres skip the window entirely (mate scores move by ply, not cp).
-        constexpr int ASPIRATION_MIN_DEPTH  = 6;    // measured on t31: >50cp swings persist through d5
-        constexpr int ASPIRATION_DELTA      = 50;   // initial half-width (startpos <=9cp, Kiwipete <=31cp from d6)
-        constexpr int ASPIRATION_MAX_DELTA  = 800;  // escape hatch: stop nibbling, open full
-        constexpr int ASPIRATION_MATE_BOUND = 27000; // below the TB clamp (28000) and mate range
-
-        const bool use_window =
-            current_depth >= ASPIRATION_MIN_DEPTH &&
-            prev_score > -ASPIRATION_MATE_BOUND && prev_score < ASPIRATION_MATE_BOUND;
-        int delta = ASPIRATION_DELTA;
-        int alpha = use_window ? std::max(prev_score - delta, -30000) : -30000;
-        int beta  = use_window ? std::min(prev_score + delta,  30000) :  30000;
-
-        while (true) {
-            best_score = -30000;
+        // user-044: lines finished this iteration; root_lines[k] still holds
+        // the previous iteration's line k until line k completes again.
+        int lines_done = 0;
+        bool no_legal_moves = false;
+        for (int pv_idx = 0; pv_idx < multi_pv; ++pv_idx) {
+            // Line k > 0 tries last iteration's line-k move first, the way
+            // line 0 tries prev_best.
+            if (pv_idx > 0 && root_lines[pv_idx].move.move != 0) {
+                for (int i = 0; i < move_list.count; ++i) {
+                    if (move_list.moves[i].move == root_lines[pv_idx].move.move) {
+                        std::swap(move_list.moves[0], move_list.moves[i]);
+                        break;
+                    }
+                }
+            }
+
+            int best_score = -30000;
+            S_MOVE depth_best_move;
             depth_best_move.move = 0;
-            legal_count = 0;
-            info.pv_length[0] = 0;  // reset root PV for this (re-)search pass
+            int legal_count = 0;
+            info.pv_length[0] = 0;  // reset root PV for this line
+
+#if ENABLE_ASPIRATION
+            // #17-r2: aspiration windows. From ASPIRATION_MIN_DEPTH on, search a
+            // narrow window centred on the previous depth's score — the deep
+            // iterations that dominate total cost then run with far more cutoffs.
+            // On a fail (best <= alpha fail-low / best >= beta fail-high) widen the
+            // failed side geometrically (x2) and re-run the root loop; snap to the
+            // full window once delta outgrows ASPIRATION_MAX_DELTA. Mate-range
+            // centres skip the window entirely (mate scores move by ply, not cp).
+            constexpr int ASPIRATION_MIN_DEPTH  = 6;    // measured on t31: >50cp swings persist through d5
+            constexpr int ASPIRATION_DELTA      = 50;   // initial half-width (startpos <=9cp, Kiwipete <=31cp from d6)
+            constexpr int ASPIRATION_MAX_DELTA  = 800;  // escape hatch: stop nibbling, open full
+            constexpr int ASPIRATION_MATE_BOUND = 27000; // below the TB clamp (28000) and mate range
+
+            const int prev_score = prev_scores[pv_idx];
+            const bool use_window =
+                current_depth >= ASPIRATION_MIN_DEPTH &&
+                prev_score > -ASPIRATION_MATE_BOUND && prev_score < ASPIRATION_MATE_BOUND;
+            int delta = ASPIRATION_DELTA;
+            int alpha = use_window ? std::max(prev_score - delta, -30000) : -30000;
+            int beta  = use_window ? std::min(prev_score + delta,  30000) :  30000;
+            // user-044: line k normally scores at most line k-1 (its moves
+            // were all candidates there), so cap beta just above it; a fail
+            // high past the cap widens like any other.
+            if (use_window && pv_idx > 0) {
+                beta = std::max(std::min(beta, root_lines[pv_idx - 1].score + 1), alpha + 1);
+            }
 
-            // PVS-style alpha tightening within the window: local_alpha rises
-            // as root moves improve it, so sibling subtrees cut against the
-            // best score found so far instead of the window floor.
-            int local_alpha = alpha;
+            while (true) {
+                best_score = -30000;
+                depth_best_move.move = 0;
+                legal_count = 0;
+                info.pv_length[0] = 0;  // reset root PV for this (re-)search pass
+
+                // PVS-style alpha tightening within the window: local_alpha rises
+                // as root moves improve it, so sibling subtrees cut against the
+                // best score found so far instead of the window floor.
+                int local_alpha = alpha;
+
+                for (int i = 0; i < move_list.count; ++i) {
+                    if (info.stopped || info.quit) break;
+                    if (pv_idx > 0 && is_earlier_root_line(move_list.moves[i], pv_idx)) continue;
+
+                    if (pos.MakeMove(move_list.moves[i]) != 1) {
+                        assert_search_position_integrity(pos, "after illegal root MakeMove rollback");
+                        continue; // Skip illegal moves
+                    }
+                    assert_search_position_integrity(pos, "after root MakeMove");
+                    ++legal_count;
+                    report_currmove(info, current_depth, move_list.moves[i], legal_count);
+#if ENABLE_ROOT_TWOFOLD_AVOID
+                    // BACKLOG #44 follow-up: same gate as the baseline arm — see
+                    // the flag-off loop below for the full rationale.
+                    const bool immediate_repetition =
+                        (repetition_count_in_history(pos) >= 2);
+#else
+                    const bool immediate_repetition = isRepetition(pos);
+#endif
+
+                    // Track move in search stack for counter-move heuristic.
+                    // info.ply is 0 at root; this writes search_stack[0].
+                    if (info.ply >= 0 && info.ply < 64) {
+                        info.search_stack[info.ply] = move_list.moves[i];
+                    }
+#if ENABLE_CONTINUATION_HISTORY
+                    set_continuation_context(info, pos, move_list.moves[i]);
+#endif
+
+                    ++info.ply;
+                    const auto child = capture_search_position(pos);
+                    int score = -AlphaBeta(pos, -beta, -local_alpha, current_depth - 1, info, true, false);
+                    --info.ply;
+                    assert_search_position_unchanged(pos, child, "after root child search");
+
+                    if (immediate_repetition && root_static_eval >= WINNING_REPETITION_AVOID_THRESHOLD) {
+                        score = std::min(score, WINNING_REPETITION_DRAW_SCORE);
+                    }
+
+                    pos.TakeMove();
+                    assert_search_position_integrity(pos, "after root TakeMove");
+
+                    if (info.stopped || info.quit) break;
+
+                    if (score > best_score) {
+                        best_score = score;
+                        depth_best_move = move_list.moves[i];
+
+                        // Triangular PV at the root (ply 0): this move + the child's
+                        // line, which the recursion stored at ply 1.
+                        info.pv_line[0][0] = move_list.moves[i];
+                        int child_len = info.pv_length[1];
+                        for (int j = 0; j < child_len; ++j) {
+                            info.pv_line[0][j + 1] = info.pv_line[1][j];
+                        }
+                        info.pv_length[0] = child_len + 1;
+
+                        if (best_score > local_alpha) local_alpha = best_score;
+                        if (best_score >= beta) break; // fail-high → widen beta and re-search
+                    }
+                }
+
+                // Don't widen or loop on an interrupted or terminal pass — the
+                // shared post-loop code below discards it / handles mate+stalemate.
+                if (info.stopped || info.quit) break;
+                if (legal_count == 0) break;
+
+                if (best_score <= alpha) {             // fail-low: widen the lower side
+                    ++info.aspiration_researches;
+                    alpha = std::max(best_score - delta, -30000);
+                    delta *= 2;
+                } else if (best_score >= beta) {       // fail-high: widen the upper side
+                    ++info.aspiration_researches;
+                    beta = std::min(best_score + delta, 30000);
+                    delta *= 2;
+                } else {
+                    break;                              // accepted: score inside the window
+                }
+                if (delta > ASPIRATION_MAX_DELTA) {
+                    alpha = -30000;
+                    beta  =  30000;
+                }
+            }
+#else
+            // Try each move at the root with PVS-style alpha tightening:
+            // pass local_alpha (the best score found so far at root) as the
+            // recursion's alpha, so subsequent subtrees can produce alpha-beta
+            // cutoffs against it instead of searching with the full window.
+            // The fail-high break is dormant here (beta = 30000 only fires on
+            // found-mate) but is in place ready for aspiration windows.
+            const int root_alpha_init = -30000;
+            const int root_beta = 30000;
+            int local_alpha = root_alpha_init;
 
             for (int i = 0; i < move_list.count; ++i) {
                 if (info.stopped || info.quit) break;
+                if (pv_idx > 0 && is_earlier_root_line(move_list.moves[i], pv_idx)) continue;
 
                 if (pos.MakeMove(move_list.moves[i]) != 1) {
                     assert_search_position_integrity(pos, "after illegal root MakeMove rollback");
@@ -3222,9 +3837,13 @@ S_MOVE Engine::searchPosition(Position& pos, SearchInfo& info) {
                 }
                 assert_search_position_integrity(pos, "after root MakeMove");
                 ++legal_count;
+                report_currmove(info, current_depth, move_list.moves[i], legal_count);
 #if ENABLE_ROOT_TWOFOLD_AVOID
-                // BACKLOG #44 follow-up: same gate as the baseline arm — see
-                // the flag-off loop below for the full rationale.
+                // BACKLOG #44 follow-up: rep count >= 2 means this root move
+                // recreates a position key already in the game history (a single
+                // repetition; >= 3 is the rule threefold isRepetition() requires).
+                // The winning clamp below then routes around the shuffle one move
+                // earlier. Same gate as before — no effect unless clearly winning.
                 const bool immediate_repetition =
                     (repetition_count_in_history(pos) >= 2);
 #else
@@ -3236,10 +3855,13 @@ S_MOVE Engine::searchPosition(Position& pos, SearchInfo& info) {
                 if (info.ply >= 0 && info.ply < 64) {
                     info.search_stack[info.ply] = move_list.moves[i];
                 }
+#if ENABLE_CONTINUATION_HISTORY
+                set_continuation_context(info, pos, move_list.moves[i]);
+#endif
 
                 ++info.ply;
                 const auto child = capture_search_position(pos);
-                int score = -AlphaBeta(pos, -beta, -local_alpha, current_depth - 1, info, true, false);
+                int score = -AlphaBeta(pos, -root_beta, -local_alpha, current_depth - 1, info, true, false);
                 --info.ply;
                 assert_search_position_unchanged(pos, child, "after root child search");
 
@@ -3266,102 +3888,27 @@ S_MOVE Engine::searchPosition(Position& pos, SearchInfo& info) {
                     info.pv_length[0] = child_len + 1;
 
                     if (best_score > local_alpha) local_alpha = best_score;
-                    if (best_score >= beta) break; // fail-high → widen beta and re-search
+                    if (best_score >= root_beta) break; // fail-high (no aspiration yet → only mate)
                 }
             }
-
-            // Don't widen or loop on an interrupted or terminal pass — the
-            // shared post-loop code below discards it / handles mate+stalemate.
-            if (info.stopped || info.quit) break;
-            if (legal_count == 0) break;
-
-            if (best_score <= alpha) {             // fail-low: widen the lower side
-                ++info.aspiration_researches;
-                alpha = std::max(best_score - delta, -30000);
-                delta *= 2;
-            } else if (best_score >= beta) {       // fail-high: widen the upper side
-                ++info.aspiration_researches;
-                beta = std::min(best_score + delta, 30000);
-                delta *= 2;
-            } else {
-                break;                              // accepted: score inside the window
-            }
-            if (delta > ASPIRATION_MAX_DELTA) {
-                alpha = -30000;
-                beta  =  30000;
-            }
-        }
-#else
-        // Try each move at the root with PVS-style alpha tightening:
-        // pass local_alpha (the best score found so far at root) as the
-        // recursion's alpha, so subsequent subtrees can produce alpha-beta
-        // cutoffs against it instead of searching with the full window.
-        // The fail-high break is dormant here (beta = 30000 only fires on
-        // found-mate) but is in place ready for aspiration windows.
-        const int root_alpha_init = -30000;
-        const int root_beta = 30000;
-        int local_alpha = root_alpha_init;
-
-        for (int i = 0; i < move_list.count; ++i) {
-            if (info.stopped || info.quit) break;
-
-            if (pos.MakeMove(move_list.moves[i]) != 1) {
-                assert_search_position_integrity(pos, "after illegal root MakeMove rollback");
-                continue; // Skip illegal moves
-            }
-            assert_search_position_integrity(pos, "after root MakeMove");
-            ++legal_count;
-#if ENABLE_ROOT_TWOFOLD_AVOID
-            // BACKLOG #44 follow-up: rep count >= 2 means this root move
-            // recreates a position key already in the game history (a single
-            // repetition; >= 3 is the rule threefold isRepetition() requires).
-            // The winning clamp below then routes around the shuffle one move
-            // earlier. Same gate as before — no effect unless clearly winning.
-            const bool immediate_repetition =
-                (repetition_count_in_history(pos) >= 2);
-#else
-            const bool immediate_repetition = isRepetition(pos);
 #endif
 
-            // Track move in search stack for counter-move heuristic.
-            // info.ply is 0 at root; this writes search_stack[0].
-            if (info.ply >= 0 && info.ply < 64) {
-                info.search_stack[info.ply] = move_list.moves[i];
-            }
-
-            ++info.ply;
-            const auto child = capture_search_position(pos);
-            int score = -AlphaBeta(pos, -root_beta, -local_alpha, current_depth - 1, info, true, false);
-            --info.ply;
-            assert_search_position_unchanged(pos, child, "after root child search");
-
-            if (immediate_repetition && root_static_eval >= WINNING_REPETITION_AVOID_THRESHOLD) {
-                score = std::min(score, WINNING_REPETITION_DRAW_SCORE);
-            }
-
-            pos.TakeMove();
-            assert_search_position_integrity(pos, "after root TakeMove");
-
             if (info.stopped || info.quit) break;
 
-            if (score > best_score) {
-                best_score = score;
-                depth_best_move = move_list.moves[i];
-
-                // Triangular PV at the root (ply 0): this move + the child's
-                // line, which the recursion stored at ply 1.
-                info.pv_line[0][0] = move_list.moves[i];
-                int child_len = info.pv_length[1];
-                for (int j = 0; j < child_len; ++j) {
-                    info.pv_line[0][j + 1] = info.pv_line[1][j];
-                }
-                info.pv_length[0] = child_len + 1;
-
-                if (best_score > local_alpha) local_alpha = best_score;
-                if (best_score >= root_beta) break; // fail-high (no aspiration yet → only mate)
+            // No (further) legal moves: at line 0 the root is mate or
+            // stalemate; past it, fewer legal moves than MultiPV lines.
+            if (legal_count == 0) {
+                no_legal_moves = (pv_idx == 0);
+                break;
             }
+
+            RootLine& line = root_lines[pv_idx];
+            line.move = depth_best_move;
+            line.score = best_score;
+            line.pv_length = info.pv_length[0];
+            std::copy_n(info.pv_line[0], line.pv_length, line.pv);
+            ++lines_done;
         }
-#endif
 
         // If search was interrupted, return previous best move (time management benefit)
         if (info.stopped || info.quit) {
@@ -3370,164 +3917,81 @@ S_MOVE Engine::searchPosition(Position& pos, SearchInfo& info) {
 
         // No legal moves at root: mate or stalemate. Stop iterative deepening
         // since deeper iterations would just repeat the same empty result.
-        if (legal_count == 0) break;
+        if (no_legal_moves) break;
+
+        // user-044: a later line can outscore an earlier one (its aspiration
+        // window or the TT saw more); report lines best-first. Stable, so
+        // equal scores keep search order and multi_pv == 1 is untouched.
+        std::stable_sort(root_lines.begin(), root_lines.begin() + lines_done,
+                         [](const RootLine& a, const RootLine& b) { return a.score > b.score; });
 
         // Update best move for this iteration
-        if (depth_best_move.move != 0) {
-            best_move = depth_best_move;
+        if (root_lines[0].move.move != 0) {
+            best_move = root_lines[0].move;
             // Store in PV table for next iteration's move ordering
-            store_pv_move(pos.zobrist_key, depth_best_move);
+            store_pv_move(pos.zobrist_key, best_move);
         }
 
 #if ENABLE_ASPIRATION
-        // Centre the next depth's aspiration window on this depth's accepted
-        // score (only completed, in-window iterations reach this point).
-        prev_score = best_score;
+        // Centre the next depth's aspiration windows on this depth's accepted
+        // scores (only completed, in-window iterations reach this point).
+        for (int k = 0; k < lines_done; ++k) prev_scores[k] = root_lines[k].score;
 #endif
 
         // Calculate elapsed time for output
         auto now = std::chrono::steady_clock::now();
         auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - info.start_time);
         
-        // Build the PV to display: take the triangular PV as the prefix,
-        // then extend by walking the transposition table. When a root move
-        // bottoms out via a TT cutoff, the child never populates its own
-        // pv_line and the triangular array truncates to length 1 — but the
-        // deeper line still lives in the TT, so pull it out for the GUI.
-        // Repetition / rule-50 truncation runs across both phases: the
-        // *displayed* PV stops at the first position that revisits a prior game
-        // position or reaches the fifty-move draw horizon (GUI validators
-        // reject tails that continue after either terminal condition).
-        // One make/unmake walk paid once per depth, not per node.
         constexpr int PV_DISPLAY_CAP = 32;  // array bound (deeper than Huginn ever reaches)
         // BACKLOG #36: never display a PV longer than the depth actually
         // searched. The triangular prefix is search-truth (length <= depth);
-        // the TT-walk extension below recovers a full-length line when the
+        // TT-walk extension (build_display_pv) recovers a full-length line when the
         // triangular array truncates via a TT cutoff, but must not run past the
         // searched depth — that tail is unverified, and a collision there used
         // to print bogus moves and an over-long PV.
         const int pv_cap = std::min(PV_DISPLAY_CAP, current_depth);
         S_MOVE display_pv[PV_DISPLAY_CAP];
-        int pv_moves = 0;
-        {
-            // Seen-set baseline: only the actual game-history positions
-            // (move_history[0..pos.ply-1]). The full move_history vector
-            // grows during search and retains stale zobrist keys from the
-            // last move sequence each alpha-beta iteration happened to
-            // try (TakeMove decrements pos.ply but doesn't clear the slot).
-            // Iterating the full vector poisoned the seen-set with stale
-            // keys from the search interior — when one of them collided
-            // with a position our walk visited (e.g. position-after-e2e4
-            // after the search's final tried sequence ran through e2e4),
-            // the walk aborted at one move. pos.ply is the game ply at
-            // root emission, so this gives the correct rep-detection
-            // baseline without false positives.
-            std::unordered_set<uint64_t> seen;
-            seen.reserve(static_cast<size_t>(pos.ply) + PV_DISPLAY_CAP);
-            for (int i = 0; i < pos.ply; ++i) {
-                const uint64_t k = pos.move_history[i].zobrist_key;
-                if (k != 0) seen.insert(k);
-            }
-            seen.insert(pos.zobrist_key);
-
-            int made = 0;
-            bool stop = false;
-
-            // Phase 1 — triangular PV prefix (search-truth, definitely legal).
-            const S_MOVE* tri_pv = info.pv_line[0];
-            const int tri_len = info.pv_length[0];
-            for (int i = 0; i < tri_len && pv_moves < pv_cap; ++i) {
-                if (pos.MakeMove(tri_pv[i]) != 1) {
-                    assert_search_position_integrity(pos, "after illegal PV-prefix MakeMove rollback");
-                    stop = true;
-                    break;
-                }
-                assert_search_position_integrity(pos, "after PV-prefix MakeMove");
-                ++made;
-                display_pv[pv_moves++] = tri_pv[i];
-                if (pos.halfmove_clock >= 100) {
-                    stop = true;  // keep the draw-creating move, drop the tail
-                    break;
-                }
-                if (!seen.insert(pos.zobrist_key).second) {
-                    stop = true;  // keep the rep-creating move, drop the tail
-                    break;
-                }
-            }
-
-            // Phase 2 — extend via TT walk. Same collision filter the main
-            // search uses (search.cpp:853-868): sanity-check the raw best_move
-            // before calling MakeMove, since a TT collision can hand back a
-            // move whose from-square is empty or wrong-coloured in the current
-            // position. MakeMove != 1 then catches king-in-check cases.
-            while (!stop && pv_moves < pv_cap) {
-                int tt_score;
-                uint8_t tt_depth, tt_type;
-                uint32_t tt_move_raw;
-                if (!tt_table.probe(pos.zobrist_key, tt_score, tt_depth, tt_type, tt_move_raw)) break;
-                if (tt_move_raw == 0) break;
-
-                S_MOVE tt_move;
-                tt_move.move = static_cast<int>(tt_move_raw);
-                tt_move.score = 0;
-
-                const int from = tt_move.get_from();
-                const int to = tt_move.get_to();
-                if (from < 0 || from >= 64 || to < 0 || to >= 64) break;
-
-                // BACKLOG #36: validate the raw TT move against this position's
-                // generated moves before applying it. A hash collision can hand
-                // back a move that belongs to a *different* position but happens
-                // to have a correctly-coloured from-square — the old check
-                // trusted that and let a bogus move into the displayed PV.
-                // Requiring membership in the pseudo-legal list (then MakeMove
-                // for king safety) makes every displayed move genuinely legal.
-                S_MOVELIST walk_moves;
-                generate_all_moves(pos, walk_moves);
-                bool tt_move_legal = false;
-                for (int wi = 0; wi < walk_moves.count; ++wi) {
-                    if (walk_moves.moves[wi].move == tt_move.move) { tt_move_legal = true; break; }
-                }
-                if (!tt_move_legal) break;
-
-                if (pos.MakeMove(tt_move) != 1) {
-                    assert_search_position_integrity(pos, "after illegal PV TT-walk MakeMove rollback");
-                    break;
-                }
-                assert_search_position_integrity(pos, "after PV TT-walk MakeMove");
-                ++made;
-                display_pv[pv_moves++] = tt_move;
-                if (pos.halfmove_clock >= 100) break;  // fifty-move rule
-                if (!seen.insert(pos.zobrist_key).second) break;  // rep
-            }
-
-            for (int i = 0; i < made; ++i) {
-                pos.TakeMove();
-                assert_search_position_integrity(pos, "after PV display TakeMove");
-            }
-        }
-        const S_MOVE* pv_array = display_pv;
 
+        const uint64_t nps = info.nodes * 1000ULL / std::max<int64_t>(elapsed.count(), 1);
         // Spec-compliant UCI `info` line: tokens in canonical order, PV last
         // (PV is variable-length and consumes to end-of-line per the spec).
         // depth/seldepth/multipv/score/nodes/nps/hashfull/tbhits/time are
         // the standard fields every UCI GUI and adjudication tool expects.
-        const uint64_t nps = info.nodes * 1000ULL / std::max<int64_t>(elapsed.count(), 1);
-        std::cout << "info depth " << current_depth
-                  << " seldepth " << info.seldepth
-                  << " multipv 1"
-                  << " score " << format_uci_score(best_score, pos.side_to_move)
-                  << " nodes " << info.nodes
-                  << " nps " << nps
-                  << " hashfull " << tt_table.permill_full()
-                  << " tbhits " << info.tbhits
-                  << " time " << elapsed.count()
-                  << " pv ";
-        for (int i = 0; i < pv_moves; ++i) {
-            std::cout << move_to_uci(pv_array[i]);
-            if (i < pv_moves - 1) std::cout << " ";
-        }
-        std::cout << std::endl;
+        // user-043: formatted into the engine's preallocated lines and handed
+        // to stdout in one write each (the UCI command thread may print
+        // `readyok` mid-search, user-040). Iterations finishing within
+        // INFO_INTERVAL_MS of the last printed one are held back; the newest
+        // held lines are printed when the search returns, so the final depth
+        // always shows. user-044: one line per MultiPV line, best first.
+        for (int k = 0; k < lines_done; ++k) {
+            const RootLine& line = root_lines[k];
+            const int pv_moves = build_display_pv(pos, line.pv, line.pv_length, pv_cap, display_pv);
+            if (k == 0) {
+                // user-041: the expected reply, sent as `bestmove ... ponder <move>`.
+                info.ponder_move = (pv_moves >= 2 && display_pv[0].move == best_move.move) ? display_pv[1] : S_MOVE();
+            }
+
+            UciLine& out = info_lines[k];
+            out.clear();
+            out.str("info depth ").num(current_depth)
+               .str(" seldepth ").num(info.seldepth)
+               .str(" multipv ").num(k + 1)
+               .str(" score ").score(line.score)
+               .str(" nodes ").unum(info.nodes)
+               .str(" nps ").unum(nps)
+               .str(" hashfull ").num(tt_table.permill_full())
+               .str(" tbhits ").unum(info.tbhits)
+               .str(" time ").num(elapsed.count())
+               .str(" pv");
+            for (int i = 0; i < pv_moves; ++i) {
+                out.chr(' ').move(display_pv[i]);
+            }
+        }
+        lines_held = lines_done;
+        if (info_throttle.allow_iteration(elapsed.count())) {
+            for (int k = 0; k < lines_held; ++k) info_lines[k].emit(*info_out);
+            lines_held = 0;
+        }
 
 #if ENABLE_INFO_DIAGNOSTICS
         // Engine-internal pruning/ordering counters. Gated off by default so
@@ -3535,7 +3999,7 @@ S_MOVE Engine::searchPosition(Position& pos, SearchInfo& info) {
         // (b) the increments above (null_cut, lmr_*, tt hits/misses/writes)
         // compile out from the hot path. Build with
         // `-DENABLE_INFO_DIAGNOSTICS=1` when tuning.
-        std::cout << "info string diag"
+        *info_out << "info string diag"
                   << " nullcut " << info.null_cut
                   << " lmr " << info.lmr_attempts << "/" << info.lmr_failures
                   << " tthits " << tt_table.get_hits()
@@ -3546,23 +4010,29 @@ S_MOVE Engine::searchPosition(Position& pos, SearchInfo& info) {
 #if ENABLE_PRUNING_STATS
         // Print futility pruning statistics for this depth
         if (info.futility_cuts > 0) {
-            std::cout << "info string Depth " << current_depth << " - Futility cuts: "
+            *info_out << "info string Depth " << current_depth << " - Futility cuts: "
                       << info.futility_cuts << " (" << std::fixed << std::setprecision(1)
                       << (double(info.futility_cuts) / info.nodes * 100.0) << "%)" << std::endl;
         }
 
         // Print razoring statistics for this depth
         if (info.razoring_cuts > 0) {
-            std::cout << "info string Depth " << current_depth << " - Razoring cuts: "
+            *info_out << "info string Depth " << current_depth << " - Razoring cuts: "
                       << info.razoring_cuts << " (" << std::fixed << std::setprecision(1)
                       << (double(info.razoring_cuts) / info.nodes * 100.0) << "%)" << std::endl;
         }
 #endif
 
+        // user-045: `go mate N` — done once this depth proves a mate in at
+        // most N moves (2N-1 plies) for the side to move.
+        if (info.mate_in > 0 && root_lines[0].score >= MATE - (2 * info.mate_in - 1)) break;
+
         // Iteration-start time gating happens at the top of the loop; no
         // post-iteration time check needed here.
     }
-    
+
+    // user-043: last iteration held back by the throttle
+    for (int k = 0; k < lines_held; ++k) info_lines[k].emit(*info_out);
     return best_move;
 }
 
@@ -3597,6 +4067,22 @@ bool Engine::probe_tablebase_wdl(const Position& pos, int& wdl_score) const {
     return true;
 }
 
+/// @brief user-049 probing policy. The effective limit is the smaller of
+///        SyzygyProbeLimit and the backend's piece count; below it any depth
+///        probes, at it only depth >= SyzygyProbeDepth, so the largest (and
+///        most expensive) tables are kept off the shallow nodes.
+bool Engine::should_probe_tablebase(const Position& pos, int depth) const {
+    if (!tablebase || !tablebase->is_available()) {
+        return false;
+    }
+    if (pos.halfmove_clock != 0 || pos.castling_rights != 0) {
+        return false;  // unprobeable, and unsafe to cache (see AlphaBeta)
+    }
+    const int limit = std::min(syzygy_probe_limit, tablebase->max_piece_count());
+    const int pieces = popcount(pos.occupied_bitboard);
+    return pieces < limit || (pieces == limit && depth >= syzygy_probe_depth);
+}
+
 /// @brief Root Syzygy probe: the TB-best move for @p pos, or a null move if no
 ///        TB / not probeable. Lets the engine play perfect endgame moves directly.
 S_MOVE Engine::probe_tablebase_root(const Position& pos) const {
@@ -3614,4 +4100,23 @@ S_MOVE Engine::probe_tablebase_root(const Position& pos) const {
     return tablebase->probe_root(pos);
 }
 
+/// @brief Map the endgame table file at @p path (replaces any loaded tables).
+bool Engine::load_endgame_tables(const std::string& path) {
+    return endgame_tables.load(path);
+}
+
+bool Engine::probe_endgame_tables(const Position& pos, const SearchInfo& info, int& score) const {
+    EgtbResult result;
+    if (!endgame_tables.probe(pos, result)) return false;
+    if (result.wdl == 0) {
+        score = 0;
+        return true;
+    }
+    // DTM counts no fifty-move rule: only trust mates that land in time
+    if (pos.halfmove_clock + result.dtm > 100) return false;
+    const int mate = MATE - info.ply - result.dtm;
+    score = (result.wdl > 0) ? mate : -mate;
+    return true;
+}
+
 } // namespace Huginn
@@ -25,38 +25,53 @@
 #include "pvtable.hpp"
 #include "transposition_table.hpp"
 #include "polyglot_book.hpp"
-#include "syzygy_tablebase.hpp"
+#include "uci_output.hpp"
+#include "tablebase_backend.hpp"
+#include "endgame_tables.hpp"
+#include <array>
 #include <atomic>
 #include <chrono>
-#include <functional>
+#include <string>
 #include <vector>
 
 namespace Huginn {
 
-// BACKLOG #3: 1-ply continuation history (counter-move history). Generalizes
-// the scalar counter-move table (ENABLE_PLY_TRACKED_COUNTERMOVE) into a full
-// depth^2-updated history conditioned on the parent move. Gated for clean SPRT
-// A/B: when 0, the table, helpers, and call sites all vanish. See search.cpp
-// ordering/update sites and clear_search_tables() for the zero-init.
-// Default OFF: the 1-ply additive implementation was falsified by gauntlet
-// (w16 neutral, w64 -9 Elo Intel / worse AMD — see BACKLOG #3). Kept gated and
-// in-tree for a future bounded-gravity redesign; flag-off is byte-identical to
-// baseline-t9. Set to 1 only to re-test a revised design.
+// BACKLOG #3 / user-032: continuation history, 1 and 2 plies back. Scores a
+// quiet move by the (piece, to) of the moves one and two plies earlier, on
+// top of butterfly history. Redesign of the shelved 1-ply additive arm (w16
+// neutral, w64 -9 Elo Intel / worse AMD — see BACKLOG #3), which re-derived
+// both piece indices through at_sq64() on every lookup and let entries grow
+// to +-32000 under a weight-64 multiplier:
+//   - one shared table of ContHistEntry sub-tables, indexed by the earlier
+//     move's (piece, to); SearchInfo::cont_hist[ply] points at the sub-table
+//     of the move played at that ply, so a lookup is one indexed load per
+//     ply back;
+//   - 768 x 768 int16 = 1.18 MB — fits a 2 MB L2 (row 0 of the 13-row
+//     butterfly layout is dropped; the old flat table was 1.38 MB);
+//   - bounded "gravity" updates (entry += bonus - entry*|bonus|/CONTHIST_MAX)
+//     keep every entry within +-CONTHIST_MAX without clamping, and recent
+//     results displace stale ones instead of saturating.
+// Feeds quiet-move ordering (pick_next_move) and, with ENABLE_HISTORY_LMR,
+// the LMR history modulation. CANDIDATE — default 0 (byte-identical to
+// baseline-t34); -DENABLE_CONTINUATION_HISTORY=ON builds the test arm.
 #ifndef ENABLE_CONTINUATION_HISTORY
 #define ENABLE_CONTINUATION_HISTORY 0
 #endif
 
-// BACKLOG #3 tuning knobs (the PRIMARY levers for the conthist gauntlet):
-//   WEIGHT — multiplies the conthist score before blending into the quiet-move
-//     ordering score. At weight 1 the term is inert: Huginn's butterfly history
-//     accumulates unbounded over all parent contexts (~1K+ per entry, per the
-//     counter-move comment) and swamps a single-context conthist entry. ~16
-//     brings conthist to a co-equal secondary signal; tune by gauntlet.
-//   CAP — clamps |weight*conthist| so a hot quiet move stays in the history
-//     band and never leaps the promotion (25K-90K) / killer (800K-900K) /
-//     capture (1M) tiers, preserving the existing ordering hierarchy.
-constexpr int CONTHIST_ORDER_WEIGHT = 64;
-constexpr int CONTHIST_ORDER_CAP = 8000;
+// user-032 tuning knobs:
+//   MAX — gravity bound on one entry. Two plies summed stay below 2*MAX =
+//     16384, under the promotion band (25K+), so a hot quiet move can rise
+//     through the history band but never leap promotions/killers/captures.
+//   BONUS_MAX — cap on the per-update depth^2-scaled bonus.
+constexpr int CONTHIST_MAX = 8192;
+constexpr int CONTHIST_BONUS_MAX = 1536;
+static_assert(2 * CONTHIST_MAX < 25000, "continuation history must stay below the promotion band");
+
+/// (piece, to) slots per continuation-history sub-table: 12 pieces x 64 squares.
+constexpr int CONTHIST_PIECE_TO = 12 * 64;
+
+/// One continuation-history sub-table: follow-up (piece, to) -> score.
+using ContHistEntry = std::array<int16_t, CONTHIST_PIECE_TO>;
 
 // Engine-internal diagnostic counters gate. When 1, search emits a
 // second per-depth `info string` with non-standard counters (null-move
@@ -80,6 +95,24 @@ const int INFINITE = 30000;
 const int MATE = 29000;
 // MAX_DEPTH is defined in pvtable.hpp
 
+/// @brief Nodes between Engine::checkup() polls (user-045: a scheduled
+///        threshold, SearchInfo::next_checkup, rather than `nodes & 2047`).
+constexpr uint64_t CHECKUP_INTERVAL = 2048;
+
+/// @brief Upper bound of the UCI `MultiPV` option (user-044).
+constexpr int MAX_MULTI_PV = 64;
+
+/**
+ * @brief One completed MultiPV root line of the current iteration (user-044):
+ *        its root move, exact score and triangular PV.
+ */
+struct RootLine {
+    S_MOVE move;
+    int score = 0;
+    int pv_length = 0;
+    S_MOVE pv[64];
+};
+
 /**
  * @brief Per-search runtime state, limits, statistics, and the collected PV.
  *
@@ -101,10 +134,17 @@ struct SearchInfo {
     bool quit;          // Flag to quit search
     bool stopped;       // Flag indicating search was stopped
     bool depth_only;    // UCI depth command - bypass time management
+    bool ponder;        // `go ponder` not yet converted: no clock until Engine::ponder_hit (user-041)
+    int multi_pv;       // UCI MultiPV: root lines searched and reported per iteration (user-044)
+    uint64_t max_nodes; // `go nodes`: stop once nodes reaches it, checked in checkup (0 = none; user-045)
+    int mate_in;        // `go mate`: stop after the first iteration proving mate in <= N moves (0 = off)
+    std::vector<S_MOVE> searchmoves;  // `go searchmoves`: the only root moves searched (empty = all)
+    uint64_t next_checkup;  // node count at which the search next calls checkup (user-045)
     uint64_t nodes;     // Nodes searched so far
     int seldepth;       // Max selective depth seen (incl. qsearch); standard UCI info
     uint64_t tbhits;    // Successful Syzygy tablebase probes; standard UCI info
     S_MOVE best_move;   // Best move found (VICE Part 58)
+    S_MOVE ponder_move; // Reply after best_move on the last completed iteration's PV (0 if none)
 
     // VICE Part 60: Move ordering statistics (0:13)
     uint64_t fh;        // Fail high count (beta cutoffs)
@@ -156,9 +196,30 @@ struct SearchInfo {
     // never incremented on the baseline arm.
     uint64_t lmp_prunes;
 
+    // Internal iterative reductions (ENABLE_IIR, user-034): nodes searched one
+    // ply shallower for lack of a TT move. Always present (tests read it on
+    // the ON arm); never incremented on the baseline (IID) arm.
+    uint64_t iir_reductions;
+
+    // Upcoming repetitions (ENABLE_UPCOMING_REPETITION, user-035): nodes whose
+    // alpha was raised to the draw because the side to move can repeat.
+    // Always present; never incremented on the baseline arm.
+    uint64_t upcoming_repetitions;
+
+    // ProbCut cutoffs (ENABLE_PROBCUT, user-038): nodes cut because a reduced
+    // search of a good capture beat beta + margin. Always present; never
+    // incremented on the baseline arm.
+    uint64_t probcut_cuts;
+
     // Counter-move heuristic: track moves played to update counter-move table
     S_MOVE search_stack[64];  // Stack of moves made during search (max 64 plies)
 
+#if ENABLE_CONTINUATION_HISTORY
+    // user-032: continuation-history sub-table of the move at each ply (set
+    // alongside search_stack); nullptr for root/null moves — no context.
+    ContHistEntry* cont_hist[64];
+#endif
+
     // Triangular PV table — the exact principal variation collected during the
     // search itself. pv_line[ply] holds the PV from that ply onward and
     // pv_length[ply] its length; a node copies its best child's line up and
@@ -170,24 +231,19 @@ struct SearchInfo {
     S_MOVE pv_line[64][64];
     int pv_length[64];
 
-    // #56: mid-search input pump installed by the UCI layer. When checkup()
-    // sees pending stdin input it calls this instead of read_input(); the UCI
-    // pump answers `isready` with `readyok` WITHOUT stopping the search,
-    // applies `stop`/`quit` to this SearchInfo, and queues everything else
-    // (`position`, `go`, `setoption`, ...) for the command loop to replay in
-    // order after `bestmove`. Empty (bare-Engine use: tests, bench) falls back
-    // to read_input()'s conservative any-input-stops behaviour.
-    std::function<void(SearchInfo&)> on_input;
-
     SearchInfo() : depth(0), max_depth(25), ply(0), movestogo(30), infinite(false),
-                   quit(false), stopped(false), depth_only(false), nodes(0), seldepth(0), tbhits(0),
-                   best_move(), fh(0), fhf(0), null_cut(0),
+                   quit(false), stopped(false), depth_only(false), ponder(false), multi_pv(1), max_nodes(0), mate_in(0), next_checkup(CHECKUP_INTERVAL), nodes(0), seldepth(0), tbhits(0),
+                   best_move(), ponder_move(), fh(0), fhf(0), null_cut(0),
                    futility_cuts(0), lmr_attempts(0), lmr_failures(0), razoring_cuts(0),
                    singular_exts(0), aspiration_researches(0), history_lmr_adjusts(0),
-                   lmp_prunes(0) {
+                   lmp_prunes(0), iir_reductions(0), upcoming_repetitions(0),
+                   probcut_cuts(0) {
         // Initialize search stack
         for (int i = 0; i < 64; ++i) {
             search_stack[i] = S_MOVE();
+#if ENABLE_CONTINUATION_HISTORY
+            cont_hist[i] = nullptr;
+#endif
             pv_length[i] = 0;
         }
     }
@@ -203,6 +259,10 @@ struct MinimalLimits {
     int max_depth = 25;     ///< Maximum search depth (copied to SearchInfo::max_depth).
     int max_time_ms = 5000; ///< Soft time budget for the move, in milliseconds.
     bool infinite = false;  ///< If true, search until explicitly stopped (ignore the time budget).
+    bool ponder = false;    ///< `go ponder`: the budget applies only after `ponderhit` (user-041).
+    uint64_t max_nodes = 0; ///< `go nodes N`: node budget, enforced in Engine::checkup (0 = none; user-045).
+    int mate_in = 0;        ///< `go mate N`: stop once a mate in <= N moves is proven (0 = off; user-045).
+    std::vector<std::string> searchmoves; ///< `go searchmoves ...`: root moves to consider, as sent (empty = all).
 };
 
 /**
@@ -219,9 +279,9 @@ class Engine {
 public:  // Make members public for easier access
     /**
      * @brief Constructs the engine and initializes its tables.
-     * @param tb Optional Syzygy tablebase handle (nullptr = tablebases disabled).
+     * @param tb Optional tablebase backend (nullptr = tablebases disabled).
      */
-    Engine(SyzygyTablebase* tb = nullptr) : tablebase(tb), pv_table(2), tt_table(64) {
+    Engine(TablebaseBackend* tb = nullptr) : tablebase(tb), pv_table(2), tt_table(64) {
         // Initialize MVV-LVA table
         init_mvv_lva();
         
@@ -235,13 +295,28 @@ public:  // Make members public for easier access
     // written cross-thread (the old path published a raw pointer to the
     // stack SearchInfo and wrote its non-atomic fields from another thread).
     std::atomic<bool> should_stop{false};
+    // user-041: raised by the UCI thread on `ponderhit`. checkup() turns a
+    // ponder search into a timed one the first time it sees the flag; the
+    // search itself (TT, history, killers, iteration) carries on unchanged.
+    std::atomic<bool> ponder_hit{false};
     int nodes_searched = 0;
     std::chrono::steady_clock::time_point start_time;
     MinimalLimits current_limits;
     PVTable pv_table;  // Principal Variation table (VICE tutorial style)
     TranspositionTable tt_table;  // VICE Part 84: Transposition table for storing search results
     PolyglotBook opening_book;    // VICE Part 85: Polyglot opening book for opening moves
-    SyzygyTablebase* tablebase;  // Syzygy tablebase for endgame perfect play
+    TablebaseBackend* tablebase;  // Syzygy tablebase for endgame perfect play (user-049: any backend)
+    // user-049: UCI SyzygyProbeDepth / SyzygyProbeLimit. Positions with fewer
+    // pieces than the effective limit are probed at any depth; positions with
+    // exactly that many only at depth >= syzygy_probe_depth.
+    int syzygy_probe_depth = 1;
+    int syzygy_probe_limit = 7;
+    // user-050: where searchPosition() writes its `info` lines. std::cout for
+    // the UCI front-end (bench and tests swap its rdbuf); huginn_match points
+    // each in-process engine at its own sink so concurrent games never share
+    // a stream.
+    std::ostream* info_out = &std::cout;
+    EndgameTables endgame_tables;  // user-048: Huginn's own ≤4-man DTM tables (EGTBFile)
     
     // Search History array (3:55) - stores scores for moves that improved alpha
     // [piece][to_square] - 13 piece types, 64 squares
@@ -262,27 +337,18 @@ public:  // Make members public for easier access
     S_MOVE counter_moves[64][64];
 
 #if ENABLE_CONTINUATION_HISTORY
-    // BACKLOG #3: 1-ply continuation history (counter-move history).
-    // Logically [prevPiece][prevTo][curPiece][curTo] -> score, flattened to a
-    // heap vector and indexed via ch_index(). The "prev" piece/to is the
-    // opponent's last move; at the current node that piece sits on prevTo, so
-    // it is recoverable via pos.at_sq64(prevTo). Updated with the same +/-depth^2
-    // bonus as butterfly history, blended additively into quiet-move ordering.
-    //
-    // HEAP-allocated (not a by-value array): at 13*64*13*64 int16 = ~1.38MB it
-    // would overflow the 1MB Windows stack when a test constructs Engine by
-    // value. int16_t (not int) halves the footprint — Huginn is footprint-
-    // sensitive (the board64 cache #26 was reverted on that basis).
+    // user-032: continuation history (see the flag comment at the top of this
+    // file). continuation_history[cont_hist_index(piece, to)] is the sub-table
+    // for "after a move of `piece` to `to`". HEAP-allocated: 1.18 MB would
+    // overflow the 1MB Windows stack when a test constructs Engine by value.
     // Zero-initialized at construction; clear_search_tables() ages rather than
     // zeroing, so the first search never reads garbage (nondeterminism, cf. #30).
-    static constexpr int CH_PIECES = 13;
-    static constexpr int CH_SQUARES = 64;
-    static constexpr size_t CH_SIZE =
-        size_t(CH_PIECES) * CH_SQUARES * CH_PIECES * CH_SQUARES;
-    std::vector<int16_t> continuation_history = std::vector<int16_t>(CH_SIZE, 0);
-
-    static constexpr size_t ch_index(int pp, int prev_to, int cp, int to) {
-        return ((size_t(pp) * CH_SQUARES + prev_to) * CH_PIECES + cp) * CH_SQUARES + to;
+    std::vector<ContHistEntry> continuation_history =
+        std::vector<ContHistEntry>(CONTHIST_PIECE_TO, ContHistEntry{});
+
+    /// @brief (piece, to) slot from a history_piece_row() row (1-12) and square.
+    static constexpr int cont_hist_index(int piece_row, int to) {
+        return (piece_row - 1) * 64 + to;
     }
 #endif
 
@@ -321,9 +387,15 @@ public:  // Make members public for easier access
     // UCI score formatting helper
     // UCI score formatting
     std::string format_uci_score(int score, Color side_to_move) const;
+    // user-043: root `currmove` line, rate-limited by elapsed time.
+    void report_currmove(const SearchInfo& info, int depth, const S_MOVE& move, int number);
+    std::vector<UciLine> info_lines;  ///< Newest iteration's `info` lines, one per MultiPV line (user-044).
+    std::vector<RootLine> root_lines; ///< This/last iteration's MultiPV lines, best first after each iteration.
+    InfoThrottle info_throttle; ///< Elapsed-time gate for iteration lines.
 
     void stop() { should_stop = true; }
-    void reset() { should_stop = false; nodes_searched = 0; }
+    void ponderhit() { ponder_hit = true; }
+    void reset() { should_stop = false; ponder_hit = false; nodes_searched = 0; }
     
     // Utility to convert move to UCI string
     static std::string move_to_uci(const S_MOVE& move);
@@ -333,6 +405,15 @@ public:  // Make members public for easier access
     
     // PV table helper functions
     void store_pv_move(uint64_t position_key, const S_MOVE& move);
+    // Displayed PV of one root line: triangular prefix + TT walk (user-044)
+    int build_display_pv(Position& pos, const S_MOVE* tri_pv, int tri_len, int pv_cap, S_MOVE* out);
+    /// @brief Is @p move the root move of MultiPV line 0..@p lines-1 of this iteration?
+    bool is_earlier_root_line(const S_MOVE& move, int lines) const {
+        for (int k = 0; k < lines; ++k) {
+            if (root_lines[k].move.move == move.move) return true;
+        }
+        return false;
+    }
 
     // Search history and killer move functions
     void update_search_history(const Position& pos, const S_MOVE& move, int depth);
@@ -345,13 +426,13 @@ public:  // Make members public for easier access
     S_MOVE get_counter_move(const S_MOVE& previous_move) const;
 
 #if ENABLE_CONTINUATION_HISTORY
-    // BACKLOG #3: 1-ply continuation history. `prev` is the parent move
-    // (info.search_stack[ply-1]); both helpers must be called with `pos` at the
-    // current node (after TakeMove), where prev's piece sits on prev.get_to().
-    void update_continuation_history(const Position& pos, const S_MOVE& prev,
-                                     const S_MOVE& move, int bonus);
-    int get_continuation_history(const Position& pos, const S_MOVE& prev,
-                                 const S_MOVE& move) const;
+    // user-032: continuation history. `piece_row`/`to` describe the quiet move
+    // searched at info.ply; the contexts are info.cont_hist[ply-1] and [ply-2].
+    int continuation_score(const SearchInfo& info, int piece_row, int to) const;
+    void update_continuation_history(SearchInfo& info, int piece_row, int to, int bonus);
+    /// @brief Point info.cont_hist[info.ply] at the sub-table of @p move, which
+    ///        was just made in @p pos (its piece now sits on move.get_to()).
+    void set_continuation_context(SearchInfo& info, const Position& pos, const S_MOVE& move);
 #endif
 
     // MVV-LVA (Most Valuable Victim, Least Valuable Attacker) functions
@@ -374,7 +455,7 @@ public:  // Make members public for easier access
     
     // ---- VICE Part 55: core search ----
 
-    /// Polls the clock and GUI input; sets `info.stopped` when the budget is hit. (1:34)
+    /// Polls the stop flag, node budget and clock; sets `info.stopped` when a limit is hit. (1:34)
     void checkup(SearchInfo& info);
     /// Resets per-search tables, counters, and the PV before a fresh search. (VICE Part 57)
     static void clearForSearch(Engine& engine, SearchInfo& info);
@@ -432,11 +513,30 @@ public:  // Make members public for easier access
      */
     bool probe_tablebase_wdl(const Position& pos, int& wdl_score) const;
 
+    /**
+     * @brief Syzygy probing policy for an interior node (user-049): piece
+     *        count within SyzygyProbeLimit and the backend, depth gate at the
+     *        limit, and only positions with rule50 == 0 and no castling rights.
+     */
+    bool should_probe_tablebase(const Position& pos, int depth) const;
+
     /**
      * @brief Probes Syzygy tablebases at the root for the best move.
      * @return The tablebase-optimal move, or an empty move if no hit.
      */
     S_MOVE probe_tablebase_root(const Position& pos) const;
+
+    /// @brief Map an endgame table file written by huginn_egtbgen. (user-048)
+    bool load_endgame_tables(const std::string& path);
+
+    /**
+     * @brief Probes Huginn's own endgame tables at an interior node. (user-048)
+     * @param[out] score Exact score: a mate score with the table's distance to
+     *             mate, or 0 for a draw.
+     * @return false on a miss, and for a decisive result the fifty-move rule
+     *         could overturn (halfmove clock + DTM > 100).
+     */
+    bool probe_endgame_tables(const Position& pos, const SearchInfo& info, int& score) const;
 };
 
 } // namespace Huginn
@@ -233,9 +233,10 @@ int see(const Position& pos, const S_MOVE& move) {
         // on `to` by the previous mover, then expose ourselves to recapture.
         gain[d] = SEE_PIECE_VALUE[int(attacker_pt)] - gain[d - 1];
 
-        // Provable-loss pruning: if the best-case outcome is still bad
-        // for the side considering this swap, abandon further depth.
-        if (std::max(-gain[d - 1], gain[d]) < 0) break;
+        // (No "provable-loss" early break here: it kept the sign but not the
+        // magnitude — Rxe5 in 4r1k1/pp1n1r1p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/
+        // 4RRK1 w read -80 instead of -180. Callers that only need a bound
+        // use see_ge(), which exits early soundly; see() stays exact.)
 
         attacker_pt = next_pt;
         occ ^= lva_bit;
@@ -256,4 +257,84 @@ int see(const Position& pos, const S_MOVE& move) {
     return gain[0];
 }
 
+bool see_ge(const Position& pos, const S_MOVE& move, int threshold) {
+    const int from64 = move.get_from();
+    const int to64   = move.get_to();
+    const uint64_t from_bit = 1ULL << from64;
+    const uint64_t to_bit   = 1ULL << to64;
+    uint64_t occ = pos.occupied_bitboard;
+
+    // Same first-capture accounting as see(): victim (pawn for en passant),
+    // and a promotion-capture both gains (promo - pawn) and leaves the
+    // promoted piece on the square to be recaptured.
+    int captured = 0;
+    if (move.is_en_passant()) {
+        captured = SEE_PIECE_VALUE[int(PieceType::Pawn)];
+    } else if (occ & to_bit) {
+        captured = SEE_PIECE_VALUE[int(piece_type_on(pos, to_bit))];
+    }
+    PieceType on_square = piece_type_on(pos, from_bit);
+    if (move.is_promotion()) {
+        PieceType promo = move.get_promoted();
+        captured += SEE_PIECE_VALUE[int(promo)] - SEE_PIECE_VALUE[int(PieceType::Pawn)];
+        on_square = promo;
+    }
+
+    // `swap` is the margin the side that just captured must still defend.
+    // Even if nothing recaptures, the capture alone must reach the threshold...
+    int swap = captured - threshold;
+    if (swap < 0) return false;
+    // ...and if losing the capturer for nothing still clears it, we're done.
+    swap = SEE_PIECE_VALUE[int(on_square)] - swap;
+    if (swap <= 0) return true;
+
+    occ ^= from_bit;
+    if (move.is_en_passant()) {
+        const int cap_sq = (pos.side_to_move == Color::White) ? to64 - 8 : to64 + 8;
+        occ ^= (1ULL << cap_sq);
+    }
+
+    uint64_t all_attackers = attackers_to(pos, to64, occ);
+    const uint64_t rq_const =
+        pos.piece_bitboards[0][int(PieceType::Rook)]   | pos.piece_bitboards[0][int(PieceType::Queen)] |
+        pos.piece_bitboards[1][int(PieceType::Rook)]   | pos.piece_bitboards[1][int(PieceType::Queen)];
+    const uint64_t bq_const =
+        pos.piece_bitboards[0][int(PieceType::Bishop)] | pos.piece_bitboards[0][int(PieceType::Queen)] |
+        pos.piece_bitboards[1][int(PieceType::Bishop)] | pos.piece_bitboards[1][int(PieceType::Queen)];
+
+    Color side = pos.side_to_move;
+    bool result = true;     // true while the original mover is ahead of the threshold
+    bool first_recapture = true;
+    while (true) {
+        side = (side == Color::White) ? Color::Black : Color::White;
+        all_attackers &= occ;
+        uint64_t side_attackers = all_attackers & pos.color_bitboards[int(side)];
+#if ENABLE_SEE_LEGALITY
+        // #58: legality-check the FIRST recapture only, exactly as see().
+        if (first_recapture && side_attackers) {
+            side_attackers = filter_absolute_pins(pos, side_attackers, side, to64, occ);
+        }
+#endif
+        first_recapture = false;
+
+        PieceType next_pt;
+        const uint64_t lva_bit = least_valuable_attacker(pos, side_attackers, side, next_pt);
+        if (lva_bit == 0) break;
+
+        // This side captures; the outcome flips unless the other side can
+        // recapture in turn. Stop as soon as even losing the capturer keeps
+        // this side on the winning side of the threshold. A king "capture"
+        // into a still-attacked square is refuted on the next pass (20000
+        // keeps swap positive), which is what makes it illegal here.
+        result = !result;
+        swap = SEE_PIECE_VALUE[int(next_pt)] - swap;
+        if (swap < int(result)) break;
+
+        occ ^= lva_bit;
+        all_attackers |= (rook_attacks(to64, occ) & rq_const) |
+                         (bishop_attacks(to64, occ) & bq_const);
+    }
+    return result;
+}
+
 } // namespace Huginn
@@ -12,8 +12,9 @@
  *      can only worsen the standing eval, so searching them adds noise.
  *
  * Implementation: standard iterative swap-out with bitboard attacker
- * enumeration. Re-derives sliding (bishop/rook/queen) x-ray attackers
- * through removed pieces in the swap chain.
+ * enumeration; see_ge() is the early-exit threshold form used by search.
+ * Re-derives sliding (bishop/rook/queen) x-ray attackers through removed
+ * pieces in the swap chain.
  */
 
 #include <cstdint>
@@ -44,4 +45,16 @@ inline constexpr int SEE_PIECE_VALUE[7] = { 0, 100, 320, 330, 500, 900, 20000 };
  */
 int see(const Position& pos, const S_MOVE& move);
 
+/**
+ * @brief Threshold SEE: is `see(pos, move) >= threshold`? (user-036)
+ *
+ * Same swap sequence as see() — least-valuable attacker, x-ray re-derivation,
+ * the ENABLE_SEE_LEGALITY pin filter on the first recapture — but carries a
+ * single running margin instead of a gain stack and stops as soon as the
+ * answer is decided. Most calls end before the first recapture: a capture of
+ * an equal or bigger piece is decided by the first two comparisons alone.
+ * Every search call site only needs the sign, so they use this.
+ */
+bool see_ge(const Position& pos, const S_MOVE& move, int threshold);
+
 } // namespace Huginn
@@ -101,6 +101,10 @@ bool SyzygyTablebase::is_available() const {
     return is_initialized;
 }
 
+int SyzygyTablebase::max_piece_count() const {
+    return is_initialized ? max_pieces : 0;
+}
+
 bool SyzygyTablebase::can_probe(const Position& pos) const {
     if (!is_initialized) {
         return false;
@@ -5,8 +5,8 @@
  * Gives the search perfect WDL/DTZ results for low-piece-count endgames. The
  * whole feature is compiled out unless `ENABLE_FATHOM` (→ `FATHOM_AVAILABLE`)
  * is set, so non-TB builds pay nothing. Probe results are mapped to Huginn's
- * own score scale by the search (see search.cpp); they are deliberately NOT
- * stored in the TT (rule50 isn't in the Zobrist key).
+ * own score scale by the search (see search.cpp), which also decides when to
+ * probe and how results enter the TT (user-049).
  */
 #pragma once
 
@@ -15,6 +15,7 @@
 #include "chess_types.hpp"
 #include "position.hpp"
 #include "move.hpp"
+#include "tablebase_backend.hpp"
 
 // Conditional compilation for Fathom library
 #ifndef FATHOM_AVAILABLE
@@ -37,9 +38,10 @@ namespace Huginn {
  * @brief Syzygy Tablebase Interface
  * 
  * Provides access to Syzygy endgame tablebases for perfect endgame play.
- * Uses the Fathom library for tablebase access.
+ * Uses the Fathom library for tablebase access. The search sees it only
+ * through TablebaseBackend (user-049).
  */
-class SyzygyTablebase {
+class SyzygyTablebase : public TablebaseBackend {
 private:
     std::string tablebase_path;  ///< Directory the .rtbw/.rtbz files were loaded from.
     bool is_initialized;         ///< True between a successful initialize() and shutdown().
@@ -47,7 +49,7 @@ private:
 
 public:
     SyzygyTablebase();
-    ~SyzygyTablebase();
+    ~SyzygyTablebase() override;
     
     /**
      * @brief Initialize tablebase with given path
@@ -65,34 +67,37 @@ public:
      * @brief Check if tablebases are loaded and ready
      * @return true if tablebases are available
      */
-    bool is_available() const;
+    bool is_available() const override;
+
+    /// @brief Largest piece count the loaded tablebases cover (0 when not initialized).
+    int max_piece_count() const override;
 
     /**
      * @brief Check if position can be probed
      * @param pos Position to check
      * @return true if position has <= max_pieces and no castling/en passant
      */
-    bool can_probe(const Position& pos) const;
+    bool can_probe(const Position& pos) const override;
     
     /**
      * @brief Probe WDL (Win/Draw/Loss) result
      * @param pos Position to probe
      * @return WDL result: >0 = win, 0 = draw, <0 = loss, INT32_MAX = probe failed
      */
-    int probe_wdl(const Position& pos) const;
+    int probe_wdl(const Position& pos) const override;
     
     /**
      * @brief Get best move from tablebase
      * @param pos Position to probe
      * @return best move, or null move if probe failed
      */
-    S_MOVE probe_root(const Position& pos) const;
+    S_MOVE probe_root(const Position& pos) const override;
 
     /**
      * @brief Get tablebase statistics
      * @return string with tablebase info
      */
-    std::string get_info() const;
+    std::string get_info() const override;
 };
 
 } // namespace Huginn
\ No newline at end of file
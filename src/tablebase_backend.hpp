@@ -0,0 +1,46 @@
+/**
+ * @file tablebase_backend.hpp
+ * @brief Abstract WDL tablebase the search probes (user-049).
+ *
+ * The search only needs availability, a piece-count limit, a WDL probe and a
+ * root move; SyzygyTablebase (Fathom) is the production backend. Keeping the
+ * probing policy — when to probe, how results enter the TT — in Engine and
+ * the file access behind this interface lets tests drive that policy with an
+ * in-memory backend instead of real .rtbw files.
+ */
+#pragma once
+
+#include <string>
+#include "position.hpp"
+#include "move.hpp"
+
+namespace Huginn {
+
+class TablebaseBackend {
+public:
+    virtual ~TablebaseBackend() = default;
+
+    /// @brief True when tables are loaded and probes may succeed.
+    virtual bool is_available() const = 0;
+
+    /// @brief Largest total piece count (kings included) the tables cover.
+    virtual int max_piece_count() const = 0;
+
+    /// @brief Cheap pre-check: could probe_wdl() succeed for @p pos?
+    virtual bool can_probe(const Position& pos) const = 0;
+
+    /**
+     * @brief WDL value of @p pos for the side to move, on Huginn's scale.
+     * @return MATE - 1000 / -(MATE - 1000) for a win / loss, 0 for a draw,
+     *         ±1 for a cursed win / blessed loss, INT32_MAX if the probe failed.
+     */
+    virtual int probe_wdl(const Position& pos) const = 0;
+
+    /// @brief Tablebase-optimal move at the root, or a null move.
+    virtual S_MOVE probe_root(const Position& pos) const = 0;
+
+    /// @brief One-line description for `info string`.
+    virtual std::string get_info() const = 0;
+};
+
+} // namespace Huginn
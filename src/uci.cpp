@@ -25,8 +25,10 @@
 #include "uci_utils.hpp"
 #include "movegen.hpp"
 #include "input_checking.hpp"
+#include "bench.hpp"
 #include <fstream>
 #include <algorithm>
+#include <random>
 
 /**
  * @brief Constructs a new UCIInterface instance and initializes the chess engine.
@@ -81,34 +83,65 @@ UCIInterface::UCIInterface() {
  * - go: Start search with specified parameters
  * - d: Debug display of current position
  * - stop: Halt current search
- * - ponderhit: Ponder mode hit confirmation
+ * - ponderhit: The expected move was played; a `go ponder` search starts its clock
  * - quit: Exit the engine
+ * - bench: Fixed-depth benchmark over the built-in position set (non-UCI)
  *
  * @note All commands are processed with error handling and optional debug output.
  */
 void UCIInterface::run() {
-    // Set stdin and stdout to unbuffered mode for immediate GUI communication
-    setvbuf(stdin, NULL, _IONBF, 0);
+    // Unbuffered stdout for immediate GUI communication. stdin can stay
+    // buffered: nothing polls the file descriptor any more (user-039), the
+    // reader thread owns the stream.
     setvbuf(stdout, NULL, _IONBF, 0);
 
+    // user-039: a dedicated thread reads stdin into a lock-free queue and
+    // raises the engine's stop flag on `stop`/`quit`; EOF arrives as `quit`.
+    // The thread is shared by every run(), so each binds its own engine's
+    // flag and unbinds it on the way out.
+    Huginn::stdin_reader.start(std::cin, &search_engine->should_stop);
+
     std::string line;
-    while (std::getline(std::cin, line)) {
-        if (!dispatch_command(line)) return;
-        // #56: commands the mid-search pump queued (position/go/setoption/...)
-        // replay in arrival order BEFORE reading stdin again — anything the GUI
-        // sent after them is still sitting in the stdin buffer, so global
-        // command order is preserved.
-        while (!pending_commands.empty()) {
-            std::string queued = std::move(pending_commands.front());
-            pending_commands.pop_front();
-            if (!dispatch_command(queued)) return;
+    while (true) {
+        // #56: commands queued while a search ran (position/go/setoption/...)
+        // replay in arrival order once it has finished, BEFORE any newer
+        // stdin line, so global command order is preserved. A replayed `go`
+        // starts a new search and the rest of the queue waits for that one.
+        if (!pending_commands.empty()) {
+            if (!searching()) {
+                std::string queued = std::move(pending_commands.front());
+                pending_commands.pop_front();
+                if (!dispatch_command(queued)) break;
+                continue;
+            }
+            // user-040: the worker finishing does not wake this thread, so
+            // keep a short timeout while something is waiting to replay.
+            if (!Huginn::stdin_reader.wait_pop_for(line, std::chrono::milliseconds(2))) continue;
+            // The line is newer than the queue, so it must not overtake it:
+            // dispatch_command() would run it directly if the search ended
+            // just now (a `go` ahead of its queued `position`). The search
+            // handler acts on stop/isready/quit and queues the rest behind.
+            if (!handle_search_input_line(line) && quit_received) break;
+            continue;
+        } else {
+            Huginn::stdin_reader.wait_pop(line);
         }
+        if (!dispatch_command(line)) break;
     }
+    // `quit` mid-search: the stop is already signalled; let the worker print
+    // its bestmove before the process exits.
+    wait_for_search();
+    Huginn::stdin_reader.bind_stop_flag(nullptr);
 }
 
 bool UCIInterface::dispatch_command(const std::string& line) {
     if (quit_received) return false;  // quit arrived mid-search: exit before anything else
     if (line.empty()) return true;
+    // user-040: the worker owns the position and engine until bestmove.
+    if (searching()) {
+        handle_search_input_line(line);
+        return !quit_received;
+    }
     auto tokens = split_string(line);
     if (tokens.empty()) return true;
     const std::string& command = tokens[0];
@@ -137,6 +170,7 @@ bool UCIInterface::dispatch_command(const std::string& line) {
         }
         else if (command == "ucinewgame") {
             position.set_startpos();
+            root_base.clear();  // user-042: next `position` rebuilds
             search_engine->reset();
             // New game: wipe cross-game state so stale entries from the previous
             // game can't be probed on a transposition (there is no TT aging yet,
@@ -204,14 +238,18 @@ bool UCIInterface::dispatch_command(const std::string& line) {
             std::cout << "eval " << cp << std::endl;
         }
         else if (command == "stop") {
-            // #56: searches are synchronous — a `stop` DURING a search is
-            // consumed by the mid-search pump, so by the time this loop sees
-            // one there is no search running and the bestmove is already out.
-            // A stale stop is ignored per protocol.
+            // #56: a `stop` DURING a search is routed to
+            // handle_search_input_line() above, so reaching here means no
+            // search is running and the bestmove is already out. A stale stop
+            // is ignored per protocol.
             if (debug_mode) std::cout << "info string stop with no search running (ignored)" << std::endl;
         }
         else if (command == "ponderhit") {
-            if (debug_mode) std::cout << "info string Ponder hit" << std::endl;
+            // A ponderhit is handled while its search runs; here it is stale.
+            if (debug_mode) std::cout << "info string ponderhit with no search running (ignored)" << std::endl;
+        }
+        else if (command == "bench") {
+            handle_bench(tokens);
         }
         else if (command == "quit") {
             return false;
@@ -220,7 +258,7 @@ bool UCIInterface::dispatch_command(const std::string& line) {
             if (debug_mode) std::cout << "info string Unknown command: " << command << std::endl;
         }
     }
-    return !quit_received;  // quit may also arrive via the mid-search pump
+    return !quit_received;  // quit may also arrive while a search runs
 }
 
 /**
@@ -244,18 +282,29 @@ void UCIInterface::send_id() {
  * - Hash: Transposition table size in MB
  * - OwnBook: Enable/disable opening book usage
  * - BookFile: Path to the opening book file
+ * - BookSeed: seed for the weighted book-move choice, 0 = random (user-050)
+ * - Ponder: GUI may send `go ponder` (user-041)
+ * - MultiPV: number of best root lines reported per depth (user-044)
  * - SyzygyPath: Tablebase directory (default empty = disabled)
+ * - SyzygyProbeDepth / SyzygyProbeLimit: when the search probes them (user-049)
+ * - EGTBFile: Huginn's own ≤4-man DTM tables from huginn_egtbgen (user-048)
  */
 void UCIInterface::send_options() {
     std::cout << "option name Hash type spin default 64 min 1 max 4096" << std::endl;
-    // #56: Threads and Ponder are NOT advertised — the engine is
-    // single-threaded and does not ponder; advertising them promised
-    // support that did not exist. Re-add when implemented.
+    // #56: Threads is NOT advertised — the engine is single-threaded, and
+    // advertising it promised support that did not exist.
+    // user-041: Ponder is real now (`go ponder` / `ponderhit`).
+    std::cout << "option name Ponder type check default false" << std::endl;
+    std::cout << "option name MultiPV type spin default 1 min 1 max " << Huginn::MAX_MULTI_PV << std::endl;
     std::cout << "option name OwnBook type check default false" << std::endl;
     std::cout << "option name BookFile type string default src/performance.bin" << std::endl;
+    std::cout << "option name BookSeed type spin default 0 min 0 max 2147483647" << std::endl;
     // #56: tablebases default to DISABLED — no hard-coded c:\TB\ auto-probe.
     // `<empty>` is the UCI convention for an empty string default.
     std::cout << "option name SyzygyPath type string default <empty>" << std::endl;
+    std::cout << "option name SyzygyProbeDepth type spin default 1 min 1 max 100" << std::endl;
+    std::cout << "option name SyzygyProbeLimit type spin default 7 min 0 max 7" << std::endl;
+    std::cout << "option name EGTBFile type string default <empty>" << std::endl;
 }
 
 /**
@@ -290,6 +339,12 @@ std::vector<std::string> UCIInterface::split_string(const std::string& str) {
 void UCIInterface::handle_position(const std::vector<std::string>& tokens) {
     if (tokens.size() < 2) return;
 
+    // user-042: GUIs resend the whole game every move. If this command names
+    // the committed base and only appends moves, play just the new ones.
+    size_t moves_at = 1;
+    while (moves_at < tokens.size() && tokens[moves_at] != "moves") ++moves_at;
+    if (try_extend_position(tokens, moves_at)) return;
+
     // BACKLOG #54: the whole command is transactional. Build the new root in
     // a scratch position — FEN (or startpos), structural validation, and the
     // complete move list — and commit to the live root only when EVERYTHING
@@ -366,16 +421,70 @@ void UCIInterface::handle_position(const std::vector<std::string>& tokens) {
 
     position = std::move(new_position);
 
+    root_base.clear();
+    for (size_t i = 1; i < moves_at; ++i) {
+        if (i > 1) root_base += ' ';
+        root_base += tokens[i];
+    }
+    root_moves.assign(tokens.begin() + std::min(moves_at + 1, tokens.size()), tokens.end());
+    root_key = position.zobrist_key;
+
     if (debug_mode) std::cout << "info string Position set, FEN: " << position.to_fen() << std::endl;
 }
 
+/**
+ * @brief Incremental `position` (user-042): apply only the moves appended
+ *        since the last accepted command.
+ *
+ * Taken only when the base ("startpos" / "fen ...") is textually identical,
+ * the committed move list is a prefix of the new one, and the live root
+ * still hashes to what was committed. The new moves are played on the live
+ * root and unwound on the first bad one, so the command stays all-or-nothing
+ * (BACKLOG #54) — the full rebuild would reject it at the same move, since
+ * the shared prefix was already accepted once.
+ */
+bool UCIInterface::try_extend_position(const std::vector<std::string>& tokens, size_t moves_at) {
+    if (root_base.empty() || position.zobrist_key != root_key) return false;
+
+    std::string base;
+    for (size_t i = 1; i < moves_at; ++i) {
+        if (i > 1) base += ' ';
+        base += tokens[i];
+    }
+    if (base != root_base) return false;
+
+    const size_t first_move = std::min(moves_at + 1, tokens.size());
+    if (tokens.size() - first_move < root_moves.size()) return false;  // takeback
+    if (!std::equal(root_moves.begin(), root_moves.end(), tokens.begin() + first_move)) return false;
+
+    const size_t committed = root_moves.size();
+    for (size_t i = first_move + committed; i < tokens.size(); ++i) {
+        S_MOVE move = parse_uci_move(tokens[i], position);
+        if (move.move == 0 || position.MakeMove(move) != 1) {
+            while (root_moves.size() > committed) {
+                position.TakeMove();
+                root_moves.pop_back();
+            }
+            std::cout << "info string Rejecting position command, bad move: " << tokens[i] << std::endl;
+            return true;
+        }
+        root_moves.push_back(tokens[i]);
+    }
+    root_key = position.zobrist_key;
+
+    if (debug_mode) std::cout << "info string Position set (+" << (root_moves.size() - committed)
+                              << " moves), FEN: " << position.to_fen() << std::endl;
+    return true;
+}
+
 /**
  * @brief Handles the "go" command from the UCI protocol, parsing search parameters and starting the search.
  *
  * This function interprets the tokens from a UCI "go" command, extracting search parameters such as depth, movetime,
  * time controls (wtime, btime, winc, binc, movestogo), and infinite search mode. It sets up the search limits accordingly,
  * applying logic for classical, increment, and sudden death time controls, and ensures safe time allocation.
- * After parsing and configuring the search parameters, it initiates the search for the best move.
+ * After parsing and configuring the search parameters, it hands the search to the worker thread
+ * and returns; the worker prints `bestmove` (user-040).
  *
  * @param tokens A vector of strings representing the tokenized "go" command and its parameters.
  *
@@ -387,16 +496,43 @@ void UCIInterface::handle_go(const std::vector<std::string>& tokens) {
     // BACKLOG #60 parser-purity refactor: the actual token parsing lives in
     // the pure, side-effect-free parse_go_command (uci_utils.cpp) so tests
     // can assert exact MinimalLimits results without spinning up a real
-    // search. handle_go is now just: parse, log, search.
+    // search. handle_go is now just: parse, log, start the search.
     bool infinite_requested = false;
     Huginn::MinimalLimits limits = parse_go_command(tokens, position.side_to_move, infinite_requested);
 
     if (debug_mode) {
         std::cout << "info string Final search parameters: depth=" << limits.max_depth
-                  << " time=" << limits.max_time_ms << "ms infinite=" << (limits.infinite ? "true" : "false") << std::endl;
+                  << " time=" << limits.max_time_ms << "ms infinite=" << (limits.infinite ? "true" : "false")
+                  << " nodes=" << limits.max_nodes << " mate=" << limits.mate_in
+                  << " searchmoves=" << limits.searchmoves.size() << std::endl;
     }
 
-    search_best_move(limits, infinite_requested);
+    start_search(limits, infinite_requested);
+}
+
+/**
+ * @brief Handles the non-UCI "bench" command: `bench [depth] [hash] [threads]`.
+ *
+ * BACKLOG user-026: runs the built-in position set (bench.cpp) to a fixed
+ * depth on a private, freshly constructed engine, so neither the session's TT
+ * nor its Hash setting perturbs the node-count signature. Missing or malformed
+ * arguments fall back to the defaults; valid ones are clamped to sane ranges.
+ *
+ * @param tokens ["bench", [depth], [hash_mb], [threads]]
+ */
+void UCIInterface::handle_bench(const std::vector<std::string>& tokens) {
+    long long depth = Huginn::BENCH_DEFAULT_DEPTH;
+    long long hash_mb = Huginn::BENCH_DEFAULT_HASH_MB;
+    long long threads = Huginn::BENCH_DEFAULT_THREADS;
+    if (tokens.size() > 1 && !parse_spin_clamped(tokens[1], 1, Huginn::MAX_DEPTH, depth))
+        depth = Huginn::BENCH_DEFAULT_DEPTH;
+    if (tokens.size() > 2 && !parse_spin_clamped(tokens[2], 1, 4096, hash_mb))
+        hash_mb = Huginn::BENCH_DEFAULT_HASH_MB;
+    if (tokens.size() > 3 && !parse_spin_clamped(tokens[3], 1, 1024, threads))
+        threads = Huginn::BENCH_DEFAULT_THREADS;
+
+    Huginn::run_bench(static_cast<int>(depth), static_cast<int>(hash_mb),
+                      static_cast<int>(threads), std::cout);
 }
 
 /**
@@ -453,8 +589,20 @@ void UCIInterface::handle_setoption(const std::vector<std::string>& tokens) {
                 std::cout << "info string Hash value invalid: " << option_value << std::endl;
             }
         }
-        // #56: Threads / Ponder handlers removed with their advertisements —
-        // unknown or unadvertised options are ignored per protocol.
+        // #56: Threads handler removed with its advertisement — unknown or
+        // unadvertised options are ignored per protocol.
+        else if (option_name == "Ponder") {
+            // Accepted and ignored: the GUI decides when to send `go ponder`.
+        }
+        else if (option_name == "MultiPV") {
+            // user-044: analysis lines per iteration; clamped like Hash.
+            long long lines = 1;
+            if (parse_spin_clamped(option_value, 1, Huginn::MAX_MULTI_PV, lines)) {
+                multi_pv = static_cast<int>(lines);
+            } else if (debug_mode) {
+                std::cout << "info string MultiPV value invalid: " << option_value << std::endl;
+            }
+        }
         else if (option_name == "OwnBook") {
             bool new_own_book = (option_value == "true");
             if (new_own_book != own_book) {
@@ -484,6 +632,15 @@ void UCIInterface::handle_setoption(const std::vector<std::string>& tokens) {
                 std::cout << "info string BookFile set to " << book_file << std::endl;
             }
         }
+        else if (option_name == "BookSeed") {
+            // user-050: a fixed seed makes book choices repeatable; 0 goes
+            // back to a random one. Kept across BookFile / OwnBook reloads.
+            long long seed = 0;
+            if (parse_spin_clamped(option_value, 0, 2147483647, seed) && search_engine) {
+                search_engine->opening_book.set_seed(seed ? static_cast<uint64_t>(seed)
+                                                          : std::random_device{}());
+            }
+        }
         else if (option_name == "SyzygyPath") {
             if (tablebase) {
                 // #56: `info string` feedback is unconditional — it is a
@@ -500,6 +657,33 @@ void UCIInterface::handle_setoption(const std::vector<std::string>& tokens) {
                 }
             }
         }
+        else if (option_name == "SyzygyProbeDepth" || option_name == "SyzygyProbeLimit") {
+            // user-049: probing policy, read by the search at every node
+            const bool is_depth = (option_name == "SyzygyProbeDepth");
+            long long v = 0;
+            if (parse_spin_clamped(option_value, is_depth ? 1 : 0, is_depth ? 100 : 7, v)) {
+                if (search_engine && is_depth) {
+                    search_engine->syzygy_probe_depth = static_cast<int>(v);
+                } else if (search_engine) {
+                    search_engine->syzygy_probe_limit = static_cast<int>(v);
+                }
+            } else if (debug_mode) {
+                std::cout << "info string " << option_name << " value invalid: " << option_value << std::endl;
+            }
+        }
+        else if (option_name == "EGTBFile") {
+            // user-048: same unconditional feedback as SyzygyPath
+            if (search_engine) {
+                if (option_value.empty() || option_value == "<empty>") {
+                    search_engine->endgame_tables.clear();
+                    std::cout << "info string Endgame tables disabled" << std::endl;
+                } else if (search_engine->load_endgame_tables(option_value)) {
+                    std::cout << "info string Endgame tables: " << search_engine->endgame_tables.get_info() << std::endl;
+                } else {
+                    std::cout << "info string Failed to load endgame tables from: " << option_value << std::endl;
+                }
+            }
+        }
     }
 }
 
@@ -508,28 +692,34 @@ void UCIInterface::handle_setoption(const std::vector<std::string>& tokens) {
  *
  * This function starts the chess engine's search process to find the best move
  * from the current position. It configures the search with time controls,
- * depth limits, and other parameters, then begins the search process. The
- * search runs in the background and communicates results via UCI protocol.
+ * depth limits, and other parameters, then begins the search process. Runs
+ * on the worker thread (user-040) and communicates results via UCI protocol.
  *
  * @param limits Search constraints including time controls, depth limits,
  *               and other search parameters that control how long and deep
  *               the engine should search.
  */
 void UCIInterface::search_best_move(const Huginn::MinimalLimits& limits, bool hold_for_stop) {
-    // Reset the search engine
-    search_engine->reset();
+    // The stop flag was cleared by start_search() on the command thread.
 
     // Engine uses a different search interface - searchPosition
     Huginn::SearchInfo info;
     info.max_depth = limits.max_depth;
     info.stopped = false;
     info.infinite = limits.infinite;
-
-    // #56: install the mid-search command pump. checkup() calls it when stdin
-    // has pending input: `isready` is answered without stopping, `stop`/`quit`
-    // flag this SearchInfo (on this thread — no cross-thread writes), and
-    // other commands queue for the run() loop to replay after bestmove.
-    info.on_input = [this](Huginn::SearchInfo& i) { pump_search_input(i); };
+    // user-041: a ponder search keeps its real budget (stop_time below) but
+    // ignores it until `ponderhit`; see Engine::checkup().
+    info.ponder = limits.ponder;
+    info.multi_pv = multi_pv;
+    // user-045: node budget, mate target and root restriction. searchmoves
+    // that are not legal here are dropped; if none survive, all moves are
+    // searched.
+    info.max_nodes = limits.max_nodes;
+    info.mate_in = limits.mate_in;
+    for (const std::string& text : limits.searchmoves) {
+        const S_MOVE move = parse_uci_move(text, position);
+        if (move.move != 0) info.searchmoves.push_back(move);
+    }
 
     // Convert time limits
     auto search_start = std::chrono::steady_clock::now();
@@ -600,24 +790,40 @@ void UCIInterface::search_best_move(const Huginn::MinimalLimits& limits, bool ho
     // #56: `go infinite` contract — bestmove must not be sent until the GUI
     // says stop. If the search completed on its own (mate/stalemate root, or
     // the full depth range exhausted) rather than being stopped, park here:
-    // keep answering `isready` and queueing commands until stop/quit arrives.
-    if (hold_for_stop && !info.stopped && !info.quit && !quit_received) {
-        wait_for_stop(info);
+    // the command loop keeps answering `isready` meanwhile. A ponder search
+    // is held the same way until `ponderhit` (or `stop`) — user-041.
+    const bool ponder_unresolved = limits.ponder && !search_engine->ponder_hit.load();
+    if ((hold_for_stop || ponder_unresolved) && !info.stopped && !quit_received) {
+        wait_for_stop(hold_for_stop);
     }
-    if (info.quit) quit_received = true;
 
     // Engine already outputs complete UCI info during search
     // No need for additional summary output here
 
     // Send the best move - use Engine's move_to_uci
     if (best_move.move != 0) {
-        std::string uci_move = search_engine->move_to_uci(best_move);  // Engine method
-        std::cout << "bestmove " << uci_move << std::endl;
-        std::cout.flush(); // Ensure immediate output
+        // One insertion per line: the command thread may print `readyok`
+        // concurrently, and stdout only serialises whole writes.
+        std::string line = "bestmove " + search_engine->move_to_uci(best_move);
+        // user-041: offer the PV reply to ponder on, if it is legal after
+        // the move actually played (the guard above may have substituted it).
+        if (info.ponder_move.move != 0 && best_is_legal) {
+            Position after = pre_search;
+            S_MOVELIST replies;
+            if (after.MakeMove(best_move) == 1) {
+                generate_legal_moves(after, replies);
+                for (int i = 0; i < replies.count; ++i) {
+                    if (replies.moves[i].move == info.ponder_move.move) {
+                        line += " ponder " + search_engine->move_to_uci(info.ponder_move);
+                        break;
+                    }
+                }
+            }
+        }
+        std::cout << (line + "\n") << std::flush;
     } else {
         // Last resort fallback (no legal moves at root: mate or stalemate)
-        std::cout << "bestmove 0000" << std::endl;
-        std::cout.flush(); // Ensure immediate output
+        std::cout << "bestmove 0000\n" << std::flush;
     }
 }
 
@@ -689,10 +895,10 @@ void UCIInterface::signal_stop() {
 }
 
 /**
- * @brief #56 mid-search pump: handle one command line that arrived during a
- *        search. See uci.hpp for the per-command contract.
+ * @brief #56: handle one command line that arrived during a search (command
+ *        thread). See uci.hpp for the per-command contract.
  */
-bool UCIInterface::handle_search_input_line(const std::string& line, Huginn::SearchInfo& info) {
+bool UCIInterface::handle_search_input_line(const std::string& line) {
     auto tokens = split_string(line);
     if (tokens.empty()) return true;
     const std::string& command = tokens[0];
@@ -700,71 +906,103 @@ bool UCIInterface::handle_search_input_line(const std::string& line, Huginn::Sea
     if (command == "isready") {
         // The spec is explicit: isready sent while calculating must be
         // answered immediately WITHOUT stopping the search.
-        std::cout << "readyok" << std::endl;
-        std::cout.flush();
+        std::cout << "readyok\n" << std::flush;
     }
     else if (command == "stop") {
-        info.stopped = true;
+        signal_stop();
         return false;
     }
     else if (command == "quit") {
-        info.stopped = true;
-        info.quit = true;
         quit_received = true;
+        signal_stop();
         return false;
     }
     else if (command == "debug") {
         if (tokens.size() > 1) debug_mode = (tokens[1] == "on");
     }
     else if (command == "ponderhit") {
-        // No pondering support (not advertised) — nothing to switch.
-        if (debug_mode) std::cout << "info string ponderhit ignored (no ponder)" << std::endl;
+        // user-041: the opponent played the expected move. The running
+        // search keeps everything it has and starts honouring its clock.
+        search_engine->ponderhit();
     }
     else {
         // position / go / setoption / ucinewgame / ... — NOT a reason to stop.
         // Queue for the run() loop to replay in order after bestmove.
         pending_commands.push_back(line);
-        if (debug_mode) std::cout << "info string queued during search: " << line << std::endl;
+        if (debug_mode) std::cout << ("info string queued during search: " + line + "\n") << std::flush;
     }
     return true;
 }
 
 /**
- * @brief Drain every line currently waiting on stdin through the pump.
+ * @brief Post a search job to the worker thread (user-040).
  *
- * Installed as SearchInfo::on_input; called from checkup() on the searching
- * thread whenever input_is_waiting(). Stops draining once stop/quit is seen —
- * any lines still in the stdin buffer are read by the run() loop after
- * bestmove, which drains pending_commands first, preserving arrival order.
- * EOF (GUI closed the pipe) is treated as quit.
+ * The worker is started lazily on the first `go` and lives until the
+ * destructor. search_running goes up here, before the job is visible, so the
+ * command loop routes the very next line through handle_search_input_line().
  */
-void UCIInterface::pump_search_input(Huginn::SearchInfo& info) {
-    while (Huginn::input_is_waiting()) {
-        std::string line;
-        if (!std::getline(std::cin, line)) {
-            info.stopped = true;
-            info.quit = true;
-            quit_received = true;
-            return;
-        }
-        if (!handle_search_input_line(line, info)) return;
+void UCIInterface::start_search(const Huginn::MinimalLimits& limits, bool hold_for_stop) {
+    wait_for_search();  // direct callers (tests) may post back to back
+    search_engine->reset();
+    {
+        std::lock_guard<std::mutex> lock(search_mutex);
+        if (!search_thread.joinable()) {
+            search_thread = std::thread(&UCIInterface::search_thread_loop, this);
+        }
+        job_limits = limits;
+        job_hold_for_stop = hold_for_stop;
+        job_pending = true;
+        search_running.store(true, std::memory_order_release);
+    }
+    search_cv.notify_all();
+}
+
+void UCIInterface::search_thread_loop() {
+    std::unique_lock<std::mutex> lock(search_mutex);
+    while (true) {
+        search_cv.wait(lock, [this] { return job_pending || exit_search_thread; });
+        if (exit_search_thread) return;
+        job_pending = false;
+        const Huginn::MinimalLimits limits = job_limits;
+        const bool hold_for_stop = job_hold_for_stop;
+        lock.unlock();
+
+        search_best_move(limits, hold_for_stop);
+
+        lock.lock();
+        search_running.store(false, std::memory_order_release);
+        search_cv.notify_all();
     }
 }
 
+void UCIInterface::wait_for_search() {
+    std::unique_lock<std::mutex> lock(search_mutex);
+    search_cv.wait(lock, [this] { return !search_running.load(std::memory_order_acquire); });
+}
+
+UCIInterface::~UCIInterface() {
+    if (!search_thread.joinable()) return;
+    signal_stop();
+    wait_for_search();
+    {
+        std::lock_guard<std::mutex> lock(search_mutex);
+        exit_search_thread = true;
+    }
+    search_cv.notify_all();
+    search_thread.join();
+}
+
 /**
- * @brief Park after a naturally-completed `go infinite` search (#56).
+ * @brief Park after a naturally-completed `go infinite` or `go ponder` search (#56).
  *
- * The UCI infinite contract forbids sending bestmove before `stop`. Poll both
- * stdin (isready still answered, commands still queued) and the engine's
- * atomic stop flag (signal_stop from tests / another thread) until released.
+ * The UCI contract forbids sending bestmove before `stop` (or, for a ponder
+ * search, `ponderhit`). The command loop handles those lines (and the reader
+ * raises the stop flag as soon as it reads `stop`/`quit`), so the worker only
+ * has to watch the engine's atomics.
  */
-void UCIInterface::wait_for_stop(Huginn::SearchInfo& info) {
-    while (!info.stopped && !info.quit && !quit_received) {
-        if (search_engine->should_stop.load(std::memory_order_relaxed)) break;
-        if (Huginn::input_is_waiting()) {
-            pump_search_input(info);
-        } else {
-            std::this_thread::sleep_for(std::chrono::milliseconds(2));
-        }
+void UCIInterface::wait_for_stop(bool infinite) {
+    while (!search_engine->should_stop.load(std::memory_order_relaxed) && !quit_received
+           && (infinite || !search_engine->ponder_hit.load(std::memory_order_relaxed))) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
     }
 }
@@ -9,16 +9,21 @@
  * 
  * ## UCI Protocol Features
  * - **Standard Commands**: uci, isready, position, go, stop, quit
- * - **Engine Options**: Hash table size, threads, opening book settings
+ * - **Engine Options**: Hash table size, pondering, opening book settings
  * - **Search Control**: Time management, depth limits, node limits
  * - **Move Communication**: Algebraic notation move parsing and output
  * 
  * ## Implementation Details
- * - **Synchronous Search + Command Pump**: searches run on the command loop's
- *   thread; mid-search stdin is drained by a pump (#56) that answers `isready`,
- *   applies `stop`/`quit`, and queues other commands for in-order replay
+ * - **Asynchronous Search**: `go` hands the search to a persistent worker
+ *   thread, which emits `bestmove`; the command loop stays on the main thread
+ *   and keeps answering `isready`, applying `stop`/`quit`, and queueing
+ *   other commands for in-order replay once the search ends (#56, user-040)
+ * - **Stdin Reader Thread**: a dedicated thread owns stdin and feeds a
+ *   lock-free line queue, raising the engine's stop flag on `stop`/`quit`
+ *   (user-039, Huginn::StdinReader)
  * - **Thread Safety**: cancellation is a single atomic on the Engine;
- *   SearchInfo is only ever written by the searching thread
+ *   SearchInfo is only ever written by the searching thread, and the root
+ *   position / engine options are only touched while no search is running
  * - **Command Parsing**: Robust input parsing with error handling
  * - **Debug Mode**: Enhanced logging for debugging and analysis
  * 
@@ -41,8 +46,10 @@
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <deque>
 #include <memory>
+#include <mutex>
 #include "position.hpp"
 #include "movegen.hpp"
 #include "search.hpp"  // Changed from search.hpp
@@ -50,7 +57,8 @@
 
 /**
  * @brief UCI protocol front-end: owns the engine + root position, parses GUI
- *        commands from stdin, and drives searches (async, stoppable).
+ *        commands from stdin, and drives searches on a worker thread
+ *        (async, stoppable).
  */
 class UCIInterface {
 private:
@@ -58,15 +66,41 @@ private:
     std::unique_ptr<Huginn::Engine> search_engine;          ///< The search engine (owns the transposition table).
     std::unique_ptr<Huginn::SyzygyTablebase> tablebase;     ///< Syzygy probe wrapper (disabled until SyzygyPath is set).
     bool debug_mode = false;                                ///< Extra `info string` logging when true.
-    bool quit_received = false;                             ///< `quit` seen (possibly mid-search); run() exits after unwinding.
+    std::atomic<bool> quit_received{false};                 ///< `quit` seen (possibly mid-search); run() exits after unwinding.
     std::deque<std::string> pending_commands;               ///< Commands received mid-search, replayed in order after `bestmove` (#56).
 
+    // user-042: what the last accepted `position` command said, so a command
+    // that only appends moves (GUIs resend the whole game) replays just those.
+    std::string root_base;                                  ///< "startpos" or "fen <fields>"; empty = unknown, rebuild.
+    std::vector<std::string> root_moves;                    ///< Its move list, as sent.
+    uint64_t root_key = 0;                                  ///< position.zobrist_key when it was committed.
+
+    /// @brief Apply a `position` command that extends the committed root by
+    ///        new moves only. @return false if it is not such an extension
+    ///        (the caller then rebuilds from scratch).
+    bool try_extend_position(const std::vector<std::string>& tokens, size_t moves_at);
+
+    // user-040: persistent search worker. The command loop posts one job per
+    // `go`; the worker runs search_best_move() and prints `bestmove`.
+    std::thread search_thread;                              ///< Started on the first `go`, joined in the destructor.
+    std::mutex search_mutex;                                ///< Guards the job slot and the flags below.
+    std::condition_variable search_cv;                      ///< Wakes the worker (job/exit) and wait_for_search() (done).
+    Huginn::MinimalLimits job_limits;                       ///< Limits of the posted job.
+    bool job_hold_for_stop = false;                         ///< Posted job is `go infinite`.
+    bool job_pending = false;                               ///< A job is posted and not yet picked up.
+    bool exit_search_thread = false;                        ///< Destructor asks the worker to return.
+    std::atomic<bool> search_running{false};                ///< From start_search() until `bestmove` is out.
+
+    /// @brief Worker body: sleep until a job is posted, run it, report done.
+    void search_thread_loop();
+
     // Opening book settings
     bool own_book = false;  ///< Opening book OFF by default (set OwnBook=true to enable).
                             ///< Prevents ad-hoc UCI/analysis runs from silently playing book
                             ///< moves instead of searching; gauntlets pass OwnBook explicitly,
                             ///< so this default does not affect measured strength.
     std::string book_file = "src/performance.bin";          ///< Polyglot book path (UCI `BookFile` option).
+    int multi_pv = 1;                                       ///< UCI `MultiPV` option: root lines per iteration (user-044).
 
 public:
     /// @brief Split @p str into whitespace-separated tokens.
@@ -75,38 +109,61 @@ public:
     void handle_position(const std::vector<std::string>& tokens);
     /// @brief Handle `go ...` — parse limits / time controls and launch the search.
     void handle_go(const std::vector<std::string>& tokens);
-    /// @brief Handle `setoption name <id> value <v>` (Hash, OwnBook, BookFile, SyzygyPath).
+    /// @brief Handle `setoption name <id> value <v>` (Hash, OwnBook, BookFile, SyzygyPath, ...).
     void handle_setoption(const std::vector<std::string>& tokens);
-    /// @brief Run a search under @p limits and emit `info` lines + the final `bestmove`.
-    ///        With @p hold_for_stop (`go infinite`), a search that completes on its
-    ///        own parks in wait_for_stop() — `bestmove` is not sent until `stop`/`quit`.
+    /// @brief Handle `bench [depth] [hash] [threads]` — fixed-depth benchmark
+    ///        printing the total-node signature and NPS (non-UCI, user-026).
+    void handle_bench(const std::vector<std::string>& tokens);
+    /// @brief Run a search under @p limits and emit `info` lines + the final `bestmove`
+    ///        (worker thread). With @p hold_for_stop (`go infinite`), a search that
+    ///        completes on its own parks in wait_for_stop() — `bestmove` is not
+    ///        sent until `stop`/`quit`.
     void search_best_move(const Huginn::MinimalLimits& limits, bool hold_for_stop = false);
+    /// @brief Post a search job to the worker and return immediately (user-040).
+    ///        Clears the stop flag here, on the caller's thread, so a `stop`
+    ///        that follows `go` can never be wiped by the worker starting late.
+    void start_search(const Huginn::MinimalLimits& limits, bool hold_for_stop);
     /// @brief (Re)load the Polyglot opening book from book_file (no-op unless own_book).
     void load_opening_book();
-    /// @brief Drain every line currently waiting on stdin through
-    ///        handle_search_input_line() (installed as SearchInfo::on_input).
-    void pump_search_input(Huginn::SearchInfo& info);
-    /// @brief Park after a naturally-completed `go infinite` search: keep
-    ///        answering `isready`/queueing commands until `stop`/`quit` (or
-    ///        signal_stop()), per the UCI infinite contract (#56).
-    void wait_for_stop(Huginn::SearchInfo& info);
+    /// @brief Park after a naturally-completed `go infinite` search until
+    ///        `stop`/`quit` raises the engine's stop flag, per the UCI infinite
+    ///        contract (#56). With @p infinite false (a `go ponder` search) a
+    ///        `ponderhit` also releases it (user-041). Runs on the worker; the
+    ///        command loop keeps serving stdin.
+    void wait_for_stop(bool infinite);
 
 public:
     UCIInterface();
+    /// @brief Stops any running search and joins the worker thread.
+    ~UCIInterface();
+    UCIInterface(const UCIInterface&) = delete;
+    UCIInterface& operator=(const UCIInterface&) = delete;
 
     /// @brief Main UCI loop — read and dispatch commands from stdin until `quit`/EOF.
     void run();
     /// @brief Dispatch one full command line (the body of run()'s loop; also used
-    ///        to replay commands queued mid-search). @return false on `quit`.
+    ///        to replay commands queued mid-search). While a search is running the
+    ///        line goes to handle_search_input_line() instead. @return false on `quit`.
     bool dispatch_command(const std::string& line);
-    /// @brief #56 pump: handle ONE line that arrived while a search is running.
+    /// @brief #56: handle ONE line that arrived while a search is running.
     ///        `isready` → immediate `readyok` (search keeps going); `stop`/`quit` →
-    ///        flag @p info; `debug` applies; `ponderhit` is a no-op (no pondering);
-    ///        anything else is queued for dispatch after `bestmove`.
-    ///        @return false when pumping should cease (stop/quit seen).
-    bool handle_search_input_line(const std::string& line, Huginn::SearchInfo& info);
-    /// @brief Commands queued by the mid-search pump (test observability).
+    ///        signal_stop() (and mark quit); `debug` applies; `ponderhit` turns a
+    ///        `go ponder` search into a timed one (user-041); anything else is
+    ///        queued for dispatch after `bestmove`. @return false when the line
+    ///        stops the search.
+    bool handle_search_input_line(const std::string& line);
+    /// @brief Commands queued while a search was running (test observability).
     const std::deque<std::string>& pending() const { return pending_commands; }
+    /// @brief A search job is posted or running (`bestmove` not yet printed).
+    bool searching() const { return search_running.load(std::memory_order_acquire); }
+    /// @brief Block until the running search (if any) has printed `bestmove`.
+    void wait_for_search();
+    /// @brief The engine's stop flag is raised (tests: stop/quit routing).
+    bool stop_requested() const { return search_engine->should_stop.load(); }
+    /// @brief `quit` has been received (tests: quit routing mid-search).
+    bool quit_requested() const { return quit_received.load(); }
+    /// @brief Read-only view of the engine (tests: options reaching the search).
+    const Huginn::Engine& engine() const { return *search_engine; }
     /// @brief Read-only view of the current root position (tests: BACKLOG #54
     ///        transactionality — a rejected `position` command must not move it).
     const Position& current_position() const { return position; }
@@ -0,0 +1,76 @@
+/**
+ * @file uci_output.cpp
+ * @brief UciLine formatting (user-043). See uci_output.hpp.
+ */
+#include "uci_output.hpp"
+#include "search.hpp"  // MATE
+
+#include <algorithm>
+
+namespace Huginn {
+
+UciLine& UciLine::str(std::string_view s) noexcept {
+    const std::size_t n = std::min(s.size(), CAPACITY - 1 - len_);
+    for (std::size_t i = 0; i < n; ++i) buf_[len_ + i] = s[i];
+    len_ += n;
+    return *this;
+}
+
+UciLine& UciLine::chr(char c) noexcept {
+    if (len_ < CAPACITY - 1) buf_[len_++] = c;
+    return *this;
+}
+
+UciLine& UciLine::unum(uint64_t v) noexcept {
+    char digits[20];
+    int n = 0;
+    do {
+        digits[n++] = static_cast<char>('0' + v % 10);
+        v /= 10;
+    } while (v != 0);
+    while (n > 0) chr(digits[--n]);
+    return *this;
+}
+
+UciLine& UciLine::num(int64_t v) noexcept {
+    if (v < 0) {
+        chr('-');
+        return unum(0 - static_cast<uint64_t>(v));
+    }
+    return unum(static_cast<uint64_t>(v));
+}
+
+UciLine& UciLine::move(const S_MOVE& m) noexcept {
+    const int from = m.get_from();
+    const int to = m.get_to();
+    if (m.move == 0 || from < 0 || from >= 64 || to < 0 || to >= 64) return str("0000");
+    chr(static_cast<char>('a' + (from & 7))).chr(static_cast<char>('1' + (from >> 3)));
+    chr(static_cast<char>('a' + (to & 7))).chr(static_cast<char>('1' + (to >> 3)));
+    switch (m.get_promoted()) {
+        case PieceType::Queen:  chr('q'); break;
+        case PieceType::Rook:   chr('r'); break;
+        case PieceType::Bishop: chr('b'); break;
+        case PieceType::Knight: chr('n'); break;
+        default: break;
+    }
+    return *this;
+}
+
+// Same mapping Engine::format_uci_score has always used (it now delegates
+// here): mate distances are converted from plies to moves, rounding up.
+UciLine& UciLine::score(int score) noexcept {
+    if (score > MATE - 100) return str("mate ").num((MATE - score + 1) / 2);
+    if (score < -MATE + 100) return str("mate -").num((MATE + score + 1) / 2);
+    return str("cp ").num(score);
+}
+
+void UciLine::emit(std::ostream& os) noexcept {
+    buf_[len_++] = '\n';  // CAPACITY - 1 reserved for it
+    if (std::streambuf* sb = os.rdbuf()) {
+        sb->sputn(buf_, static_cast<std::streamsize>(len_));
+        sb->pubsync();
+    }
+    len_ = 0;
+}
+
+} // namespace Huginn
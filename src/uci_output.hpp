@@ -0,0 +1,85 @@
+/**
+ * @file uci_output.hpp
+ * @brief Allocation-free formatting of UCI `info` lines (user-043).
+ *
+ * The search used to build every `info` line with `std::cout << ...` pieces,
+ * ending in std::endl, and formatted each PV move through a temporary
+ * std::string. UciLine formats into a fixed buffer that lives with the
+ * caller, and emit() hands the whole line to the stream buffer in ONE
+ * sputn(). With the UCI loop's unbuffered stdout that is a single write(2),
+ * so a line can never be split by the command thread's `readyok` (user-040).
+ * Going through std::cout's streambuf rather than fd 1 keeps test capture
+ * (rdbuf swaps) and bench's null sink working.
+ *
+ * InfoThrottle decides which lines are worth printing: per-iteration lines
+ * at most every INFO_INTERVAL_MS (the search's last completed iteration is
+ * always printed by the caller), and `currmove` only once the search has run
+ * CURRMOVE_AFTER_MS.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "move.hpp"
+
+namespace Huginn {
+
+/**
+ * @brief One UCI output line, formatted in place.
+ *
+ * Appends past CAPACITY are dropped rather than overflowing; the longest
+ * real line (32-move PV plus the standard fields) is well under 512 bytes.
+ */
+class UciLine {
+public:
+    static constexpr std::size_t CAPACITY = 1024;
+
+    UciLine& str(std::string_view s) noexcept;
+    UciLine& chr(char c) noexcept;
+    UciLine& num(int64_t v) noexcept;
+    UciLine& unum(uint64_t v) noexcept;
+    /// @brief Long-algebraic move ("e2e4", "e7e8q"); "0000" for the null move.
+    UciLine& move(const S_MOVE& m) noexcept;
+    /// @brief "cp <x>" or "mate <±moves>" for a side-to-move search score.
+    UciLine& score(int score) noexcept;
+
+    void clear() noexcept { len_ = 0; }
+    bool empty() const noexcept { return len_ == 0; }
+    std::string_view view() const noexcept { return {buf_, len_}; }
+
+    /// @brief Terminate with '\n', hand the line to @p os in one sputn(),
+    ///        then sync and clear.
+    void emit(std::ostream& os = std::cout) noexcept;
+
+private:
+    char buf_[CAPACITY];
+    std::size_t len_ = 0;
+};
+
+/**
+ * @brief Elapsed-time gate for `info` output during one search.
+ */
+class InfoThrottle {
+public:
+    static constexpr int64_t INFO_INTERVAL_MS = 20;     ///< Min gap between iteration lines.
+    static constexpr int64_t CURRMOVE_AFTER_MS = 3000;  ///< `currmove` only in long searches.
+
+    /// @brief Start of a search: the first iteration line always goes out.
+    void reset() noexcept { last_ms_ = -INFO_INTERVAL_MS; }
+    /// @brief May an iteration line be printed at @p elapsed_ms? Records it if so.
+    bool allow_iteration(int64_t elapsed_ms) noexcept {
+        if (elapsed_ms - last_ms_ < INFO_INTERVAL_MS) return false;
+        last_ms_ = elapsed_ms;
+        return true;
+    }
+    static bool allow_currmove(int64_t elapsed_ms) noexcept { return elapsed_ms >= CURRMOVE_AFTER_MS; }
+
+private:
+    int64_t last_ms_ = -INFO_INTERVAL_MS;
+};
+
+} // namespace Huginn
@@ -6,6 +6,7 @@
 #include "position.hpp"
 #include "move.hpp"
 #include <algorithm>
+#include <charconv>
 
 /**
  * @brief Parses a UCI move string and returns the corresponding legal move.
@@ -14,13 +15,20 @@
  * and attempts to find the corresponding legal move in the given chess position.
  * If the move is not legal or the notation is invalid, an empty S_MOVE is returned.
  *
+ * user-042: the encoding (capture, en passant, double push, castle and
+ * promotion flags) is derived from the board, checked with
+ * Position::is_pseudo_legal() — which accepts exactly what the generator
+ * would emit — and then tried with MakeMove/TakeMove for king safety. No
+ * move list is generated, so replaying a long `position ... moves` costs
+ * O(moves) instead of O(moves x legal generation).
+ *
  * @param uci_move The move in UCI notation as a string.
  * @param position The current chess position.
  * @return S_MOVE The corresponding legal move if found; otherwise, an empty S_MOVE.
  */
 
 S_MOVE parse_uci_move(const std::string& uci_move, const Position& position) {
-	if (uci_move.length() < 4) return S_MOVE();
+	if (uci_move.length() < 4 || uci_move.length() > 5) return S_MOVE();
 	int from_file = uci_move[0] - 'a';
 	int from_rank = uci_move[1] - '1';
 	if (from_file < 0 || from_file > 7 || from_rank < 0 || from_rank > 7) return S_MOVE();
@@ -40,19 +48,37 @@ S_MOVE parse_uci_move(const std::string& uci_move, const Position& position) {
 			default: return S_MOVE();
 		}
 	}
-	S_MOVELIST move_list;
-	generate_legal_moves(const_cast<Position&>(position), move_list);
-	for (int i = 0; i < move_list.count; ++i) {
-		const S_MOVE& move = move_list.moves[i];
-		if (move.get_from() == from && move.get_to() == to) {
-			if (promoted != PieceType::None) {
-				if (move.get_promoted() == promoted) return move;
-			} else if (move.get_promoted() == PieceType::None) {
-				return move;
-			}
-		}
+
+	const Piece mover = position.at_sq64(from);
+	if (mover == Piece::None) return S_MOVE();
+	const Piece target = position.at_sq64(to);
+	const PieceType captured = (target == Piece::None) ? PieceType::None : type_of(target);
+
+	S_MOVE move;
+	if (type_of(mover) == PieceType::King && (to - from == 2 || from - to == 2)) {
+		move = make_castle(from, to);
+	} else if (type_of(mover) == PieceType::Pawn && to == position.ep_square && target == Piece::None
+	           && from_file != to_file) {
+		move = make_en_passant(from, to);
+	} else if (type_of(mover) == PieceType::Pawn && (to - from == 16 || from - to == 16)) {
+		move = make_pawn_start(from, to);
+	} else if (promoted != PieceType::None) {
+		move = make_promotion(from, to, promoted, captured);
+	} else if (captured != PieceType::None) {
+		move = make_capture(from, to, captured);
+	} else {
+		move = make_move(from, to);
 	}
-	return S_MOVE();
+	// A promotion suffix on anything else (or a pawn reaching the last rank
+	// without one) is not an encoding the generator emits.
+	if (promoted != PieceType::None && move.get_promoted() != promoted) return S_MOVE();
+	if (!position.is_pseudo_legal(move)) return S_MOVE();
+
+	// King safety, same make/unmake the legal generator uses per move.
+	Position& pos = const_cast<Position&>(position);
+	if (pos.MakeMove(move) != 1) return S_MOVE();
+	pos.TakeMove();
+	return move;
 }
 
 // BACKLOG #54: structural / legal-position gate for the UCI boundary.
@@ -174,6 +200,17 @@ Huginn::MinimalLimits parse_go_command(const std::vector<std::string>& tokens,
 		out = v;
 		return true;
 	};
+	// user-045: `searchmoves` runs to the next keyword, so every `go`
+	// keyword has to be known here.
+	auto is_go_keyword = [](const std::string& t) {
+		static const char* const KEYWORDS[] = {
+			"searchmoves", "ponder", "wtime", "btime", "winc", "binc", "movestogo",
+			"depth", "nodes", "mate", "movetime", "infinite"};
+		for (const char* k : KEYWORDS) {
+			if (t == k) return true;
+		}
+		return false;
+	};
 
 	for (size_t i = 1; i < tokens.size(); i++) {
 		if (tokens[i] == "depth") {
@@ -189,6 +226,31 @@ Huginn::MinimalLimits parse_go_command(const std::vector<std::string>& tokens,
 		else if (tokens[i] == "winc")      parse_go_number(i, 0, GO_TIME_MAX_MS, winc);
 		else if (tokens[i] == "binc")      parse_go_number(i, 0, GO_TIME_MAX_MS, binc);
 		else if (tokens[i] == "movestogo") parse_go_number(i, 1, 500, movestogo);
+		else if (tokens[i] == "nodes") {
+			// user-045: full 64-bit range (parse_spin_clamped saturates at
+			// 1e9, which a long analysis can exceed). Junk or 0 = no limit.
+			if (i + 1 < tokens.size()) {
+				const std::string& s = tokens[++i];
+				uint64_t v = 0;
+				const auto res = std::from_chars(s.data(), s.data() + s.size(), v);
+				if (res.ec == std::errc() && res.ptr == s.data() + s.size()) limits.max_nodes = v;
+			}
+		}
+		else if (tokens[i] == "mate") {
+			long long moves = 0;
+			if (parse_go_number(i, 1, Huginn::MAX_DEPTH / 2, moves)) limits.mate_in = static_cast<int>(moves);
+		}
+		else if (tokens[i] == "searchmoves") {
+			// Kept as text: legality needs the position (UCIInterface resolves them).
+			while (i + 1 < tokens.size() && !is_go_keyword(tokens[i + 1])) {
+				limits.searchmoves.push_back(tokens[++i]);
+			}
+		}
+		else if (tokens[i] == "ponder") {
+			// user-041: clocks are parsed as usual; the budget is held back
+			// until `ponderhit` (Engine::checkup).
+			limits.ponder = true;
+		}
 		else if (tokens[i] == "infinite") {
 			limits.infinite = true;
 			infinite_requested = true;
@@ -217,6 +279,13 @@ Huginn::MinimalLimits parse_go_command(const std::vector<std::string>& tokens,
 		const long long side_inc = white_to_move ? winc : binc;
 		limits.max_time_ms = static_cast<int>(compute_time_budget_ms(side_time, side_inc, movestogo));
 	}
+	else if (!limits.infinite && (limits.max_nodes > 0 || limits.mate_in > 0)) {
+		// user-045: `go nodes` / `go mate` alone are not timed — the node
+		// budget or the proven mate ends the search, like `depth` does.
+		limits.infinite = true;
+		limits.max_time_ms = 0;
+		limits.max_depth = Huginn::MAX_DEPTH;
+	}
 	else if (!limits.infinite) {
 		// Bare `go` with no limits at all: a defined default budget.
 		limits.max_time_ms = 5000;
@@ -10,7 +10,8 @@
 #include <vector>
 
 /// @brief Parse a UCI move string (e.g. "e2e4", "e7e8q") against @p position
-///        into a fully-flagged S_MOVE by matching it to a generated legal move.
+///        into a fully-flagged S_MOVE, exactly the legal move the generator
+///        would produce (built from the board, no list generated; user-042).
 /// @param uci_move Long-algebraic move text.
 /// @param position The position the move applies to (for flags / legality match).
 /// @return The matching S_MOVE, or a null move (move == 0) if no legal move matches.
@@ -66,7 +67,9 @@ long long compute_time_budget_ms(long long time_ms, long long inc_ms, long long
 ///             token was present — distinct from the returned limits'
 ///             `infinite` flag, which is also set for a depth-only search.
 /// @return The computed MinimalLimits (mirrors the precedence `handle_go`
-///         used: depth > movetime > clock-based > bare-`go` default).
+///         used: depth > movetime > clock-based > nodes/mate (untimed) >
+///         bare-`go` default). `nodes` and `mate` also apply alongside any
+///         of the others; `searchmoves` is returned unresolved (user-045).
 Huginn::MinimalLimits parse_go_command(const std::vector<std::string>& tokens,
                                         Color side_to_move,
                                         bool& infinite_requested);
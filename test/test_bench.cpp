@@ -0,0 +1,57 @@
+/**
+ * @file test_bench.cpp
+ * @brief Guards for the built-in `bench` command (user-026): every bench
+ *        position must be a legal, searchable root, and the node-count
+ *        signature must be reproducible run to run.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../src/bench.hpp"
+#include "../src/init.hpp"
+#include "../src/position.hpp"
+#include "../src/uci_utils.hpp"
+
+#include <set>
+#include <sstream>
+
+using namespace Huginn;
+
+namespace {
+
+class BenchTest : public ::testing::Test {
+protected:
+    void SetUp() override { Huginn::init(); }
+};
+
+TEST_F(BenchTest, PositionSetIsLegalAndDistinct) {
+    const auto& fens = bench_positions();
+    EXPECT_GE(fens.size(), 50u);
+
+    std::set<std::string> seen;
+    for (const auto& fen : fens) {
+        Position pos;
+        ASSERT_TRUE(pos.set_from_fen(fen)) << fen;
+        std::string why;
+        EXPECT_TRUE(validate_uci_position(pos, &why)) << fen << " (" << why << ")";
+        EXPECT_TRUE(seen.insert(fen).second) << "duplicate bench FEN: " << fen;
+    }
+}
+
+// The whole point of bench: identical input -> identical node count. Each
+// run builds its own engine and resets per position, so two runs must agree
+// exactly (a mismatch means state leaks between searches or positions).
+TEST_F(BenchTest, SignatureIsDeterministic) {
+    std::ostringstream first_out, second_out;
+    BenchResult first = run_bench(4, 4, 1, first_out);
+    BenchResult second = run_bench(4, 4, 1, second_out);
+
+    EXPECT_EQ(first.positions, static_cast<int>(bench_positions().size()));
+    EXPECT_GT(first.nodes, 0u);
+    EXPECT_EQ(first.nodes, second.nodes);
+    EXPECT_NE(first_out.str().find("Nodes searched  : " + std::to_string(first.nodes)),
+              std::string::npos);
+    EXPECT_NE(first_out.str().find("Nodes/second"), std::string::npos);
+}
+
+} // namespace
@@ -0,0 +1,152 @@
+// user-047: huginn_bookgen's PGN reader, SAN resolver and book aggregation.
+//
+// SAN must resolve castling, en passant, promotions and disambiguated moves;
+// the tokenizer must skip comments, variations, NAGs and move numbers; and
+// games added from several threads must aggregate into a book that
+// PolyglotBook::load_book accepts in key order, with Polyglot make-book weights.
+
+#include <gtest/gtest.h>
+
+#include "../src/init.hpp"
+#include "../src/polyglot_book.hpp"
+#include "../src/position.hpp"
+#include "../tools/bookgen/book_builder.hpp"
+#include "../tools/bookgen/pgn.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Huginn;
+using namespace Huginn::BookGen;
+
+namespace {
+
+std::string play(const char* fen, const char* san) {
+    Position pos;
+    EXPECT_TRUE(pos.set_from_fen(fen));
+    const S_MOVE m = play_san(pos, san);
+    return m.move ? m.to_string() : "none";
+}
+
+std::vector<std::string> tokens(std::string_view movetext) {
+    std::vector<std::string> out;
+    SanTokenizer tok(movetext);
+    std::string_view san;
+    while (tok.next(san)) out.emplace_back(san);
+    return out;
+}
+
+} // namespace
+
+TEST(BookGen, SanResolvesSpecialMoves) {
+    Huginn::init();
+    const char* castles = "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1";
+    EXPECT_EQ(play(castles, "O-O"), "e1g1");
+    EXPECT_EQ(play(castles, "O-O-O+"), "e1c1");
+    EXPECT_EQ(play(castles, "0-0"), "e1g1");
+
+    EXPECT_EQ(play("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 2", "exd6"), "e5d6");
+    EXPECT_EQ(play("3r3k/4P3/8/8/8/8/8/4K3 w - - 0 1", "e8=Q+"), "e7e8q");
+    EXPECT_EQ(play("3r3k/4P3/8/8/8/8/8/4K3 w - - 0 1", "exd8N"), "e7d8n");
+
+    // Both knights reach d2; both rooks reach a3
+    const char* twins = "4k3/8/8/8/8/R7/8/RN2KN2 w - - 0 1";
+    EXPECT_EQ(play(twins, "Nbd2"), "b1d2");
+    EXPECT_EQ(play(twins, "Nfd2"), "f1d2");
+    EXPECT_EQ(play("4k3/8/8/8/R7/8/8/R3K3 w - - 0 1", "R1a3"), "a1a3");
+    EXPECT_EQ(play("4k3/8/8/8/R7/8/8/R3K3 w - - 0 1", "R4a3!?"), "a4a3");
+
+    // Pinned knight: Nd2 names no legal move, and the position is untouched
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen("4k3/4r3/8/8/8/8/4N3/4K3 w - - 0 1"));
+    const uint64_t key = pos.zobrist_key;
+    EXPECT_EQ(play_san(pos, "Nc3").move, 0);
+    EXPECT_EQ(play_san(pos, "Qd1").move, 0);
+    EXPECT_EQ(pos.zobrist_key, key);
+}
+
+TEST(BookGen, TokenizerSkipsAnnotations) {
+    EXPECT_EQ(tokens("1. e4 {a (comment)} e5 (1... c5 2. Nf3 {x} (2. c3 d5)) 2. Nf3 $1 Nc6; rest\n"
+                     "3.Bb5 a6 4... 0-0 1-0 5. Bxc6"),
+              (std::vector<std::string>{"e4", "e5", "Nf3", "Nc6", "Bb5", "a6", "0-0"}));
+    EXPECT_EQ(tokens("*"), std::vector<std::string>{});
+}
+
+TEST(BookGen, ReaderSplitsGames) {
+    const std::string pgn =
+        "[Event \"a\"]\n[Result \"1-0\"]\n\n1. e4 1-0\n\n"
+        "[Event \"b\"]\n[Result \"0-1\"]\n[FEN \"4k3/8/8/8/8/8/8/4K3 w - - 0 1\"]\n\n1. Kd1 *\n";
+    PgnReader reader(pgn);
+    PgnGame game;
+    ASSERT_TRUE(reader.next(game));
+    EXPECT_EQ(game.result, GameResult::WhiteWin);
+    EXPECT_TRUE(game.fen.empty());
+    ASSERT_TRUE(reader.next(game));
+    EXPECT_EQ(game.result, GameResult::BlackWin);
+    EXPECT_EQ(game.fen, "4k3/8/8/8/8/8/8/4K3 w - - 0 1");
+    EXPECT_FALSE(reader.next(game));
+
+    EXPECT_EQ(complete_games_prefix(pgn), pgn.find("[Event \"b\"]"));
+}
+
+TEST(BookGen, BuildsLoadableBookAcrossThreads) {
+    Huginn::init();
+    const std::string first_half =
+        "[Event \"1\"]\n[Result \"1-0\"]\n\n1. e4 e5 2. Nf3 1-0\n\n"
+        "[Event \"2\"]\n[Result \"1/2-1/2\"]\n\n1. e4 {book} e5 2. Nf3 1/2-1/2\n\n";
+    const std::string second_half =
+        "[Event \"3\"]\n[Result \"0-1\"]\n\n1. e4 c5 0-1\n\n"
+        "[Event \"4\"]\n[Result \"1-0\"]\n\n1. d4 d5 1-0\n\n"
+        "[Event \"5\"]\n[Result \"*\"]\n\n1. e4 e5 *\n\n"
+        "[Event \"6\"]\n[Result \"1-0\"]\n\n1. e4 Ke7?? 1-0\n";
+
+    BookGenOptions options;
+    options.min_games = 2;
+    BookBuilder builder(options);
+    std::thread a([&] { builder.add_games(first_half); });
+    std::thread b([&] { builder.add_games(second_half); });
+    a.join();
+    b.join();
+
+    EXPECT_EQ(builder.games(), 6u);
+    EXPECT_EQ(builder.skipped(), 2u);    // unknown result; illegal Ke7
+    EXPECT_EQ(builder.positions(), 10u);
+
+    // e4 (W1 D1 L1 -> 3), e4 e5 (black: D1 L1 -> 1), Nf3 (W1 D1 -> 3);
+    // d4 and c5 were seen once, below min_games
+    const auto entries = builder.finish();
+    ASSERT_EQ(entries.size(), 3u);
+    for (std::size_t i = 1; i < entries.size(); ++i) EXPECT_LT(entries[i - 1].key, entries[i].key);
+
+    const std::string path = (std::filesystem::temp_directory_path() / "huginn_bookgen_test.bin").string();
+    ASSERT_TRUE(BookBuilder::write(path, entries));
+    PolyglotBook book;
+    ASSERT_TRUE(book.load_book(path));
+    EXPECT_TRUE(book.verify_key_order());
+    EXPECT_EQ(book.size(), 3u);
+
+    Position pos;
+    pos.set_startpos();
+    EXPECT_EQ(book.get_book_move(pos).to_string(), "e2e4");
+    ASSERT_NE(play_san(pos, "e4").move, 0);
+    EXPECT_EQ(book.get_book_move(pos).to_string(), "e7e5");
+    ASSERT_NE(play_san(pos, "e5").move, 0);
+    const uint64_t key = book.get_polyglot_key(pos);
+    for (std::size_t i = 0; i < book.size(); ++i) {
+        if (book.entry_at(i).key == key) EXPECT_EQ(book.entry_at(i).weight, 3);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(BookGen, PolyglotCastleEncoding) {
+    // Castling is stored king-takes-rook: e1g1 -> e1h1, e8c8 -> e8a8
+    EXPECT_EQ(PolyglotBook::move_to_polyglot(S_MOVE(4, 6, PieceType::None, false, false, PieceType::None, true)),
+              7 | (4 << 6));
+    EXPECT_EQ(PolyglotBook::move_to_polyglot(S_MOVE(60, 58, PieceType::None, false, false, PieceType::None, true)),
+              56 | (60 << 6));
+    EXPECT_EQ(PolyglotBook::move_to_polyglot(S_MOVE(52, 60, PieceType::None, false, false, PieceType::Queen)),
+              60 | (52 << 6) | (4 << 12));
+}
@@ -0,0 +1,157 @@
+// user-035 cuckoo upcoming-repetition detection: the reversible-move key
+// table (src/cuckoo.hpp) and Cuckoo::upcoming_repetition, which reports a
+// move that would complete a threefold. The AlphaBeta hook
+// (ENABLE_UPCOMING_REPETITION) is exercised on both arms by the integrity
+// tests at the bottom.
+
+#include <gtest/gtest.h>
+
+#include "../src/cuckoo.hpp"
+#include "../src/init.hpp"
+#include "../src/search.hpp"
+#include "../src/uci_utils.hpp"
+#include "../src/zobrist.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace Huginn;
+
+namespace {
+
+void play(Position& pos, const std::vector<std::string>& moves) {
+    for (const auto& uci : moves) {
+        S_MOVE m = parse_uci_move(uci, pos);
+        ASSERT_NE(m.move, 0) << "move not legal: " << uci;
+        ASSERT_EQ(pos.MakeMove(m), 1) << "move rejected: " << uci;
+    }
+}
+
+// A position whose history is given directly as keys (oldest first), for
+// geometries no legal move sequence can set up cheaply.
+Position with_history(const std::string& fen, const std::vector<uint64_t>& keys) {
+    Position pos;
+    EXPECT_TRUE(pos.set_from_fen(fen));
+    pos.move_history.resize(keys.size());
+    for (size_t k = 0; k < keys.size(); ++k) {
+        pos.move_history[k].zobrist_key = keys[k];
+        pos.move_history[k].move.move = 1;   // any non-null move
+    }
+    pos.ply = static_cast<int>(keys.size());
+    pos.halfmove_clock = static_cast<uint16_t>(keys.size());
+    return pos;
+}
+
+uint64_t key_of(const std::string& fen) {
+    Position pos;
+    EXPECT_TRUE(pos.set_from_fen(fen));
+    return pos.zobrist_key;
+}
+
+}  // namespace
+
+TEST(Cuckoo, TableHoldsEveryReversibleMove) {
+    Huginn::init();
+    int filled = 0;
+    for (int i = 0; i < Cuckoo::SIZE; ++i) filled += Cuckoo::Keys[i] != 0;
+    EXPECT_EQ(filled, Cuckoo::REVERSIBLE_MOVE_COUNT);
+
+    // White knight g1 <-> f3, either direction (row 2 = White Knight).
+    const uint64_t knight = Zobrist::Piece[2][6] ^ Zobrist::Piece[2][21] ^ Zobrist::Side;
+    const int slot = Cuckoo::find(knight);
+    ASSERT_GE(slot, 0);
+    EXPECT_EQ(Cuckoo::From[slot], 6);
+    EXPECT_EQ(Cuckoo::To[slot], 21);
+    EXPECT_EQ(Cuckoo::Between[slot], 0u);
+
+    // Black rook a8 <-> a4 (row 10): a7, a6, a5 lie between.
+    const uint64_t rook = Zobrist::Piece[10][56] ^ Zobrist::Piece[10][24] ^ Zobrist::Side;
+    const int rslot = Cuckoo::find(rook);
+    ASSERT_GE(rslot, 0);
+    EXPECT_EQ(Cuckoo::Between[rslot], (1ULL << 32) | (1ULL << 40) | (1ULL << 48));
+
+    // Pawn pushes are not reversible.
+    EXPECT_LT(Cuckoo::find(Zobrist::Piece[1][12] ^ Zobrist::Piece[1][20] ^ Zobrist::Side), 0);
+}
+
+// 1.Nf3 Nf6 2.Ng1 Ng8 3.Nf3 Nf6 4.Ng1: ...Ng8 recreates the start position a
+// third time.
+TEST(Cuckoo, KnightShuffleThreefoldIsUpcoming) {
+    Huginn::init();
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"));
+    play(pos, {"g1f3", "g8f6", "f3g1", "f6g8", "g1f3", "g8f6", "f3g1"});
+    EXPECT_TRUE(Cuckoo::upcoming_repetition(pos));
+}
+
+// After 1.Nf3 Nf6 2.Ng1, ...Ng8 only makes a two-fold — not a draw here.
+TEST(Cuckoo, TwofoldIsNotUpcomingDraw) {
+    Huginn::init();
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"));
+    play(pos, {"g1f3", "g8f6", "f3g1"});
+    EXPECT_FALSE(Cuckoo::upcoming_repetition(pos));
+}
+
+// The key delta matches ...Ra4-a8, so only the path decides.
+TEST(Cuckoo, BlockedSliderPathIsNotUpcoming) {
+    Huginn::init();
+    const uint64_t open_target = key_of("r3k3/8/8/8/8/8/8/4K3 w - - 0 1");
+    const Position open = with_history("4k3/8/8/8/r7/8/8/4K3 b - - 0 1",
+                                       {1, 2, open_target, 3, open_target, 4, 5});
+    EXPECT_TRUE(Cuckoo::upcoming_repetition(open));
+
+    const uint64_t blocked_target = key_of("r3k3/8/p7/8/8/8/8/4K3 w - - 0 1");
+    const Position blocked = with_history("4k3/8/p7/8/r7/8/8/4K3 b - - 0 1",
+                                          {1, 2, blocked_target, 3, blocked_target, 4, 5});
+    EXPECT_FALSE(Cuckoo::upcoming_repetition(blocked));
+}
+
+// Only the side to move's pieces count: the delta is a black rook move, but
+// White is to move.
+TEST(Cuckoo, OpponentPieceIsNotUpcoming) {
+    Huginn::init();
+    const uint64_t target = key_of("r3k3/8/8/8/8/8/8/4K3 b - - 0 1");
+    const Position pos = with_history("4k3/8/8/8/r7/8/8/4K3 w - - 0 1",
+                                      {1, 2, target, 3, target, 4, 5});
+    EXPECT_FALSE(Cuckoo::upcoming_repetition(pos));
+}
+
+TEST(Cuckoo, NullMoveBreaksTheChain) {
+    Huginn::init();
+    const uint64_t target = key_of("r3k3/8/8/8/8/8/8/4K3 w - - 0 1");
+    Position pos = with_history("4k3/8/8/8/r7/8/8/4K3 b - - 0 1",
+                                {1, 2, target, 3, target, 4, 5});
+    pos.move_history[5].move.move = 0;
+    EXPECT_FALSE(Cuckoo::upcoming_repetition(pos));
+}
+
+// --- Search integrity (both arms) --------------------------------------------
+
+TEST(Cuckoo, BackRankMateSurvivesDeepSearch) {
+    Huginn::init();
+    Engine engine;
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen("6k1/5ppp/8/8/8/8/8/4R2K w - - 0 1"));
+    SearchInfo info{};
+    info.max_depth = 8;
+    info.infinite = true;
+    const S_MOVE best = engine.searchPosition(pos, info);
+    EXPECT_EQ(best.get_from(), sq64(File::E, Rank::R1));
+    EXPECT_EQ(best.get_to(), sq64(File::E, Rank::R8)) << "1.Re8# is forced";
+}
+
+#if defined(ENABLE_UPCOMING_REPETITION) && ENABLE_UPCOMING_REPETITION
+// A locked pawn fortress is all shuffling: the hook must fire.
+TEST(Cuckoo, FortressSearchHitsUpcomingRepetition) {
+    Huginn::init();
+    Engine engine;
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen("8/8/4k3/1p1p1p2/1P1P1P2/4K3/8/8 w - - 0 1"));
+    SearchInfo info{};
+    info.max_depth = 14;
+    info.infinite = true;
+    engine.searchPosition(pos, info);
+    EXPECT_GT(info.upcoming_repetitions, 0u);
+}
+#endif
@@ -0,0 +1,235 @@
+// user-048: in-tree endgame tables (huginn_egtbgen + EndgameTables).
+//
+// The 3-man tables are generated in memory once and checked against known
+// results (KQK mates in at most 10 moves, KRK in 16, KPK in 28, KBK / KNK
+// never), then against themselves: every stored value must equal a one-ply
+// look at the children through the engine's own Position and move
+// generator. The file
+// format round-trips through the mmap loader, and the search plays table
+// moves at the root and scores table hits inside the tree as exact mates.
+
+#include <gtest/gtest.h>
+
+#include "../src/endgame_tables.hpp"
+#include "../src/init.hpp"
+#include "../src/search.hpp"
+#include "../tools/egtbgen/egtb_generator.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace Huginn;
+using namespace Huginn::EgtbGen;
+
+namespace {
+
+const char* const THREE_MAN[] = {"KQK", "KRK", "KBK", "KNK", "KPK"};
+
+const Generator& three_man() {
+    static const Generator* gen = [] {
+        Huginn::init();
+        auto* g = new Generator(2);
+        for (const char* name : THREE_MAN) g->generate(name);
+        return g;
+    }();
+    return *gen;
+}
+
+EgtbResult probe_fen(const char* fen) {
+    Position pos;
+    EXPECT_TRUE(pos.set_from_fen(fen));
+    EgtbResult r{99, 99};
+    EXPECT_TRUE(three_man().tables().probe(pos, r)) << fen;
+    return r;
+}
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Every legal entry of @p name equals the best of its children, probed
+// through Position / MakeMove rather than the generator's own move code
+void expect_consistent(const char* name, uint32_t stride) {
+    const Generator& gen = three_man();
+    Egtb::TableLayout layout;
+    ASSERT_TRUE(Egtb::parse_layout(name, layout));
+    const std::vector<uint8_t>& table = gen.data(name);
+    int checked = 0;
+    for (uint32_t idx = 0; idx < layout.size; idx += stride) {
+        if (table[idx] == Egtb::ILLEGAL) continue;
+        int squares[Egtb::MAX_PIECES];
+        Color stm;
+        Egtb::decode(layout, idx, squares, stm);
+        Position pos;
+        pos.reset();
+        for (int i = 0; i < layout.count; ++i) pos.set_sq64(squares[i], layout.pieces[i]);
+        pos.side_to_move = stm;
+        pos.rebuild_counts();
+        pos.update_zobrist_key();
+
+        EgtbResult stored, searched;
+        ASSERT_TRUE(Egtb::to_result(table[idx], stored));
+        gen.tables().probe_root(pos, searched);
+        ASSERT_EQ(stored.wdl, searched.wdl) << name << " " << pos.to_fen();
+        ASSERT_EQ(stored.dtm, searched.dtm) << name << " " << pos.to_fen();
+        ++checked;
+    }
+    EXPECT_GT(checked, 1000);
+}
+
+} // namespace
+
+TEST(EndgameTables, LayoutAndNames) {
+    Egtb::TableLayout layout;
+    ASSERT_TRUE(Egtb::parse_layout("KRKN", layout));
+    EXPECT_EQ(layout.size, 10u * 64 * 64 * 64 * 2);
+    EXPECT_FALSE(layout.pawns);
+    ASSERT_TRUE(Egtb::parse_layout("KPK", layout));
+    EXPECT_EQ(layout.size, 32u * 64 * 64 * 2);
+    EXPECT_FALSE(Egtb::parse_layout("KNKR", layout)) << "weaker side first is not canonical";
+    EXPECT_FALSE(Egtb::parse_layout("KRQK", layout)) << "extras must be sorted";
+    EXPECT_FALSE(Egtb::parse_layout("KQRKR", layout)) << "five pieces";
+
+    bool swapped = false;
+    EXPECT_EQ(Egtb::canonical_name("N", "R", &swapped), "KRKN");
+    EXPECT_TRUE(swapped);
+    EXPECT_EQ(Egtb::canonical_name("PQ", "", &swapped), "KQPK");
+    EXPECT_FALSE(swapped);
+
+    EXPECT_EQ(all_tables(3).size(), 5u);
+    EXPECT_EQ(all_tables(4).size(), 35u);
+    auto deps = dependencies("KPK");
+    std::sort(deps.begin(), deps.end());
+    EXPECT_EQ(deps, (std::vector<std::string>{"KBK", "KNK", "KQK", "KRK"}));
+    deps = dependencies("KRKN");
+    std::sort(deps.begin(), deps.end());
+    EXPECT_EQ(deps, (std::vector<std::string>{"KNK", "KRK"}));
+
+    // Symmetric placements share one entry; identical pieces in either order too
+    ASSERT_TRUE(Egtb::parse_layout("KRRK", layout));
+    const int a[] = {4, 60, 0, 7}, mirrored[] = {3, 59, 7, 0}, flipped[] = {60, 4, 56, 63};
+    const uint32_t idx = Egtb::encode(layout, a, Color::White);
+    EXPECT_EQ(Egtb::encode(layout, mirrored, Color::White), idx);
+    EXPECT_EQ(Egtb::encode(layout, flipped, Color::White), idx);
+    EXPECT_NE(Egtb::encode(layout, a, Color::Black), idx);
+}
+
+TEST(EndgameTables, ThreeManResults) {
+    const Generator& gen = three_man();
+    // Longest loss, defender to move: mated in 10 / 16 / 28 moves
+    EXPECT_EQ(gen.stats("KQK").max_dtm, 20);
+    EXPECT_EQ(gen.stats("KRK").max_dtm, 32);
+    EXPECT_EQ(gen.stats("KPK").max_dtm, 56);
+    EXPECT_EQ(gen.stats("KBK").wins, 0u);
+    EXPECT_EQ(gen.stats("KNK").wins, 0u);
+    EXPECT_GT(gen.stats("KPK").wins, 0u);
+    EXPECT_GT(gen.stats("KPK").draws, 0u);
+
+    EgtbResult r = probe_fen("k7/8/1K6/8/8/8/7Q/8 w - - 0 1");
+    EXPECT_EQ(r.wdl, 1);
+    EXPECT_EQ(r.dtm, 1);  // Qh8#
+    r = probe_fen("k7/8/1K6/8/8/8/7Q/8 b - - 0 1");
+    EXPECT_EQ(r.wdl, 0);  // stalemate
+    r = probe_fen("4k3/8/4K3/4P3/8/8/8/8 w - - 0 1");
+    EXPECT_EQ(r.wdl, 1);
+    r = probe_fen("4k3/8/4K3/4P3/8/8/8/8 b - - 0 1");
+    EXPECT_EQ(r.wdl, -1);
+    r = probe_fen("k7/8/K7/P7/8/8/8/8 w - - 0 1");
+    EXPECT_EQ(r.wdl, 0);
+    // Colours reversed: black pawn, and the side to move losing
+    r = probe_fen("8/8/8/8/4p3/4k3/8/4K3 w - - 0 1");
+    EXPECT_EQ(r.wdl, -1);
+    // KK and too many pieces
+    r = probe_fen("8/8/4k3/8/8/4K3/8/8 w - - 0 1");
+    EXPECT_EQ(r.wdl, 0);
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen("k7/8/1K6/8/8/8/8/6RQ w - - 0 1"));
+    EXPECT_FALSE(gen.tables().probe(pos, r));
+}
+
+TEST(EndgameTables, ValuesMatchChildren) {
+    expect_consistent("KQK", 1);
+    expect_consistent("KRK", 1);
+    expect_consistent("KPK", 3);
+}
+
+TEST(EndgameTables, FileRoundTrip) {
+    Huginn::init();
+    const Generator& gen = three_man();
+    const std::string path = temp_path("huginn_test_3man.egtb");
+    ASSERT_TRUE(gen.write(path));
+
+    EndgameTables loaded;
+    ASSERT_TRUE(loaded.load(path));
+    EXPECT_EQ(loaded.table_count(), 5u);
+    EXPECT_EQ(loaded.max_pieces(), 3);
+    for (const char* name : THREE_MAN) {
+        Egtb::TableLayout layout;
+        ASSERT_TRUE(Egtb::parse_layout(name, layout));
+        for (uint32_t idx = 0; idx < layout.size; idx += 97) {
+            int squares[Egtb::MAX_PIECES];
+            Color stm;
+            Egtb::decode(layout, idx, squares, stm);
+            uint8_t expected = 0, actual = 0;
+            ASSERT_TRUE(gen.tables().probe_squares(layout.pieces.data(), squares, layout.count, stm, expected));
+            ASSERT_TRUE(loaded.probe_squares(layout.pieces.data(), squares, layout.count, stm, actual));
+            ASSERT_EQ(expected, actual) << name << " " << idx;
+        }
+    }
+
+    // Anything else is refused, leaving nothing loaded
+    const std::string bad = temp_path("huginn_test_bad.egtb");
+    {
+        std::ofstream out(bad, std::ios::binary);
+        out << "HGNEGTB1 not really";
+    }
+    EXPECT_FALSE(loaded.load(bad));
+    EXPECT_FALSE(loaded.is_loaded());
+    std::remove(bad.c_str());
+    std::remove(path.c_str());
+}
+
+TEST(EndgameTables, SearchUsesTables) {
+    const Generator& gen = three_man();
+    Engine engine;
+    for (const char* name : THREE_MAN) {
+        const auto& data = gen.data(name);
+        ASSERT_TRUE(engine.endgame_tables.add_table(name, data.data(), data.size()));
+    }
+
+    // Root: the table move, reported with its mate distance
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen("8/8/8/8/8/2k5/8/K6R w - - 0 1"));
+    SearchInfo info;
+    info.max_depth = 6;
+    info.infinite = true;
+    std::ostringstream captured;
+    auto* old_buf = std::cout.rdbuf(captured.rdbuf());
+    S_MOVE best = engine.searchPosition(pos, info);
+    std::cout.rdbuf(old_buf);
+    EgtbResult r;
+    const S_MOVE expected = gen.tables().probe_root(pos, r);
+    EXPECT_EQ(best.move, expected.move);
+    EXPECT_NE(captured.str().find("score mate " + std::to_string((r.dtm + 1) / 2)), std::string::npos)
+        << captured.str();
+
+    // Inside the tree: taking the pawn reaches KQK, scored as an exact mate
+    ASSERT_TRUE(pos.set_from_fen("8/8/8/3k4/8/3p4/8/1Q2K3 w - - 0 1"));
+    SearchInfo deep;
+    deep.max_depth = 4;
+    deep.infinite = true;
+    captured.str("");
+    old_buf = std::cout.rdbuf(captured.rdbuf());
+    engine.searchPosition(pos, deep);
+    std::cout.rdbuf(old_buf);
+    const std::string out = captured.str();
+    const std::size_t last = out.rfind("info depth 4");
+    ASSERT_NE(last, std::string::npos) << out;
+    const std::string line = out.substr(last, out.find('\n', last) - last);
+    EXPECT_NE(line.find("score mate "), std::string::npos) << line;
+    EXPECT_EQ(line.find("tbhits 0 "), std::string::npos) << line;
+}
@@ -2,6 +2,12 @@
 #include "input_checking.hpp"
 #include "search.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+
 namespace Huginn {
 
 class InputCheckingTest : public ::testing::Test {
@@ -60,3 +66,135 @@ TEST_F(InputCheckingTest, SearchInfoFlags) {
 }
 
 } // namespace Huginn
+
+// --- StdinReader (user-039) ---------------------------------------------------
+
+namespace Huginn {
+
+namespace {
+
+// A pipe whose writer is the test: reads block until write() or close(), so
+// the reader thread sees EOF only when the test says so.
+class PipeBuf : public std::streambuf {
+public:
+    void write(const std::string& text) {
+        { std::lock_guard<std::mutex> lock(mutex_); pending_ += text; }
+        cv_.notify_all();
+    }
+    void close() {
+        { std::lock_guard<std::mutex> lock(mutex_); closed_ = true; }
+        cv_.notify_all();
+    }
+
+protected:
+    int_type underflow() override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return !pending_.empty() || closed_; });
+        if (pending_.empty()) return traits_type::eof();
+        current_ = std::move(pending_);
+        pending_.clear();
+        setg(current_.data(), current_.data(), current_.data() + current_.size());
+        return traits_type::to_int_type(current_[0]);
+    }
+
+private:
+    std::string pending_;
+    std::string current_;  // only touched by the reading thread
+    bool closed_ = false;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+// Closes the pipe on scope exit (an ASSERT included), ahead of the reader's
+// join: declare it after the reader.
+struct CloseOnExit {
+    PipeBuf& buf;
+    ~CloseOnExit() { buf.close(); }
+};
+
+} // namespace
+
+TEST(StdinReaderTest, QueuesLinesInOrderAndEndsWithQuit) {
+    std::istringstream in("uci\nisready\nposition startpos\n");
+    StdinReader reader;
+    reader.start(in);
+    std::string line;
+    reader.wait_pop(line);
+    EXPECT_EQ(line, "uci");
+    reader.wait_pop(line);
+    EXPECT_EQ(line, "isready");
+    reader.wait_pop(line);
+    EXPECT_EQ(line, "position startpos");
+    reader.wait_pop(line);
+    EXPECT_EQ(line, "quit") << "EOF must arrive as quit";
+    EXPECT_FALSE(reader.try_pop(line));
+    EXPECT_FALSE(reader.has_pending());
+}
+
+TEST(StdinReaderTest, StopAndQuitRaiseTheStopFlag) {
+    std::atomic<bool> stop{false};
+    std::istringstream in("go infinite\n  stop\n");
+    StdinReader reader;
+    reader.start(in, &stop);
+    std::string line;
+    reader.wait_pop(line);
+    EXPECT_EQ(line, "go infinite");
+    reader.wait_pop(line);
+    EXPECT_EQ(line, "  stop") << "the line itself is still queued for the pump";
+    EXPECT_TRUE(stop.load());
+    // Drain to the EOF quit: the reader thread has ended before it is joined
+    reader.wait_pop(line);
+    EXPECT_EQ(line, "quit");
+}
+
+TEST(StdinReaderTest, OtherCommandsDoNotRaiseTheStopFlag) {
+    // The reader raises the flag at EOF, so keep the pipe open meanwhile
+    PipeBuf buf;
+    std::istream in(&buf);
+    std::atomic<bool> stop{false};
+    StdinReader reader;
+    CloseOnExit closer{buf};
+    buf.write("isready\nstopwatch\nposition startpos\n");
+    reader.start(in, &stop);
+    std::string line;
+    for (const char* expected : {"isready", "stopwatch", "position startpos"}) {
+        ASSERT_TRUE(reader.wait_pop_for(line, std::chrono::milliseconds(2000)));
+        EXPECT_EQ(line, expected);
+    }
+    EXPECT_FALSE(reader.wait_pop_for(line, std::chrono::milliseconds(20)));
+    EXPECT_FALSE(stop.load()) << "only a `stop`/`quit` command may raise the flag";
+
+    // Writer goes away: EOF ends the reader, so the destructor can join it
+    buf.close();
+    reader.wait_pop(line);
+    EXPECT_EQ(line, "quit");
+    EXPECT_TRUE(stop.load());
+}
+
+TEST(StdinReaderTest, RebindingMovesTheStopFlag) {
+    // UCIInterface::run() binds its engine's flag to the shared reader and
+    // unbinds it on exit; a flag that was re-bound away is never touched
+    PipeBuf buf;
+    std::istream in(&buf);
+    std::atomic<bool> first{false}, second{false};
+    StdinReader reader;
+    CloseOnExit closer{buf};
+    reader.start(in, &first);
+    reader.start(in, &second);  // already running: only re-binds
+    std::string line;
+    buf.write("stop\n");
+    ASSERT_TRUE(reader.wait_pop_for(line, std::chrono::milliseconds(2000)));
+    EXPECT_EQ(line, "stop");
+    EXPECT_FALSE(first.load());
+    EXPECT_TRUE(second.load());
+
+    second = false;
+    reader.bind_stop_flag(nullptr);
+    buf.close();
+    reader.wait_pop(line);
+    EXPECT_EQ(line, "quit");
+    EXPECT_FALSE(first.load());
+    EXPECT_FALSE(second.load());
+}
+
+} // namespace Huginn
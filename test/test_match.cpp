@@ -0,0 +1,304 @@
+// user-050: huginn_match — statistics, SAN / EPD / PGN plumbing, the game
+// loop's endings and the concurrent match driver.
+//
+// Games are kept to a few seconds: short clocks, endgame openings that end
+// by mate, and adjudication. The child-process test runs the huginn binary
+// built next to the test executable and is skipped when it is not there.
+
+#include <gtest/gtest.h>
+
+#include "../src/init.hpp"
+#include "../src/polyglot_keys.hpp"
+#include "../src/search.hpp"
+#include "../src/uci_utils.hpp"
+#include "../tools/match/match_runner.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+
+using namespace Huginn;
+using namespace Huginn::Match;
+
+namespace {
+
+std::string san_of(const char* fen, const char* uci) {
+    Position pos;
+    EXPECT_TRUE(pos.set_from_fen(fen));
+    const S_MOVE move = parse_uci_move(uci, pos);
+    EXPECT_NE(move.move, 0u) << uci;
+    return to_san(pos, move);
+}
+
+GameConfig quick_config() {
+    GameConfig config;
+    config.tc.base_ms = 2000;
+    config.tc.inc_ms = 20;
+    return config;
+}
+
+std::unique_ptr<Player> started(const EngineConfig& config) {
+    std::unique_ptr<Player> player = make_player(config);
+    std::string error;
+    EXPECT_TRUE(player->start(error)) << error;
+    return player;
+}
+
+std::string sibling_engine() {
+#ifdef _WIN32
+    const char* name = "huginn.exe";
+#else
+    const char* name = "huginn";
+#endif
+    std::error_code ec;
+    const auto self = std::filesystem::read_symlink("/proc/self/exe", ec);
+    if (ec) return {};
+    const auto path = self.parent_path() / name;
+    return std::filesystem::exists(path) ? path.string() : std::string();
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+// Round number -> White's first move, from a PGN file of games set up at the start
+std::map<int, std::string> first_moves(const std::string& pgn) {
+    std::map<int, std::string> moves;
+    std::istringstream in(pgn);
+    std::string line;
+    int round = 0;
+    while (std::getline(in, line)) {
+        if (line.rfind("[Round \"", 0) == 0) round = std::atoi(line.c_str() + 8);
+        else if (line.rfind("1. ", 0) == 0) moves[round] = line.substr(3, line.find(' ', 3) - 3);
+    }
+    return moves;
+}
+
+} // namespace
+
+TEST(Match, EloAndSprt) {
+    Score s{1200, 2500, 1100};
+    const EloEstimate e = estimate_elo(s);
+    EXPECT_NEAR(e.elo, 7.24, 0.01);
+    EXPECT_NEAR(e.error95, 6.80, 0.01);
+    EXPECT_NEAR(e.los, 0.9815, 0.0005);
+
+    SprtConfig config;
+    config.enabled = true;
+    config.elo0 = 0;
+    config.elo1 = 5;
+    Sprt sprt(config);
+    EXPECT_NEAR(sprt.lower_bound(), -2.944, 0.001);
+    EXPECT_NEAR(sprt.upper_bound(), 2.944, 0.001);
+    EXPECT_NEAR(sprt.llr(s), 1.968, 0.001);
+    EXPECT_EQ(sprt.decide(s), Sprt::Decision::Continue);
+
+    EXPECT_EQ(sprt.decide(Score{2400, 5000, 2200}), Sprt::Decision::AcceptH1);
+    EXPECT_EQ(sprt.decide(Score{2200, 5000, 2400}), Sprt::Decision::AcceptH0);
+    EXPECT_EQ(sprt.llr(Score{}), 0.0);
+    EXPECT_EQ(estimate_elo(Score{}).elo, 0.0);
+    EXPECT_NE(format_report(s, sprt).find("LLR 1.97 [-2.94, 2.94]"), std::string::npos) << format_report(s, sprt);
+}
+
+TEST(Match, SanEpdAndTimeControl) {
+    Huginn::init();
+    const char* start = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+    EXPECT_EQ(san_of(start, "e2e4"), "e4");
+    EXPECT_EQ(san_of(start, "g1f3"), "Nf3");
+    EXPECT_EQ(san_of("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1", "e1g1"), "O-O");
+    EXPECT_EQ(san_of("r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 0 1", "e8c8"), "O-O-O");
+    EXPECT_EQ(san_of("4k3/8/8/3p4/4P3/8/8/4K3 w - - 0 1", "e4d5"), "exd5");
+    EXPECT_EQ(san_of("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5d6"), "exd6");
+    EXPECT_EQ(san_of("8/4P3/8/8/8/8/k7/4K3 w - - 0 1", "e7e8q"), "e8=Q");
+    EXPECT_EQ(san_of("3k4/6P1/8/8/8/8/8/4K3 w - - 0 1", "g7g8r"), "g8=R+");
+    EXPECT_EQ(san_of("4k3/8/8/8/8/8/8/1N1NK3 w - - 0 1", "b1c3"), "Nbc3");
+    EXPECT_EQ(san_of("4k3/8/8/8/R7/8/8/R3K3 w - - 0 1", "a1a2"), "R1a2");
+    EXPECT_EQ(san_of("k7/8/1K6/8/8/8/8/7Q w - - 0 1", "h1h8"), "Qh8#");
+
+    std::string fen;
+    ASSERT_TRUE(parse_opening_line("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - hmvc 0; fmvn 1;", fen));
+    EXPECT_EQ(fen, "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1");
+    ASSERT_TRUE(parse_opening_line("4k3/8/8/8/8/8/8/4K2R w K - 3 40", fen));
+    EXPECT_EQ(fen, "4k3/8/8/8/8/8/8/4K2R w K - 3 40");
+    EXPECT_FALSE(parse_opening_line("", fen));
+    EXPECT_FALSE(parse_opening_line("# comment line here", fen));
+    EXPECT_FALSE(parse_opening_line("8/8/8/8/8/8/8/8 w - -", fen)) << "no kings";
+
+    TimeControl tc;
+    ASSERT_TRUE(parse_time_control("8+0.08", tc));
+    EXPECT_EQ(tc.base_ms, 8000);
+    EXPECT_EQ(tc.inc_ms, 80);
+    ASSERT_TRUE(parse_time_control("60", tc));
+    EXPECT_EQ(tc.base_ms, 60000);
+    EXPECT_EQ(tc.inc_ms, 0);
+    EXPECT_FALSE(parse_time_control("40/60", tc));
+    EXPECT_FALSE(parse_time_control("8+", tc));
+}
+
+TEST(Match, GameEndings) {
+    Huginn::init();
+    EngineConfig config;
+    config.name = "huginn";
+    auto white = started(config);
+    auto black = started(config);
+
+    // Played out to mate, and written as PGN from the set-up position
+    GameRecord game = play_game(*white, *black, "8/8/8/3k4/8/8/8/KQ6 w - - 0 1", quick_config(), "w", "b");
+    EXPECT_EQ(game.outcome, Outcome::WhiteWins) << game.reason;
+    EXPECT_EQ(game.reason, "White mates");
+    ASSERT_FALSE(game.san.empty());
+    EXPECT_EQ(game.san.back().back(), '#');
+    game.round = 1;
+    const std::string pgn = to_pgn(game, "test", quick_config().tc);
+    EXPECT_NE(pgn.find("[FEN \"8/8/8/3k4/8/8/8/KQ6 w - - 0 1\"]"), std::string::npos) << pgn;
+    EXPECT_NE(pgn.find("[Result \"1-0\"]"), std::string::npos);
+    EXPECT_NE(pgn.find("1. " + game.san[0]), std::string::npos);
+    EXPECT_NE(pgn.find("{White mates} 1-0"), std::string::npos) << pgn;
+
+    // Dead material ends the game before any move
+    game = play_game(*white, *black, "8/8/4k3/8/8/4K3/8/5B2 b - - 0 1", quick_config(), "w", "b");
+    EXPECT_EQ(game.outcome, Outcome::Draw);
+    EXPECT_TRUE(game.san.empty());
+
+    // Both engines agree White is winning: adjudicated after one move each
+    GameConfig adjudicated = quick_config();
+    adjudicated.adjudication.resign_move_count = 1;
+    adjudicated.adjudication.resign_score = 500;
+    game = play_game(*white, *black, "4k3/8/8/8/8/8/PPPP4/QQ2K3 w - - 0 1", adjudicated, "w", "b");
+    EXPECT_EQ(game.outcome, Outcome::WhiteWins);
+    EXPECT_EQ(game.termination, "adjudication");
+    EXPECT_EQ(game.san.size(), 2u);
+
+    // Draw window from move 1 and a move limit
+    GameConfig drawn = quick_config();
+    drawn.adjudication.max_moves = 3;
+    game = play_game(*white, *black, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", drawn, "w", "b");
+    EXPECT_EQ(game.outcome, Outcome::Draw);
+    EXPECT_EQ(game.reason, "Draw by move limit");
+    EXPECT_EQ(game.san.size(), 6u);
+}
+
+TEST(Match, ConcurrentMatchWritesPgn) {
+    Huginn::init();
+    MatchConfig config;
+    config.engines[0].name = "a";
+    config.engines[1].name = "b";
+    config.game = quick_config();
+    config.game.adjudication.resign_move_count = 1;
+    config.game.adjudication.resign_score = 500;
+    config.openings = {"8/8/8/3k4/8/8/8/KQ6 w - - 0 1", "4k3/8/8/8/8/8/PPPP4/QQ2K3 w - - 0 1"};
+    config.games = 4;
+    config.concurrency = 2;
+    config.report_every = 2;
+    config.pgn_path = (std::filesystem::temp_directory_path() / "huginn_test_match.pgn").string();
+    std::remove(config.pgn_path.c_str());
+
+    std::ostringstream report;
+    const MatchResult result = run_match(config, report);
+    ASSERT_TRUE(result.ok) << result.error;
+    // Every opening is won by White, so each engine wins its White game
+    EXPECT_EQ(result.score.wins, 2u);
+    EXPECT_EQ(result.score.losses, 2u);
+    EXPECT_NE(report.str().find("Games 4 (W 2 D 0 L 2)"), std::string::npos) << report.str();
+
+    const std::string text = read_file(config.pgn_path);
+    size_t games = 0;
+    for (size_t at = text.find("[Event "); at != std::string::npos; at = text.find("[Event ", at + 1)) ++games;
+    EXPECT_EQ(games, 4u);
+    std::remove(config.pgn_path.c_str());
+
+    // An engine that cannot start fails the match instead of hanging it
+    config.engines[1].options = {{"NoSuchOption", "1"}};
+    config.pgn_path.clear();
+    const MatchResult failed = run_match(config, report);
+    EXPECT_FALSE(failed.ok);
+    EXPECT_NE(failed.error.find("NoSuchOption"), std::string::npos);
+}
+
+TEST(Match, ConcurrentSlotsWithBooks) {
+    Huginn::init();
+    // Four equally weighted first moves; every in-process engine in every
+    // slot probes its own book. Game numbers, not slots, seed the choice.
+    Position start;
+    ASSERT_TRUE(start.set_from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"));
+    const uint64_t key = PolyglotKeys::compute(start);
+    std::vector<std::pair<uint16_t, const char*>> book_moves = {
+        {uint16_t((1 << 6) | 18), "Nc3"}, {uint16_t((11 << 6) | 27), "d4"},
+        {uint16_t((12 << 6) | 28), "e4"}, {uint16_t((6 << 6) | 21), "Nf3"}};
+    const std::string book_path = (std::filesystem::temp_directory_path() / "huginn_match_book.bin").string();
+    {
+        std::ofstream out(book_path, std::ios::binary | std::ios::trunc);
+        for (const auto& [move, san] : book_moves) {
+            const uint64_t fields[] = {key, move, 1, 0};
+            const int bytes[] = {8, 2, 2, 4};
+            for (int f = 0; f < 4; ++f) {
+                for (int i = bytes[f] - 1; i >= 0; --i) out.put(static_cast<char>((fields[f] >> (8 * i)) & 0xFF));
+            }
+        }
+    }
+
+    MatchConfig config;
+    for (int e = 0; e < 2; ++e) {
+        config.engines[e].name = e ? "b" : "a";
+        config.engines[e].options = {{"OwnBook", "true"}, {"BookFile", book_path}, {"BookSeed", "50"}};
+    }
+    config.game = quick_config();
+    config.game.adjudication.max_moves = 1;
+    config.games = 8;
+    config.concurrency = 2;
+    config.report_every = 0;
+    config.pgn_path = (std::filesystem::temp_directory_path() / "huginn_test_book_match.pgn").string();
+
+    std::map<int, std::string> runs[2];
+    for (auto& moves : runs) {
+        std::remove(config.pgn_path.c_str());
+        std::ostringstream report;
+        const MatchResult result = run_match(config, report);
+        ASSERT_TRUE(result.ok) << result.error;
+        moves = first_moves(read_file(config.pgn_path));
+    }
+    std::remove(config.pgn_path.c_str());
+    std::remove(book_path.c_str());
+
+    ASSERT_EQ(runs[0].size(), 8u);
+    std::set<std::string> seen;
+    for (const auto& [round, san] : runs[0]) {
+        EXPECT_TRUE(san == "Nc3" || san == "d4" || san == "e4" || san == "Nf3") << round << ": " << san;
+        seen.insert(san);
+    }
+    EXPECT_GT(seen.size(), 1u) << "every game seeded alike";
+    EXPECT_EQ(runs[0], runs[1]) << "same BookSeed, different book moves";
+}
+
+TEST(Match, ChildProcessEngine) {
+    Huginn::init();
+    const std::string path = sibling_engine();
+    if (path.empty()) GTEST_SKIP() << "huginn binary not built next to the tests";
+
+    EngineConfig process;
+    process.name = "child";
+    process.command = path;
+    process.options = {{"Hash", "8"}};
+    EngineConfig in_process;
+    in_process.name = "in-process";
+    auto white = started(process);
+    auto black = started(in_process);
+    const GameRecord game = play_game(*white, *black, "8/8/8/3k4/8/8/8/KQ6 w - - 0 1", quick_config(),
+                                      "child", "in-process");
+    EXPECT_EQ(game.outcome, Outcome::WhiteWins) << game.reason;
+    EXPECT_EQ(game.reason, "White mates");
+
+    EngineConfig missing;
+    missing.name = "missing";
+    missing.command = path + "-does-not-exist";
+    std::string error;
+    EXPECT_FALSE(make_player(missing)->start(error));
+    EXPECT_FALSE(error.empty());
+}
@@ -0,0 +1,148 @@
+// user-044: MultiPV analysis mode.
+//
+// Each iteration reports the best `MultiPV` root lines, best first, with
+// distinct root moves; `bestmove` is line 1; a root with fewer legal moves
+// than requested lines reports only what exists; and the UCI option reaches
+// the search.
+
+#include <gtest/gtest.h>
+
+#include "../src/init.hpp"
+#include "../src/search.hpp"
+#include "../src/uci.hpp"
+
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct InfoLine {
+    int depth = 0;
+    int multipv = 0;
+    std::string score;      // "cp 25" / "mate 1"
+    int cp = 0;
+    std::string first_move;
+};
+
+std::vector<InfoLine> parse_pv_lines(const std::string& text) {
+    std::vector<InfoLine> out;
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.rfind("info depth ", 0) != 0 || line.find(" pv ") == std::string::npos) continue;
+        std::istringstream iss(line);
+        std::vector<std::string> t;
+        std::string tok;
+        while (iss >> tok) t.push_back(tok);
+        InfoLine info;
+        for (size_t i = 0; i + 1 < t.size(); ++i) {
+            if (t[i] == "depth") info.depth = std::stoi(t[i + 1]);
+            else if (t[i] == "multipv") info.multipv = std::stoi(t[i + 1]);
+            else if (t[i] == "score" && i + 2 < t.size()) {
+                info.score = t[i + 1] + " " + t[i + 2];
+                if (t[i + 1] == "cp") info.cp = std::stoi(t[i + 2]);
+            }
+            else if (t[i] == "pv") info.first_move = t[i + 1];
+        }
+        out.push_back(info);
+    }
+    return out;
+}
+
+std::vector<InfoLine> lines_at_depth(const std::vector<InfoLine>& all, int depth) {
+    std::vector<InfoLine> out;
+    for (const auto& l : all) {
+        if (l.depth == depth) out.push_back(l);
+    }
+    return out;
+}
+
+std::string search_captured(Position& pos, int depth, int multi_pv, S_MOVE& best) {
+    Huginn::Engine engine;
+    Huginn::SearchInfo info;
+    info.max_depth = depth;
+    info.infinite = true;
+    info.multi_pv = multi_pv;
+
+    std::ostringstream captured;
+    auto* old_buf = std::cout.rdbuf(captured.rdbuf());
+    best = engine.searchPosition(pos, info);
+    std::cout.rdbuf(old_buf);
+    return captured.str();
+}
+
+} // namespace
+
+TEST(MultiPV, ReportsDistinctLinesBestFirst) {
+    Huginn::init();
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen("r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3"));
+
+    S_MOVE best;
+    const std::string out = search_captured(pos, 6, 4, best);
+    const auto last = lines_at_depth(parse_pv_lines(out), 6);
+
+    ASSERT_EQ(last.size(), 4u) << out;
+    std::set<std::string> roots;
+    for (size_t k = 0; k < last.size(); ++k) {
+        EXPECT_EQ(last[k].multipv, static_cast<int>(k + 1));
+        roots.insert(last[k].first_move);
+        if (k > 0) EXPECT_LE(last[k].cp, last[k - 1].cp) << "lines not best-first:\n" << out;
+    }
+    EXPECT_EQ(roots.size(), 4u) << "a root move was reported twice:\n" << out;
+    EXPECT_EQ(Huginn::Engine::move_to_uci(best), last[0].first_move);
+}
+
+TEST(MultiPV, FewerLegalMovesThanLines) {
+    Huginn::init();
+    Position pos;
+    // Black king in the corner, checked by a loose rook: Kxg8 and Kh7 only.
+    ASSERT_TRUE(pos.set_from_fen("6Rk/8/8/8/8/8/8/K7 b - - 0 1"));
+
+    S_MOVE best;
+    const std::string out = search_captured(pos, 4, 5, best);
+    const auto last = lines_at_depth(parse_pv_lines(out), 4);
+
+    ASSERT_EQ(last.size(), 2u) << out;
+    EXPECT_EQ(last[0].first_move, "h8g8");
+    EXPECT_EQ(last[1].first_move, "h8h7");
+    EXPECT_EQ(Huginn::Engine::move_to_uci(best), "h8g8");
+}
+
+TEST(MultiPV, MateStaysLineOne) {
+    Huginn::init();
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1"));
+
+    S_MOVE best;
+    const std::string out = search_captured(pos, 4, 3, best);
+    const auto last = lines_at_depth(parse_pv_lines(out), 4);
+
+    ASSERT_EQ(last.size(), 3u) << out;
+    EXPECT_EQ(last[0].score, "mate 1");
+    EXPECT_EQ(last[0].first_move, "a1a8");
+    EXPECT_NE(last[1].score, "mate 1");
+    EXPECT_EQ(Huginn::Engine::move_to_uci(best), "a1a8");
+}
+
+TEST(MultiPV, UciOptionReachesSearch) {
+    Huginn::init();
+    UCIInterface uci;
+
+    std::ostringstream captured;
+    auto* old_buf = std::cout.rdbuf(captured.rdbuf());
+    uci.send_options();
+    uci.handle_setoption({"setoption", "name", "MultiPV", "value", "3"});
+    uci.handle_position({"position", "startpos"});
+    uci.handle_go({"go", "depth", "4"});
+    uci.wait_for_search();
+    std::cout.rdbuf(old_buf);
+
+    const std::string out = captured.str();
+    EXPECT_NE(out.find("option name MultiPV type spin default 1 min 1 max 64"), std::string::npos);
+    EXPECT_EQ(lines_at_depth(parse_pv_lines(out), 4).size(), 3u) << out;
+    EXPECT_NE(out.find("bestmove "), std::string::npos);
+}
@@ -0,0 +1,165 @@
+// user-046: memory-mapped Polyglot book.
+//
+// The root-computed key must match the published reference keys, and the
+// mapped book must find entries in a sorted big-endian file and refuse files
+// it cannot search.
+
+#include <gtest/gtest.h>
+
+#include "../src/init.hpp"
+#include "../src/movegen.hpp"
+#include "../src/polyglot_book.hpp"
+#include "../src/polyglot_keys.hpp"
+#include "../src/position.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Huginn;
+
+namespace {
+
+struct RawEntry {
+    uint64_t key;
+    uint16_t move;
+    uint16_t weight;
+};
+
+void put_be(std::ofstream& out, uint64_t v, int bytes) {
+    for (int i = bytes - 1; i >= 0; --i) out.put(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+std::string write_book(const std::string& name, const std::vector<RawEntry>& entries,
+                        int trailing_bytes = 0) {
+    const std::string path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    for (const auto& e : entries) {
+        put_be(out, e.key, 8);
+        put_be(out, e.move, 2);
+        put_be(out, e.weight, 2);
+        put_be(out, 0, 4);
+    }
+    for (int i = 0; i < trailing_bytes; ++i) out.put(0);
+    return path;
+}
+
+// Polyglot move: to file/row in bits 0-5, from file/row in bits 6-11.
+uint16_t poly_move(int from, int to) {
+    return static_cast<uint16_t>((to & 7) | ((to >> 3) << 3) | ((from & 7) << 6) | ((from >> 3) << 9));
+}
+
+} // namespace
+
+// Reference keys from the Polyglot book-format description: en passant is
+// hashed only when a capture is possible, and castling rights drop as the
+// king and rook move.
+TEST(PolyglotBook, KeyMatchesPublishedReferences) {
+    Huginn::init();
+    struct Line {
+        std::vector<const char*> moves;
+        uint64_t key;
+    };
+    const Line lines[] = {
+        {{}, 0x463B96181691FC9CULL},
+        {{"e2e4"}, 0x823C9B50FD114196ULL},
+        {{"e2e4", "d7d5"}, 0x0756B94461C50FB0ULL},
+        {{"e2e4", "d7d5", "e4e5"}, 0x662FAFB965DB29D4ULL},
+        {{"e2e4", "d7d5", "e4e5", "f7f5"}, 0x22A48B5A8E47FF78ULL},
+        {{"e2e4", "d7d5", "e4e5", "f7f5", "e1e2"}, 0x652A607CA3F242C1ULL},
+        {{"e2e4", "d7d5", "e4e5", "f7f5", "e1e2", "e8f7"}, 0x00FDD303C946BDD9ULL},
+        {{"a2a4", "b7b5", "h2h4", "b5b4", "c2c4"}, 0x3C8123EA7B067637ULL},
+        {{"a2a4", "b7b5", "h2h4", "b5b4", "c2c4", "b4c3", "a1a3"}, 0x5C3F9B829B279560ULL},
+    };
+    PolyglotBook book;
+    for (const Line& line : lines) {
+        Position pos;
+        ASSERT_TRUE(pos.set_from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"));
+        for (const char* uci : line.moves) {
+            S_MOVELIST legal;
+            generate_legal_moves(pos, legal);
+            bool played = false;
+            for (int i = 0; i < legal.count && !played; ++i) {
+                if (legal.moves[i].to_string() == uci) played = (pos.MakeMove(legal.moves[i]) == 1);
+            }
+            ASSERT_TRUE(played) << uci;
+        }
+        EXPECT_EQ(book.get_polyglot_key(pos), line.key) << line.moves.size() << " moves";
+    }
+}
+
+TEST(PolyglotBook, ProbesMappedBook) {
+    Huginn::init();
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"));
+    const uint64_t start = PolyglotKeys::compute(pos);
+
+    // e2e4 is the only weighted start move; keys on either side bracket it.
+    const std::string path = write_book("huginn_test_book.bin", {
+        {start - 1, poly_move(1, 18), 5},
+        {start, poly_move(12, 28), 7},
+        {start, poly_move(11, 27), 0},
+        {start + 1, poly_move(6, 21), 3},
+    });
+
+    PolyglotBook book;
+    ASSERT_TRUE(book.load_book(path));
+    EXPECT_EQ(book.size(), 4u);
+    EXPECT_EQ(book.entry_at(1).key, start);
+    EXPECT_EQ(book.entry_at(1).weight, 7);
+    EXPECT_TRUE(book.has_book_moves(pos));
+    for (int i = 0; i < 8; ++i) EXPECT_EQ(book.get_book_move(pos).to_string(), "e2e4");
+
+    // Moving a book keeps it usable; the source is left empty.
+    PolyglotBook moved = std::move(book);
+    EXPECT_FALSE(book.is_book_loaded());
+    EXPECT_TRUE(moved.has_book_moves(pos));
+
+    Position other;
+    ASSERT_TRUE(other.set_from_fen("4k3/8/8/8/8/8/8/4K3 w - - 0 1"));
+    EXPECT_FALSE(moved.has_book_moves(other));
+    EXPECT_EQ(moved.get_book_move(other).move, 0);
+
+    moved.clear();
+    EXPECT_FALSE(moved.has_book_moves(pos));
+    std::remove(path.c_str());
+}
+
+TEST(PolyglotBook, RejectsMissingAndRaggedFiles) {
+    Huginn::init();
+    PolyglotBook book;
+    EXPECT_FALSE(book.load_book((std::filesystem::temp_directory_path() / "huginn_no_such_book.bin").string()));
+
+    const std::string ragged = write_book("huginn_ragged_book.bin", {{1, 0, 1}}, 3);
+    EXPECT_FALSE(book.load_book(ragged));
+    EXPECT_FALSE(book.is_book_loaded());
+    std::remove(ragged.c_str());
+
+}
+
+TEST(PolyglotBook, VerifyKeyOrderFindsAnyUnsortedPair) {
+    Huginn::init();
+    PolyglotBook book;
+    // Key order is trusted at load (the check would read every page) and
+    // checked only on request
+    const std::string unsorted = write_book("huginn_unsorted_book.bin", {{9, 0, 1}, {3, 0, 1}});
+    ASSERT_TRUE(book.load_book(unsorted));
+    EXPECT_FALSE(book.verify_key_order());
+    std::remove(unsorted.c_str());
+
+    // One adjacent pair out of order deep inside a large book
+    std::vector<RawEntry> entries;
+    for (uint64_t k = 0; k < 10000; ++k) entries.push_back({k * 2 + 10, 0, 1});
+    std::swap(entries[5001], entries[5002]);
+    const std::string mostly_sorted = write_book("huginn_mostly_sorted_book.bin", entries);
+    ASSERT_TRUE(book.load_book(mostly_sorted));
+    EXPECT_FALSE(book.verify_key_order());
+    std::swap(entries[5001], entries[5002]);
+    write_book("huginn_mostly_sorted_book.bin", entries);
+    ASSERT_TRUE(book.load_book(mostly_sorted));
+    EXPECT_TRUE(book.verify_key_order());
+    std::remove(mostly_sorted.c_str());
+}
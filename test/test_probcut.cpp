@@ -0,0 +1,84 @@
+// user-038 ProbCut (ENABLE_PROBCUT): at a non-PV node of depth >= 5, a good
+// capture whose reduced-depth search beats beta + margin cuts the node.
+// Behaviour tests are gated on the flag (candidate, default OFF); the
+// search-integrity tests run on BOTH arms.
+
+#include <gtest/gtest.h>
+
+#include "../src/bench.hpp"
+#include "../src/init.hpp"
+#include "../src/search.hpp"
+
+using namespace Huginn;
+
+namespace {
+
+struct SearchResult {
+    S_MOVE best;
+    uint64_t nodes;
+    uint64_t probcut_cuts;
+};
+
+SearchResult search_fen(const std::string& fen, int depth) {
+    Engine engine;
+    Position pos;
+    EXPECT_TRUE(pos.set_from_fen(fen));
+    SearchInfo info{};
+    info.max_depth = depth;
+    info.infinite = true;
+    SearchResult r;
+    r.best = engine.searchPosition(pos, info);
+    r.nodes = info.nodes;
+    r.probcut_cuts = info.probcut_cuts;
+    return r;
+}
+
+const char* const KIWIPETE = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+
+}  // namespace
+
+// --- Search integrity (both arms) --------------------------------------------
+
+// The winning capture must still be found when ProbCut is cutting the
+// refutation subtrees around it.
+TEST(ProbCut, WinsHangingQueenAtDepth) {
+    Huginn::init();
+    const auto r = search_fen("6k1/5ppp/8/3q4/8/8/5PPP/3R2K1 w - - 0 1", 8);
+    EXPECT_EQ(r.best.get_from(), sq64(File::D, Rank::R1));
+    EXPECT_EQ(r.best.get_to(), sq64(File::D, Rank::R5)) << "1.Rxd5 wins the queen";
+}
+
+TEST(ProbCut, FreshEngineSearchIsDeterministic) {
+    Huginn::init();
+    const auto a = search_fen(KIWIPETE, 9);
+    const auto b = search_fen(KIWIPETE, 9);
+    EXPECT_EQ(a.best.move, b.best.move);
+    EXPECT_EQ(a.nodes, b.nodes);
+    EXPECT_EQ(a.probcut_cuts, b.probcut_cuts);
+}
+
+// --- Per-arm behaviour --------------------------------------------------------
+
+#if defined(ENABLE_PROBCUT) && ENABLE_PROBCUT
+
+// Cutoffs are rare (null move takes most cut nodes first), so look across
+// the bench middlegames; none at all means the flag is wired but dead.
+TEST(ProbCut, CutsFireInDeepSearch) {
+    Huginn::init();
+    uint64_t cuts = 0;
+    const auto& fens = bench_positions();
+    for (size_t i = 0; i < fens.size() && i < 12; ++i) {
+        cuts += search_fen(fens[i], 9).probcut_cuts;
+    }
+    EXPECT_GT(cuts, 0u) << "no ProbCut cutoff in depth-9 searches of the bench positions";
+}
+
+#else  // baseline arm
+
+TEST(ProbCut, BaselineArmNeverCuts) {
+    Huginn::init();
+    const auto r = search_fen(KIWIPETE, 9);
+    EXPECT_EQ(r.probcut_cuts, 0u);
+}
+
+#endif
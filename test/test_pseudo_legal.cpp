@@ -0,0 +1,161 @@
+// user-037 Position::is_pseudo_legal: an O(1) answer to "would
+// generate_all_moves() emit this exact encoding here?", used to search a TT
+// move before any generation (ENABLE_TT_MOVE_FIRST) and to validate the PV
+// TT-walk. The equivalence test is the contract; the rest pin the rules a
+// stale TT move is most likely to break.
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+
+#include "../src/bench.hpp"
+#include "../src/init.hpp"
+#include "../src/movegen.hpp"
+#include "../src/position.hpp"
+#include "../src/search.hpp"
+
+using namespace Huginn;
+
+namespace {
+
+// Bench positions plus special-move coverage: castling both ways (with an
+// attacked transit square), en passant, promotions with and without capture.
+std::vector<std::string> test_fens() {
+    std::vector<std::string> fens = bench_positions();
+    fens.push_back("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    fens.push_back("r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 0 1");
+    fens.push_back("r3k2r/8/8/8/8/5b2/8/R3K2R w KQkq - 0 1");
+    fens.push_back("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3");
+    fens.push_back("4k3/8/8/8/3pP3/8/8/4K3 b - e3 0 1");
+    fens.push_back("1r2k3/P6P/8/8/8/8/p6p/1R2K1R1 w - - 0 1");
+    fens.push_back("1r2k3/P6P/8/8/8/8/p6p/1R2K1R1 b - - 0 1");
+    return fens;
+}
+
+bool in_list(const S_MOVELIST& list, int move) {
+    for (int i = 0; i < list.count; ++i) {
+        if (list.moves[i].move == move) return true;
+    }
+    return false;
+}
+
+S_MOVE raw(int move) {
+    S_MOVE m;
+    m.move = move;
+    m.score = 0;
+    return m;
+}
+
+class PseudoLegalTest : public ::testing::Test {
+protected:
+    void SetUp() override { Huginn::init(); }
+};
+
+// Every encoding the generator produces anywhere — plus each one with a
+// flipped flag or a wrong captured type — is accepted in exactly the
+// positions whose generated list contains it.
+TEST_F(PseudoLegalTest, MatchesGeneratorOnBenchWalks) {
+    std::mt19937 rng(0x37);
+    std::vector<Position> positions;
+    std::set<int> encodings;
+    for (const auto& fen : test_fens()) {
+        Position pos;
+        ASSERT_TRUE(pos.set_from_fen(fen));
+        for (int ply = 0; ply < 6; ++ply) {
+            positions.push_back(pos);
+            S_MOVELIST list;
+            generate_all_moves(pos, list);
+            for (int i = 0; i < list.count; ++i) {
+                const int m = list.moves[i].move;
+                encodings.insert(m);
+                encodings.insert(m ^ MOVE_PAWNSTART);
+                encodings.insert(m ^ MOVE_ENPASSANT);
+                encodings.insert(m ^ MOVE_CASTLE);
+                encodings.insert(m ^ (1 << MOVE_CAPTURED_SHIFT));
+                encodings.insert(m ^ (int(PieceType::Queen) << MOVE_PROMOTED_SHIFT));
+            }
+            S_MOVELIST legal;
+            generate_legal_moves(pos, legal);
+            if (legal.count == 0) break;
+            pos.MakeMove(legal.moves[rng() % legal.count]);
+        }
+    }
+
+    int accepted = 0;
+    for (const Position& pos : positions) {
+        S_MOVELIST list;
+        generate_all_moves(pos, list);
+        for (int m : encodings) {
+            const bool expected = in_list(list, m);
+            ASSERT_EQ(pos.is_pseudo_legal(raw(m)), expected)
+                << pos.to_fen() << " move " << raw(m).to_string() << " (0x" << std::hex << m << ")";
+            accepted += expected;
+        }
+    }
+    EXPECT_GT(accepted, 1000);
+}
+
+TEST_F(PseudoLegalTest, RejectsGarbageEncodings) {
+    Position pos;
+    pos.set_startpos();
+    EXPECT_FALSE(pos.is_pseudo_legal(raw(0)));
+    EXPECT_FALSE(pos.is_pseudo_legal(raw(-1)));
+    EXPECT_FALSE(pos.is_pseudo_legal(raw(make_move(12, 28).move | (1 << 25))));  // reserved bit
+    EXPECT_FALSE(pos.is_pseudo_legal(raw(make_move(12, 12).move)));
+    EXPECT_TRUE(pos.is_pseudo_legal(make_pawn_start(12, 28)));                      // e2e4
+    EXPECT_FALSE(pos.is_pseudo_legal(make_move(12, 28)));                          // e2e4 without the flag
+    EXPECT_FALSE(pos.is_pseudo_legal(make_move(52, 36)));                          // e7e5, wrong side
+    EXPECT_FALSE(pos.is_pseudo_legal(make_move(3, 39)));                           // Qd1-h5 through e2
+}
+
+TEST_F(PseudoLegalTest, CastlingNeedsRightsPathAndSafeSquares) {
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen("r3k2r/8/8/8/8/5b2/8/R3K2R w KQkq - 0 1"));
+    // The f3 bishop covers d1 (O-O-O transit) and h1 (the rook, not a king square).
+    EXPECT_FALSE(pos.is_pseudo_legal(make_castle(4, 2)));
+    EXPECT_TRUE(pos.is_pseudo_legal(make_castle(4, 6)));
+    ASSERT_TRUE(pos.set_from_fen("r3k2r/8/8/8/8/8/8/R3K2R w Qkq - 0 1"));
+    EXPECT_FALSE(pos.is_pseudo_legal(make_castle(4, 6)));  // no K right
+    ASSERT_TRUE(pos.set_from_fen("r3k2r/8/8/8/8/8/8/RN2K2R w KQkq - 0 1"));
+    EXPECT_FALSE(pos.is_pseudo_legal(make_castle(4, 2)));  // b1 blocked
+    ASSERT_TRUE(pos.set_from_fen("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1"));
+    EXPECT_FALSE(pos.is_pseudo_legal(make_move(4, 6)));    // e1g1 without the castle flag
+    ASSERT_TRUE(pos.set_from_fen("r3k2r/8/8/8/8/8/5r2/R3K2R w KQkq - 0 1"));
+    EXPECT_FALSE(pos.is_pseudo_legal(make_castle(4, 6)));  // f1 attacked by the f2 rook
+}
+
+TEST_F(PseudoLegalTest, EnPassantAndPromotionFields) {
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3"));
+    EXPECT_TRUE(pos.is_pseudo_legal(make_en_passant(36, 45)));   // exf6
+    EXPECT_FALSE(pos.is_pseudo_legal(make_en_passant(36, 43)));  // exd6: d6 is not the ep square
+
+    ASSERT_TRUE(pos.set_from_fen("1r2k3/P6P/8/8/8/8/8/4K3 w - - 0 1"));
+    EXPECT_TRUE(pos.is_pseudo_legal(make_promotion(48, 56, PieceType::Queen)));              // a8=Q
+    EXPECT_TRUE(pos.is_pseudo_legal(make_promotion(48, 57, PieceType::Knight, PieceType::Rook)));  // axb8=N
+    EXPECT_FALSE(pos.is_pseudo_legal(make_move(48, 56)));                                     // no piece
+    EXPECT_FALSE(pos.is_pseudo_legal(make_promotion(48, 56, PieceType::King)));
+    EXPECT_FALSE(pos.is_pseudo_legal(make_promotion(48, 57, PieceType::Queen)));              // captured field missing
+}
+
+// --- Search integrity (both ENABLE_TT_MOVE_FIRST arms) ------------------------
+
+TEST_F(PseudoLegalTest, SearchIsDeterministicAndFindsTactic) {
+    Engine a, b;
+    Position pa, pb;
+    // Rxd8 is mate on the back rank.
+    ASSERT_TRUE(pa.set_from_fen("3q2k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1"));
+    pb = pa;
+    SearchInfo ia{}, ib{};
+    ia.max_depth = ib.max_depth = 7;
+    ia.infinite = ib.infinite = true;
+    const S_MOVE ma = a.searchPosition(pa, ia);
+    const S_MOVE mb = b.searchPosition(pb, ib);
+    EXPECT_EQ(ma.move, mb.move);
+    EXPECT_EQ(ia.nodes, ib.nodes);
+    EXPECT_EQ(ma.get_from(), 3);
+    EXPECT_EQ(ma.get_to(), 59);
+}
+
+}  // namespace
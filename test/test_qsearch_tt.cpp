@@ -0,0 +1,126 @@
+// user-033 quiescence TT integration (ENABLE_QSEARCH_TT): quiescence probes
+// the TT at entry for bound cutoffs and stores its own result at depth 0,
+// without downgrading a main-search entry and without storing once the
+// rule-50 clock has reached 100. Behaviour tests are gated on the flag
+// (default ON); the search-integrity tests run on BOTH arms.
+
+#include <gtest/gtest.h>
+
+#include "../src/init.hpp"
+#include "../src/search.hpp"
+
+using namespace Huginn;
+
+namespace {
+
+// White to move wins a queen: Rxd8 is the only capture that matters.
+const char* const HANGING_QUEEN = "3q2k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1";
+
+bool probe(Engine& engine, const Position& pos, int& score, uint8_t& depth, uint8_t& type) {
+    uint32_t move;
+    return engine.tt_table.probe(pos.zobrist_key, score, depth, type, move);
+}
+
+}  // namespace
+
+// --- Search integrity (both arms) --------------------------------------------
+
+TEST(QsearchTT, RepeatedQuiescenceReturnsSameScore) {
+    Huginn::init();
+    Engine engine;
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen(HANGING_QUEEN));
+    SearchInfo info{};
+    const int first = engine.quiescence(pos, -INFINITE, INFINITE, info);
+    const int second = engine.quiescence(pos, -INFINITE, INFINITE, info);
+    EXPECT_EQ(first, second) << "a TT hit must reproduce the searched score";
+    EXPECT_GT(first, 500) << "Rxd8 wins the queen";
+}
+
+TEST(QsearchTT, FreshEngineSearchIsDeterministic) {
+    Huginn::init();
+    Engine a, b;
+    Position pa, pb;
+    ASSERT_TRUE(pa.set_from_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"));
+    pb = pa;
+    SearchInfo ia{}, ib{};
+    ia.max_depth = ib.max_depth = 7;
+    ia.infinite = ib.infinite = true;
+    const S_MOVE ma = a.searchPosition(pa, ia);
+    const S_MOVE mb = b.searchPosition(pb, ib);
+    EXPECT_EQ(ma.move, mb.move);
+    EXPECT_EQ(ia.nodes, ib.nodes);
+}
+
+// --- Per-arm behaviour --------------------------------------------------------
+
+#if defined(ENABLE_QSEARCH_TT) && ENABLE_QSEARCH_TT
+
+TEST(QsearchTT, StoresDepthZeroExactResult) {
+    Huginn::init();
+    Engine engine;
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen(HANGING_QUEEN));
+    SearchInfo info{};
+    const int score = engine.quiescence(pos, -INFINITE, INFINITE, info);
+
+    int tt_score;
+    uint8_t depth, type;
+    ASSERT_TRUE(probe(engine, pos, tt_score, depth, type));
+    EXPECT_EQ(depth, 0);
+    EXPECT_EQ(type, TTEntry::EXACT);
+    EXPECT_EQ(tt_score, score);
+}
+
+TEST(QsearchTT, StandPatFailHighStoresLowerBound) {
+    Huginn::init();
+    Engine engine;
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen(HANGING_QUEEN));
+    SearchInfo info{};
+    // White is up a rook before any capture: stand pat alone beats beta.
+    EXPECT_EQ(engine.quiescence(pos, -200, -100, info), -100);
+
+    int tt_score;
+    uint8_t depth, type;
+    ASSERT_TRUE(probe(engine, pos, tt_score, depth, type));
+    EXPECT_EQ(type, TTEntry::LOWER_BOUND);
+    EXPECT_GE(tt_score, -100);
+}
+
+// A main-search entry at the same key must survive a quiescence visit.
+TEST(QsearchTT, DoesNotDowngradeDeeperEntry) {
+    Huginn::init();
+    Engine engine;
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen(HANGING_QUEEN));
+    engine.tt_table.store(pos.zobrist_key, 0, 5, TTEntry::UPPER_BOUND, 0);
+    SearchInfo info{};
+    engine.quiescence(pos, -INFINITE, INFINITE, info);
+
+    int tt_score;
+    uint8_t depth, type;
+    ASSERT_TRUE(probe(engine, pos, tt_score, depth, type));
+    EXPECT_EQ(depth, 5);
+    EXPECT_EQ(type, TTEntry::UPPER_BOUND);
+}
+
+// ENABLE_RULE50_TT_GUARD: with the clock at 100 the result is path-dependent.
+TEST(QsearchTT, Rule50ClockBlocksStore) {
+    Huginn::init();
+    Engine engine;
+    Position pos;
+    ASSERT_TRUE(pos.set_from_fen("3q2k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 100 80"));
+    SearchInfo info{};
+    engine.quiescence(pos, -INFINITE, INFINITE, info);
+
+    int tt_score;
+    uint8_t depth, type;
+#if ENABLE_RULE50_TT_GUARD
+    EXPECT_FALSE(probe(engine, pos, tt_score, depth, type));
+#else
+    EXPECT_TRUE(probe(engine, pos, tt_score, depth, type));
+#endif
+}
+
+#endif
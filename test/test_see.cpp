@@ -9,6 +9,9 @@
 #include "../src/position.hpp"
 #include "../src/movegen.hpp"
 #include "../src/init.hpp"
+#include "../src/bench.hpp"
+
+#include <random>
 
 using namespace Huginn;
 
@@ -96,4 +99,57 @@ TEST_F(SEETest, XRayThroughRook) {
     EXPECT_EQ(see(pos, m), 100);
 }
 
+// user-036: see_ge is the threshold form — decided at the boundary exactly
+// where the exact value says.
+TEST_F(SEETest, SeeGeBoundaryMatchesExactValue) {
+    Position pos;
+    pos.set_from_fen("r3k3/8/8/p7/8/R7/8/R3K3 w - - 0 1");
+    auto m = find_move(pos, "a3", "a5");
+    ASSERT_NE(m.move, 0);
+    EXPECT_TRUE(see_ge(pos, m, 100));
+    EXPECT_FALSE(see_ge(pos, m, 101));
+    EXPECT_TRUE(see_ge(pos, m, -400));
+}
+
+// #58 pin filter carries over: Ne7 is pinned to Ke8 by Re1, so Qxf5 wins the
+// pawn outright instead of losing the queen to the illegal recapture.
+TEST_F(SEETest, SeeGeKeepsFirstRecapturePinFilter) {
+    Position pos;
+    pos.set_from_fen("4k3/4n3/8/5p2/6Q1/8/8/4R1K1 w - - 0 1");
+    auto m = find_move(pos, "g4", "f5");
+    ASSERT_NE(m.move, 0);
+    EXPECT_EQ(see_ge(pos, m, 0), see(pos, m) >= 0);
+    EXPECT_EQ(see_ge(pos, m, 100), see(pos, m) >= 100);
+}
+
+// Exhaustive agreement with the exact SEE over every capture in the bench
+// positions and the positions a few random plies away from them.
+TEST_F(SEETest, SeeGeAgreesWithExactSeeOnBenchCaptures) {
+    std::mt19937 rng(0x5EE);
+    const int thresholds[] = {-900, -320, -100, -1, 0, 1, 100, 220, 320, 500, 900};
+    int checked = 0;
+    for (const auto& fen : bench_positions()) {
+        Position pos;
+        ASSERT_TRUE(pos.set_from_fen(fen));
+        for (int ply = 0; ply < 8; ++ply) {
+            S_MOVELIST list;
+            generate_legal_moves(pos, list);
+            if (list.count == 0) break;
+            for (int i = 0; i < list.count; ++i) {
+                const S_MOVE& m = list.moves[i];
+                if (!m.is_capture()) continue;
+                const int exact = see(pos, m);
+                for (int t : thresholds) {
+                    ASSERT_EQ(see_ge(pos, m, t), exact >= t)
+                        << pos.to_fen() << " move " << m.to_string() << " threshold " << t
+                        << " exact " << exact;
+                    ++checked;
+                }
+            }
+            pos.MakeMove(list.moves[rng() % list.count]);
+        }
+    }
+    EXPECT_GT(checked, 10000);
+}
+
 } // namespace
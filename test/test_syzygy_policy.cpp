@@ -0,0 +1,231 @@
+// user-049: Syzygy probing policy.
+//
+// The search reaches tablebases only through TablebaseBackend, so an
+// in-memory backend stands in for Fathom here: it answers from a map keyed by
+// Zobrist key (draw otherwise) and logs every probe. SyzygyProbeLimit /
+// SyzygyProbeDepth gate which nodes probe; a hit is stored in the TT at
+// MAX_DEPTH as an exact entry (draw) or a bound (win / loss), so a
+// transposition takes the TT cutoff instead of probing again.
+
+#include <gtest/gtest.h>
+
+#include "../src/init.hpp"
+#include "../src/movegen.hpp"
+#include "../src/search.hpp"
+#include "../src/uci.hpp"
+#include "../src/uci_utils.hpp"
+
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Huginn;
+
+namespace {
+
+// White Kc1, pawns c4 e4 vs Black Ke8, pawn d5: captures leave 4 pieces with
+// rule50 reset; pawn pushes keep all 5.
+const char* const FIVE_MAN = "4k3/8/8/3p4/2P1P3/8/8/2K5 w - - 0 1";
+
+class FakeTablebase : public TablebaseBackend {
+public:
+    explicit FakeTablebase(int pieces) : pieces_(pieces) {}
+
+    bool is_available() const override { return pieces_ > 0; }
+    int max_piece_count() const override { return pieces_; }
+    bool can_probe(const Position& pos) const override {
+        return popcount(pos.occupied_bitboard) <= pieces_;
+    }
+    int probe_wdl(const Position& pos) const override {
+        probes.push_back({pos.zobrist_key, popcount(pos.occupied_bitboard)});
+        auto it = results.find(pos.zobrist_key);
+        return it == results.end() ? 0 : it->second;
+    }
+    S_MOVE probe_root(const Position&) const override { return S_MOVE(); }
+    std::string get_info() const override { return "fake tablebase"; }
+
+    struct Probe {
+        uint64_t key;
+        int pieces;
+    };
+    std::map<uint64_t, int> results;   // WDL on Huginn's scale by position
+    mutable std::vector<Probe> probes;
+
+private:
+    int pieces_;
+};
+
+Position from_fen(const char* fen) {
+    Position pos;
+    EXPECT_TRUE(pos.set_from_fen(fen));
+    return pos;
+}
+
+Position after(const char* fen, const char* move) {
+    Position pos = from_fen(fen);
+    pos.MakeMove(parse_uci_move(move, pos));
+    return pos;
+}
+
+S_MOVE search_quiet(Engine& engine, Position& pos, int depth) {
+    SearchInfo info;
+    info.max_depth = depth;
+    info.infinite = true;
+    std::ostringstream captured;
+    auto* old_buf = std::cout.rdbuf(captured.rdbuf());
+    S_MOVE best = engine.searchPosition(pos, info);
+    std::cout.rdbuf(old_buf);
+    return best;
+}
+
+} // namespace
+
+TEST(SyzygyPolicy, LimitAndDepthGates) {
+    Huginn::init();
+    FakeTablebase tb(5);
+    Engine engine(&tb);
+    const Position five = from_fen(FIVE_MAN);
+    const Position four = after(FIVE_MAN, "e4d5");
+
+    // Defaults (depth 1, limit 7) probe everything the backend covers
+    EXPECT_TRUE(engine.should_probe_tablebase(five, 1));
+    EXPECT_TRUE(engine.should_probe_tablebase(four, 1));
+
+    // At the limit only deep enough nodes probe; below it any depth does
+    engine.syzygy_probe_depth = 3;
+    EXPECT_FALSE(engine.should_probe_tablebase(five, 2));
+    EXPECT_TRUE(engine.should_probe_tablebase(five, 3));
+    EXPECT_TRUE(engine.should_probe_tablebase(four, 1));
+
+    engine.syzygy_probe_limit = 4;
+    EXPECT_FALSE(engine.should_probe_tablebase(five, 10));
+    EXPECT_FALSE(engine.should_probe_tablebase(four, 2));
+    EXPECT_TRUE(engine.should_probe_tablebase(four, 3));
+    engine.syzygy_probe_limit = 0;
+    EXPECT_FALSE(engine.should_probe_tablebase(four, 10));
+
+    // rule50 > 0 and castling rights are never probed (nor cached)
+    engine.syzygy_probe_limit = 7;
+    EXPECT_FALSE(engine.should_probe_tablebase(after(FIVE_MAN, "c1d2"), 10));
+    EXPECT_FALSE(engine.should_probe_tablebase(from_fen("4k3/8/8/8/8/8/8/R3K3 w Q - 0 1"), 10));
+
+    FakeTablebase none(0);
+    Engine without(&none);
+    EXPECT_FALSE(without.should_probe_tablebase(four, 10));
+}
+
+TEST(SyzygyPolicy, HitsStoredAtMaxDepth) {
+    Huginn::init();
+    FakeTablebase tb(5);
+    Engine engine(&tb);
+    const int WIN = MATE - 1000;
+
+    struct Case {
+        const char* move;
+        int wdl;
+        uint8_t bound;
+    };
+    const Case cases[] = {
+        {"e4d5", WIN, TTEntry::LOWER_BOUND},
+        {"c4d5", -WIN, TTEntry::UPPER_BOUND},
+        {"e4e5", 0, TTEntry::EXACT},
+    };
+    for (const Case& c : cases) {
+        Position pos = after(FIVE_MAN, c.move);
+        tb.results[pos.zobrist_key] = c.wdl;
+        tb.probes.clear();
+        // A shallow entry from an earlier search: too shallow to cut, but
+        // its move must survive the TB store
+        S_MOVELIST legal;
+        generate_legal_moves(pos, legal);
+        ASSERT_GT(legal.count, 0);
+        const uint32_t hint = legal.moves[0].move;
+        engine.tt_table.store(pos.zobrist_key, 0, 1, TTEntry::LOWER_BOUND, hint);
+
+        SearchInfo info;
+        EXPECT_EQ(engine.AlphaBeta(pos, -100, 100, 3, info, true), c.wdl) << c.move;
+        EXPECT_EQ(info.tbhits, 1u);
+
+        int score;
+        uint8_t depth, type;
+        uint32_t move;
+        ASSERT_TRUE(engine.tt_table.probe(pos.zobrist_key, score, depth, type, move)) << c.move;
+        EXPECT_EQ(score, c.wdl);
+        EXPECT_EQ(depth, MAX_DEPTH);
+        EXPECT_EQ(type, c.bound);
+        EXPECT_EQ(move, hint) << c.move;
+
+        // The transposition is answered by the TT, even at a greater depth
+        SearchInfo again;
+        engine.AlphaBeta(pos, -100, 100, 20, again, true);
+        EXPECT_EQ(tb.probes.size(), 1u) << c.move;
+        EXPECT_EQ(again.tbhits, 0u);
+    }
+
+    // A bound that cannot cut this window is not cached; the node is searched
+    Position pos = after(FIVE_MAN, "e4d5");
+    engine.tt_table.clear();
+    tb.probes.clear();
+    SearchInfo info;
+    engine.AlphaBeta(pos, -MATE, MATE, 2, info, true);
+    EXPECT_GE(info.tbhits, 1u);
+    int score;
+    uint8_t depth, type;
+    uint32_t move;
+    if (engine.tt_table.probe(pos.zobrist_key, score, depth, type, move)) {
+        EXPECT_NE(depth, MAX_DEPTH);
+    }
+}
+
+TEST(SyzygyPolicy, SearchProbesEachPositionOnce) {
+    Huginn::init();
+    FakeTablebase tb(5);
+    Engine engine(&tb);
+    Position pos = from_fen(FIVE_MAN);
+    search_quiet(engine, pos, 7);
+
+    ASSERT_FALSE(tb.probes.empty());
+    std::map<uint64_t, int> seen;
+    bool five_probed = false;
+    for (const auto& p : tb.probes) {
+        EXPECT_EQ(++seen[p.key], 1) << "probed twice: " << std::hex << p.key;
+        five_probed |= (p.pieces == 5);
+    }
+    EXPECT_TRUE(five_probed);
+
+    // With the depth gate out of reach only the 4-man positions are probed
+    FakeTablebase deep_tb(5);
+    Engine deep(&deep_tb);
+    deep.syzygy_probe_depth = 100;
+    pos = from_fen(FIVE_MAN);
+    search_quiet(deep, pos, 7);
+    ASSERT_FALSE(deep_tb.probes.empty());
+    for (const auto& p : deep_tb.probes) EXPECT_LT(p.pieces, 5);
+
+    // SyzygyProbeLimit 0 switches probing off
+    FakeTablebase off_tb(5);
+    Engine off(&off_tb);
+    off.syzygy_probe_limit = 0;
+    pos = from_fen(FIVE_MAN);
+    search_quiet(off, pos, 7);
+    EXPECT_TRUE(off_tb.probes.empty());
+}
+
+TEST(SyzygyPolicy, UciOptions) {
+    Huginn::init();
+    UCIInterface uci;
+    std::ostringstream captured;
+    auto* old_buf = std::cout.rdbuf(captured.rdbuf());
+    uci.send_options();
+    uci.handle_setoption({"setoption", "name", "SyzygyProbeDepth", "value", "4"});
+    uci.handle_setoption({"setoption", "name", "SyzygyProbeLimit", "value", "9"});
+    std::cout.rdbuf(old_buf);
+
+    const std::string out = captured.str();
+    EXPECT_NE(out.find("option name SyzygyProbeDepth type spin default 1 min 1 max 100"), std::string::npos);
+    EXPECT_NE(out.find("option name SyzygyProbeLimit type spin default 7 min 0 max 7"), std::string::npos);
+    EXPECT_EQ(uci.engine().syzygy_probe_depth, 4);
+    EXPECT_EQ(uci.engine().syzygy_probe_limit, 7);  // clamped
+}
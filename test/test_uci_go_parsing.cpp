@@ -140,3 +140,81 @@ TEST(UCIGoParsingTest, ParseInfiniteWithExplicitDepthKeepsThatDepth) {
     EXPECT_TRUE(infinite_requested);
     EXPECT_EQ(limits.max_depth, 10);
 }
+
+// user-041: `ponder` flags the search but does not change the budget — the
+// clocks are those after the expected reply, and they apply from ponderhit.
+TEST(UCIGoParsingTest, ParsePonderKeepsClockBudget) {
+    bool infinite_requested = false;
+    auto limits = parse_go_command(split_command("go ponder wtime 60000 btime 60000 winc 1000 binc 1000"),
+                                    Color::White, infinite_requested);
+    EXPECT_TRUE(limits.ponder);
+    EXPECT_EQ(limits.max_time_ms, 3500);
+    EXPECT_FALSE(limits.infinite);
+    EXPECT_FALSE(infinite_requested);
+
+    auto plain = parse_go_command(split_command("go wtime 60000"), Color::White, infinite_requested);
+    EXPECT_FALSE(plain.ponder);
+}
+
+// user-045: `go nodes` is a node budget, not a clock — untimed unless a
+// clock comes with it — and takes counts past the 1e9 spin-option cap.
+TEST(UCIGoParsingTest, ParseNodesIsUntimedNodeBudget) {
+    bool infinite_requested = false;
+    auto limits = parse_go_command(split_command("go nodes 50000"), Color::White, infinite_requested);
+    EXPECT_EQ(limits.max_nodes, 50000u);
+    EXPECT_TRUE(limits.infinite);
+    EXPECT_EQ(limits.max_time_ms, 0);
+    EXPECT_EQ(limits.max_depth, Huginn::MAX_DEPTH);
+    EXPECT_FALSE(infinite_requested);  // bestmove goes out when the budget is spent
+
+    auto big = parse_go_command(split_command("go nodes 5000000000"), Color::White, infinite_requested);
+    EXPECT_EQ(big.max_nodes, 5000000000ULL);
+
+    auto junk = parse_go_command(split_command("go nodes lots"), Color::White, infinite_requested);
+    EXPECT_EQ(junk.max_nodes, 0u);
+    EXPECT_EQ(junk.max_time_ms, 5000);  // no valid limit: bare-`go` default
+}
+
+TEST(UCIGoParsingTest, ParseNodesAlongsideClockKeepsClock) {
+    bool infinite_requested = false;
+    auto limits = parse_go_command(split_command("go wtime 60000 btime 60000 nodes 1000"),
+                                    Color::White, infinite_requested);
+    EXPECT_EQ(limits.max_nodes, 1000u);
+    EXPECT_EQ(limits.max_time_ms, 3000);
+    EXPECT_FALSE(limits.infinite);
+
+    auto with_depth = parse_go_command(split_command("go depth 8 nodes 1000"), Color::White, infinite_requested);
+    EXPECT_EQ(with_depth.max_depth, 8);
+    EXPECT_EQ(with_depth.max_nodes, 1000u);
+}
+
+TEST(UCIGoParsingTest, ParseMate) {
+    bool infinite_requested = false;
+    auto limits = parse_go_command(split_command("go mate 3"), Color::White, infinite_requested);
+    EXPECT_EQ(limits.mate_in, 3);
+    EXPECT_TRUE(limits.infinite);
+    EXPECT_EQ(limits.max_time_ms, 0);
+    EXPECT_EQ(limits.max_depth, Huginn::MAX_DEPTH);
+
+    auto timed = parse_go_command(split_command("go mate 2 movetime 500"), Color::White, infinite_requested);
+    EXPECT_EQ(timed.mate_in, 2);
+    EXPECT_EQ(timed.max_time_ms, 500);
+
+    auto bad = parse_go_command(split_command("go mate 0"), Color::White, infinite_requested);
+    EXPECT_EQ(bad.mate_in, 1);  // clamped into range like every other number
+}
+
+TEST(UCIGoParsingTest, ParseSearchmovesRunsToNextKeyword) {
+    bool infinite_requested = false;
+    auto limits = parse_go_command(split_command("go searchmoves e2e4 d2d4 depth 5"),
+                                    Color::White, infinite_requested);
+    EXPECT_EQ(limits.searchmoves, (std::vector<std::string>{"e2e4", "d2d4"}));
+    EXPECT_EQ(limits.max_depth, 5);
+
+    auto trailing = parse_go_command(split_command("go infinite searchmoves g1f3"), Color::White, infinite_requested);
+    EXPECT_EQ(trailing.searchmoves, (std::vector<std::string>{"g1f3"}));
+    EXPECT_TRUE(infinite_requested);
+
+    auto none = parse_go_command(split_command("go depth 3"), Color::White, infinite_requested);
+    EXPECT_TRUE(none.searchmoves.empty());
+}
@@ -0,0 +1,102 @@
+// user-043 UciLine / InfoThrottle: allocation-free `info` formatting, one
+// write per line, elapsed-time gating. The formatter must agree with the
+// std::string paths it replaced (S_MOVE::to_string, the old score mapping).
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "../src/init.hpp"
+#include "../src/search.hpp"
+#include "../src/uci_output.hpp"
+
+using namespace Huginn;
+
+namespace {
+
+// Counts sputn calls so "one write per line" is checked, not assumed.
+class CountingBuf : public std::stringbuf {
+public:
+    int writes = 0;
+protected:
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        ++writes;
+        return std::stringbuf::xsputn(s, n);
+    }
+};
+
+}  // namespace
+
+TEST(UciOutput, NumbersMovesAndScores) {
+    UciLine line;
+    line.num(0).chr(' ').num(-42).chr(' ').unum(18446744073709551615ull).chr(' ').num(INT64_MIN);
+    EXPECT_EQ(line.view(), "0 -42 18446744073709551615 -9223372036854775808");
+
+    line.clear();
+    line.move(make_pawn_start(12, 28)).chr(' ').move(make_promotion(48, 57, PieceType::Knight, PieceType::Rook))
+        .chr(' ').move(S_MOVE());
+    EXPECT_EQ(line.view(), "e2e4 a7b8n 0000");
+
+    for (int score : {0, 37, -250, MATE - 1, MATE - 4, -MATE + 2, -MATE + 7}) {
+        line.clear();
+        line.score(score);
+        std::string expected;
+        if (score > MATE - 100) expected = "mate " + std::to_string((MATE - score + 1) / 2);
+        else if (score < -MATE + 100) expected = "mate -" + std::to_string((MATE + score + 1) / 2);
+        else expected = "cp " + std::to_string(score);
+        EXPECT_EQ(line.view(), expected) << score;
+    }
+}
+
+TEST(UciOutput, EmitIsOneWriteAndOverflowIsTruncated) {
+    CountingBuf buf;
+    std::ostream os(&buf);
+    UciLine line;
+    line.str("info depth ").num(7).str(" pv e2e4 e7e5");
+    line.emit(os);
+    EXPECT_EQ(buf.writes, 1);
+    EXPECT_EQ(buf.str(), "info depth 7 pv e2e4 e7e5\n");
+    EXPECT_TRUE(line.empty());
+
+    for (int i = 0; i < 400; ++i) line.str("e2e4 ");
+    EXPECT_EQ(line.view().size(), UciLine::CAPACITY - 1) << "room stays for the newline";
+    line.emit(os);
+    EXPECT_EQ(buf.writes, 2);
+    EXPECT_EQ(buf.str().back(), '\n');
+}
+
+TEST(UciOutput, ThrottleSpacesIterationLines) {
+    InfoThrottle t;
+    t.reset();
+    EXPECT_TRUE(t.allow_iteration(0));
+    EXPECT_FALSE(t.allow_iteration(InfoThrottle::INFO_INTERVAL_MS - 1));
+    EXPECT_TRUE(t.allow_iteration(InfoThrottle::INFO_INTERVAL_MS));
+    EXPECT_FALSE(InfoThrottle::allow_currmove(InfoThrottle::CURRMOVE_AFTER_MS - 1));
+    EXPECT_TRUE(InfoThrottle::allow_currmove(InfoThrottle::CURRMOVE_AFTER_MS));
+}
+
+// A fast fixed-depth search holds back most iteration lines, but the final
+// depth is always printed, and nothing is printed twice.
+TEST(UciOutput, SearchAlwaysPrintsFinalDepth) {
+    Huginn::init();
+    Engine engine;
+    Position pos;
+    pos.set_startpos();
+    SearchInfo info;
+    info.max_depth = 6;
+    info.infinite = true;
+    info.depth_only = true;
+
+    std::ostringstream out;
+    std::streambuf* saved = std::cout.rdbuf(out.rdbuf());
+    engine.searchPosition(pos, info);
+    std::cout.rdbuf(saved);
+
+    const std::string s = out.str();
+    const size_t last = s.rfind("info depth 6 ");
+    ASSERT_NE(last, std::string::npos) << s;
+    EXPECT_EQ(s.find("info depth 6 "), last);
+    EXPECT_NE(s.find(" score cp ", last), std::string::npos);
+    EXPECT_NE(s.find(" pv ", last), std::string::npos);
+    EXPECT_EQ(s.find("currmove"), std::string::npos);
+}
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 #include "uci.hpp"
+#include "uci_utils.hpp"
+#include "bench.hpp"
+#include "init.hpp"
+#include <random>
 #include <sstream>
 
 // BACKLOG #60 parser-purity refactor: these used to only assert
@@ -84,3 +88,111 @@ TEST_F(UCIPositionTest, ParseMalformedCastlingFlagIsRejected) {
         "position fen 2r1k2r/2pn1pp1/1p3n1p/p3PP2/4q2B/P1P5/2Q1N1PP/R4RK1 w q - 0 1"));
     EXPECT_EQ(uci.current_position().to_fen(), kStartposFen);
 }
+
+// --- user-042: incremental `position ... moves` ------------------------------
+
+namespace {
+// A reproducible random game from the start position, as UCI move strings.
+std::vector<std::string> random_game(int plies, unsigned seed) {
+    std::mt19937 rng(seed);
+    Position pos;
+    pos.set_startpos();
+    std::vector<std::string> moves;
+    for (int i = 0; i < plies; ++i) {
+        S_MOVELIST legal;
+        generate_legal_moves(pos, legal);
+        if (legal.count == 0) break;
+        const S_MOVE m = legal.moves[rng() % legal.count];
+        moves.push_back(m.to_string());
+        pos.MakeMove(m);
+    }
+    return moves;
+}
+}  // namespace
+
+// Growing the game one move per command (how GUIs send it) must land on the
+// same root as one full rebuild — board, hash, ply and the repetition history.
+TEST_F(UCIPositionTest, IncrementalExtensionMatchesFullRebuild) {
+    const auto game = random_game(160, 42);
+    std::string cmd = "position startpos moves";
+    for (const auto& m : game) {
+        cmd += " " + m;
+        uci.handle_position(split_command(cmd));
+    }
+    UCIInterface fresh;
+    fresh.handle_position(split_command(cmd));
+
+    const Position& a = uci.current_position();
+    const Position& b = fresh.current_position();
+    EXPECT_EQ(a.to_fen(), b.to_fen());
+    EXPECT_EQ(a.zobrist_key, b.zobrist_key);
+    ASSERT_EQ(a.ply, b.ply);
+    for (int i = 0; i < a.ply; ++i) {
+        EXPECT_EQ(a.move_history[i].zobrist_key, b.move_history[i].zobrist_key) << "ply " << i;
+    }
+}
+
+TEST_F(UCIPositionTest, IncrementalBadMoveRejectsWholeCommand) {
+    const std::string after_e4 = "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1";
+    uci.handle_position(split_command("position startpos moves e2e4"));
+    ASSERT_EQ(uci.current_position().to_fen(), after_e4);
+
+    // e7e5 is fine, e1e3 is not: nothing of the command may stick.
+    uci.handle_position(split_command("position startpos moves e2e4 e7e5 e1e3"));
+    EXPECT_EQ(uci.current_position().to_fen(), after_e4);
+
+    uci.handle_position(split_command("position startpos moves e2e4 e7e5"));
+    EXPECT_EQ(uci.current_position().to_fen(),
+              "rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2");
+}
+
+TEST_F(UCIPositionTest, TakebackAndNewBaseRebuild) {
+    uci.handle_position(split_command("position startpos moves e2e4 e7e5 g1f3"));
+    uci.handle_position(split_command("position startpos moves e2e4"));
+    EXPECT_EQ(uci.current_position().to_fen(),
+              "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1");
+
+    // Same moves, different base: must not be treated as an extension.
+    uci.handle_position(split_command(
+        "position fen rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1 moves e7e5"));
+    EXPECT_EQ(uci.current_position().to_fen(),
+              "rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2");
+}
+
+// parse_uci_move builds the move from the board instead of searching the
+// legal list; it must agree with the list for every from/to/promotion text.
+TEST(UCIParseMove, AgreesWithLegalGeneration) {
+    Huginn::init();
+    std::vector<std::string> fens = Huginn::bench_positions();
+    fens.push_back("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    fens.push_back("r3k2r/8/8/8/8/5b2/8/R3K2R w KQkq - 0 1");
+    fens.push_back("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3");
+    fens.push_back("1r2k3/P6P/8/8/8/8/p6p/1R2K1R1 w - - 0 1");
+    fens.push_back("4k3/8/8/KPp4r/8/8/8/8 w - c6 0 1");  // ep capture exposes the king
+
+    const char* const promos[] = {"", "q", "r", "b", "n", "k", "x"};
+    int accepted = 0;
+    for (const auto& fen : fens) {
+        Position pos;
+        ASSERT_TRUE(pos.set_from_fen(fen));
+        const uint64_t key = pos.zobrist_key;
+        S_MOVELIST legal;
+        generate_legal_moves(pos, legal);
+        for (int from = 0; from < 64; ++from) {
+            for (int to = 0; to < 64; ++to) {
+                for (const char* promo : promos) {
+                    const std::string text = square_to_string(from) + square_to_string(to) + promo;
+                    int expected = 0;
+                    for (int i = 0; i < legal.count; ++i) {
+                        if (legal.moves[i].to_string() == text) expected = legal.moves[i].move;
+                    }
+                    const S_MOVE got = parse_uci_move(text, pos);
+                    ASSERT_EQ(got.move, expected) << fen << " " << text;
+                    accepted += (expected != 0);
+                }
+            }
+        }
+        EXPECT_EQ(pos.zobrist_key, key) << "parse_uci_move left the position changed";
+    }
+    EXPECT_GT(accepted, 500);
+}
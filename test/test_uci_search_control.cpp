@@ -1,11 +1,13 @@
 // BACKLOG #56 (part 2): search-control contract at the UCI boundary.
 //
-// Covers the mid-search command pump (isready answered without stopping,
+// Covers mid-search command handling (isready answered without stopping,
 // stop/quit applied, other commands queued in order), the race-free
 // cancellation channel (signal_stop -> engine atomic only; SearchInfo has a
-// single writer), the `go infinite` bestmove lifetime (no bestmove until
-// stop), silent startup (no unsolicited stdout before `uci`), and the
-// Syzygy default-disabled contract. The end-to-end pipe behaviour (real
+// single writer), the asynchronous `go` (user-040: the command loop stays
+// free while the worker searches), the `go infinite` bestmove lifetime (no
+// bestmove until stop), pondering (user-041), the nodes/mate/searchmoves limits
+// (user-045), silent startup (no unsolicited stdout before `uci`),
+// and the Syzygy default-disabled contract. The end-to-end pipe behaviour (real
 // stdin) is exercised by test_uci_transcript.cpp against the huginn binary.
 
 #include "gtest/gtest.h"
@@ -14,19 +16,50 @@
 #include "../src/syzygy_tablebase.hpp"
 #include <atomic>
 #include <chrono>
-#include <sstream>
+#include <mutex>
+#include <streambuf>
+#include <string>
 #include <thread>
 
 namespace {
 
-// RAII stdout capture (same pattern as the existing UCI stop tests).
+// Capture sink that the search worker and the test thread can write at the
+// same time (std::stringbuf cannot): no put area, so every write reaches
+// overflow()/xsputn() and takes the lock.
+class LockedStringBuf : public std::streambuf {
+public:
+    std::string str() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return text_;
+    }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+        std::lock_guard<std::mutex> lock(mutex_);
+        text_ += traits_type::to_char_type(ch);
+        return ch;
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        text_.append(s, static_cast<size_t>(n));
+        return n;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::string text_;
+};
+
+// RAII stdout capture (same pattern as the existing UCI stop tests), over
+// the locked sink because `go` searches on the worker thread (user-040).
 class CaptureCout {
 public:
-    CaptureCout() : old_buf(std::cout.rdbuf(oss.rdbuf())) {}
+    CaptureCout() : old_buf(std::cout.rdbuf(&buf)) {}
     ~CaptureCout() { std::cout.rdbuf(old_buf); }
-    std::string str() const { return oss.str(); }
+    std::string str() const { return buf.str(); }
 private:
-    std::ostringstream oss;
+    LockedStringBuf buf;
     std::streambuf* old_buf;
 };
 
@@ -43,14 +76,13 @@ const std::vector<std::string> MATED_ROOT_POSITION =
 TEST(UciSearchControl, IsreadyDuringSearchAnswersWithoutStopping) {
     Huginn::init();
     UCIInterface uci;
-    Huginn::SearchInfo info;
 
     CaptureCout cap;
-    bool keep_pumping = uci.handle_search_input_line("isready", info);
+    bool keep_pumping = uci.handle_search_input_line("isready");
 
     EXPECT_TRUE(keep_pumping);
-    EXPECT_FALSE(info.stopped) << "isready must not stop the search";
-    EXPECT_FALSE(info.quit);
+    EXPECT_FALSE(uci.stop_requested()) << "isready must not stop the search";
+    EXPECT_FALSE(uci.quit_requested());
     EXPECT_NE(cap.str().find("readyok"), std::string::npos);
     EXPECT_TRUE(uci.pending().empty()) << "isready is answered, not queued";
 }
@@ -58,41 +90,38 @@ TEST(UciSearchControl, IsreadyDuringSearchAnswersWithoutStopping) {
 TEST(UciSearchControl, StopLineStopsSearchOnly) {
     Huginn::init();
     UCIInterface uci;
-    Huginn::SearchInfo info;
 
     CaptureCout cap;
-    bool keep_pumping = uci.handle_search_input_line("stop", info);
+    bool keep_pumping = uci.handle_search_input_line("stop");
 
     EXPECT_FALSE(keep_pumping);
-    EXPECT_TRUE(info.stopped);
-    EXPECT_FALSE(info.quit) << "stop is not quit";
+    EXPECT_TRUE(uci.stop_requested());
+    EXPECT_FALSE(uci.quit_requested()) << "stop is not quit";
     EXPECT_TRUE(uci.pending().empty());
 }
 
 TEST(UciSearchControl, QuitLineStopsAndQuits) {
     Huginn::init();
     UCIInterface uci;
-    Huginn::SearchInfo info;
 
     CaptureCout cap;
-    bool keep_pumping = uci.handle_search_input_line("quit", info);
+    bool keep_pumping = uci.handle_search_input_line("quit");
 
     EXPECT_FALSE(keep_pumping);
-    EXPECT_TRUE(info.stopped);
-    EXPECT_TRUE(info.quit);
+    EXPECT_TRUE(uci.stop_requested());
+    EXPECT_TRUE(uci.quit_requested());
 }
 
 TEST(UciSearchControl, NonControlCommandsQueueInOrderWithoutStopping) {
     Huginn::init();
     UCIInterface uci;
-    Huginn::SearchInfo info;
 
     CaptureCout cap;
-    EXPECT_TRUE(uci.handle_search_input_line("position startpos moves e2e4", info));
-    EXPECT_TRUE(uci.handle_search_input_line("setoption name Hash value 32", info));
-    EXPECT_TRUE(uci.handle_search_input_line("go movetime 100", info));
+    EXPECT_TRUE(uci.handle_search_input_line("position startpos moves e2e4"));
+    EXPECT_TRUE(uci.handle_search_input_line("setoption name Hash value 32"));
+    EXPECT_TRUE(uci.handle_search_input_line("go movetime 100"));
 
-    EXPECT_FALSE(info.stopped)
+    EXPECT_FALSE(uci.stop_requested())
         << "queued commands must not stop the search (#56: the old poll "
            "classified ANY pending line as a stop)";
     ASSERT_EQ(uci.pending().size(), 3u);
@@ -104,14 +133,13 @@ TEST(UciSearchControl, NonControlCommandsQueueInOrderWithoutStopping) {
 TEST(UciSearchControl, PonderhitAndEmptyLinesIgnored) {
     Huginn::init();
     UCIInterface uci;
-    Huginn::SearchInfo info;
 
     CaptureCout cap;
-    EXPECT_TRUE(uci.handle_search_input_line("ponderhit", info));
-    EXPECT_TRUE(uci.handle_search_input_line("", info));
-    EXPECT_TRUE(uci.handle_search_input_line("   ", info));
+    EXPECT_TRUE(uci.handle_search_input_line("ponderhit"));
+    EXPECT_TRUE(uci.handle_search_input_line(""));
+    EXPECT_TRUE(uci.handle_search_input_line("   "));
 
-    EXPECT_FALSE(info.stopped);
+    EXPECT_FALSE(uci.stop_requested());
     EXPECT_TRUE(uci.pending().empty());
 }
 
@@ -128,6 +156,52 @@ TEST(UciSearchControl, DispatchCommandQuitReturnsFalse) {
     EXPECT_FALSE(uci.dispatch_command("quit"));
 }
 
+// --- Asynchronous go (user-040) ----------------------------------------------
+
+TEST(UciSearchControl, GoReturnsAtOnceAndCommandsRouteWhileSearching) {
+    Huginn::init();
+    UCIInterface uci;
+    CaptureCout cap;
+
+    auto t0 = std::chrono::steady_clock::now();
+    EXPECT_TRUE(uci.dispatch_command("go infinite"));
+    const auto go_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - t0).count();
+    EXPECT_LT(go_ms, 100) << "go blocked the command loop";
+    EXPECT_TRUE(uci.searching());
+
+    // Mid-search lines go through the search-time handler: isready is
+    // answered, position is queued and does not touch the searched root.
+    EXPECT_TRUE(uci.dispatch_command("isready"));
+    EXPECT_TRUE(uci.dispatch_command("position startpos moves e2e4"));
+    ASSERT_EQ(uci.pending().size(), 1u);
+    EXPECT_TRUE(uci.searching()) << "isready or position ended the search";
+
+    // readyok (this thread) must land before the worker's bestmove
+    EXPECT_TRUE(uci.dispatch_command("stop"));
+    uci.wait_for_search();
+    EXPECT_FALSE(uci.searching());
+    const std::string out = cap.str();
+    const size_t ready = out.find("readyok");
+    ASSERT_NE(ready, std::string::npos);
+    EXPECT_NE(out.find("bestmove", ready), std::string::npos) << "readyok was not answered mid-search";
+    EXPECT_EQ(uci.current_position().to_fen(),
+              "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1")
+        << "the queued position command must wait for the run() loop to replay it";
+}
+
+TEST(UciSearchControl, QuitDuringSearchStopsWorker) {
+    Huginn::init();
+    UCIInterface uci;
+    CaptureCout cap;
+
+    EXPECT_TRUE(uci.dispatch_command("go infinite"));
+    EXPECT_FALSE(uci.dispatch_command("quit"));
+    uci.wait_for_search();
+    EXPECT_NE(cap.str().find("bestmove"), std::string::npos)
+        << "quit must still release the running search's bestmove";
+}
+
 // --- go infinite: bestmove lifetime ------------------------------------------
 
 TEST(UciSearchControl, InfiniteHoldsBestmoveUntilStopOnNaturalCompletion) {
@@ -137,11 +211,12 @@ TEST(UciSearchControl, InfiniteHoldsBestmoveUntilStopOnNaturalCompletion) {
 
     CaptureCout cap;
     // The mated-root search itself finishes in well under a millisecond; if
-    // handle_go returns before signal_stop() fires, the hold is broken.
+    // the worker finishes before signal_stop() fires, the hold is broken.
     std::atomic<long long> search_ms{-1};
     std::thread search([&uci, &search_ms]() {
         auto t0 = std::chrono::steady_clock::now();
         uci.handle_go({"go", "infinite"});
+        uci.wait_for_search();
         search_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::steady_clock::now() - t0).count();
     });
@@ -167,6 +242,7 @@ TEST(UciSearchControl, StopReleasesInfiniteSearchPromptly) {
     std::thread search([&uci, &search_ms]() {
         auto t0 = std::chrono::steady_clock::now();
         uci.handle_go({"go", "infinite"});
+        uci.wait_for_search();
         search_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::steady_clock::now() - t0).count();
     });
@@ -179,6 +255,54 @@ TEST(UciSearchControl, StopReleasesInfiniteSearchPromptly) {
     EXPECT_NE(cap.str().find("bestmove"), std::string::npos);
 }
 
+// --- Pondering (user-041) ----------------------------------------------------
+
+// A ponder search ignores its clock until ponderhit, then stops on it — with
+// the pondering time already counted, a 1 s clock's budget is long gone.
+TEST(UciSearchControl, PonderSearchWaitsForPonderhitThenMovesWithPonderToken) {
+    Huginn::init();
+    UCIInterface uci;
+    CaptureCout cap;
+
+    EXPECT_TRUE(uci.dispatch_command("position startpos moves e2e4"));
+    EXPECT_TRUE(uci.dispatch_command("go ponder wtime 1000 btime 1000"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    // searching() stays true until bestmove is out; the capture buffer is
+    // only read once the worker is done with it.
+    EXPECT_TRUE(uci.searching()) << "ponder search obeyed the clock before ponderhit";
+
+    auto t0 = std::chrono::steady_clock::now();
+    EXPECT_TRUE(uci.dispatch_command("ponderhit"));
+    uci.wait_for_search();
+    const auto hit_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - t0).count();
+
+    EXPECT_LT(hit_ms, 500) << "ponderhit did not credit the time already spent";
+    EXPECT_FALSE(uci.stop_requested()) << "ponderhit is not a stop";
+    const std::string out = cap.str();
+    const size_t bm = out.find("bestmove ");
+    ASSERT_NE(bm, std::string::npos);
+    EXPECT_NE(out.find(" ponder ", bm), std::string::npos)
+        << "bestmove should offer the PV reply: " << out.substr(bm);
+}
+
+// A ponder search that runs out of depth still holds bestmove until the GUI
+// resolves it; stop (the opponent played something else) releases it.
+TEST(UciSearchControl, PonderHoldsNaturalCompletionUntilStop) {
+    Huginn::init();
+    UCIInterface uci;
+    uci.handle_position(MATED_ROOT_POSITION);
+    CaptureCout cap;
+
+    uci.handle_go({"go", "ponder", "movetime", "10"});
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_TRUE(uci.searching()) << "bestmove sent before stop";
+
+    uci.signal_stop();
+    uci.wait_for_search();
+    EXPECT_NE(cap.str().find("bestmove"), std::string::npos);
+}
+
 // --- Cancellation channel: stress the atomic stop path ------------------------
 //
 // The #56 rework removed the cross-thread writes into the stack SearchInfo
@@ -197,6 +321,7 @@ TEST(UciSearchControl, RepeatedStopStressAlwaysReleasesWithOneBestmove) {
         CaptureCout cap;
         std::thread search([&uci]() {
             uci.handle_go({"go", "movetime", "5000"});
+            uci.wait_for_search();
         });
         // Vary the stop timing across iterations to catch different search phases.
         std::this_thread::sleep_for(std::chrono::milliseconds(5 + 10 * (i % 4)));
@@ -232,7 +357,10 @@ TEST(UciSearchControl, OptionsAdvertiseSyzygyDisabledAndNoFalsePromises) {
     EXPECT_NE(out.find("option name SyzygyPath type string default <empty>"), std::string::npos)
         << "SyzygyPath must default to disabled, not a hard-coded path";
     EXPECT_EQ(out.find("Threads"), std::string::npos);
-    EXPECT_EQ(out.find("Ponder"), std::string::npos);
+    EXPECT_NE(out.find("option name Ponder type check default false"), std::string::npos)
+        << "user-041: pondering is implemented and advertised";
+    EXPECT_NE(out.find("option name MultiPV type spin default 1 min 1 max 64"), std::string::npos)
+        << "user-044: MultiPV analysis lines";
 }
 
 TEST(UciSearchControl, SyzygyEmptyPathMeansDisabled) {
@@ -240,3 +368,64 @@ TEST(UciSearchControl, SyzygyEmptyPathMeansDisabled) {
     EXPECT_FALSE(tb.initialize("")) << "empty path must mean disabled, not c:\\TB\\";
     EXPECT_FALSE(tb.is_available());
 }
+
+// user-045: `go nodes` is enforced in checkup, which is scheduled to poll at
+// the budget, so the overshoot is tiny and the same on every run.
+TEST(UciSearchControl, NodeBudgetStopsSearchReproducibly) {
+    Huginn::init();
+    auto run = [] {
+        Huginn::Engine engine;
+        Position pos;
+        pos.set_startpos();
+        Huginn::SearchInfo info;
+        info.max_depth = Huginn::MAX_DEPTH;
+        info.infinite = true;
+        info.max_nodes = 20000;
+        CaptureCout cap;
+        const S_MOVE best = engine.searchPosition(pos, info);
+        EXPECT_NE(best.move, 0);
+        return info.nodes;
+    };
+    const uint64_t first = run();
+    EXPECT_GE(first, 20000u);
+    EXPECT_LT(first, 20000u + 64u);
+    EXPECT_EQ(run(), first);
+}
+
+TEST(UciSearchControl, GoMateStopsOnceMateIsProven) {
+    Huginn::init();
+    UCIInterface uci;
+    uci.handle_position({"position", "fen", "6k1/5ppp/8/8/8/8/8/R5K1", "w", "-", "-", "0", "1"});
+    CaptureCout cap;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    uci.handle_go({"go", "mate", "1"});
+    uci.wait_for_search();
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - t0).count();
+
+    const std::string out = cap.str();
+    EXPECT_NE(out.find("score mate 1"), std::string::npos) << out;
+    EXPECT_NE(out.find("bestmove a1a8"), std::string::npos) << out;
+    EXPECT_EQ(out.find("info depth 4 "), std::string::npos) << "kept deepening after the mate:\n" << out;
+    EXPECT_LT(ms, 1000);
+}
+
+TEST(UciSearchControl, SearchmovesRestrictsTheRoot) {
+    Huginn::init();
+    UCIInterface uci;
+    uci.handle_position({"position", "startpos"});
+    CaptureCout cap;
+
+    // e2e5 is not legal here and is ignored; the rest limit the root.
+    uci.handle_go({"go", "depth", "4", "searchmoves", "a2a3", "e2e5", "h2h3"});
+    uci.wait_for_search();
+
+    const std::string out = cap.str();
+    const size_t bm = out.find("bestmove ");
+    ASSERT_NE(bm, std::string::npos) << out;
+    const std::string best = out.substr(bm + 9, 4);
+    EXPECT_TRUE(best == "a2a3" || best == "h2h3") << out;
+    EXPECT_EQ(out.find(" pv e2e4"), std::string::npos) << out;
+    EXPECT_EQ(out.find(" pv d2d4"), std::string::npos) << out;
+}
@@ -135,6 +135,7 @@ TEST(UciTimeAllocation, TinyClockGoReturnsPromptly) {
     auto old_buf = std::cout.rdbuf(oss.rdbuf());
     auto t0 = std::chrono::steady_clock::now();
     uci.handle_go({"go", "wtime", "10", "btime", "10"});
+    uci.wait_for_search();
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::steady_clock::now() - t0).count();
     std::cout.rdbuf(old_buf);
@@ -153,6 +154,7 @@ TEST(UciTimeAllocation, JunkGoTokensDoNotCrashOrHang) {
     auto old_buf = std::cout.rdbuf(oss.rdbuf());
     // Junk wtime is ignored; the valid movetime bounds the search.
     uci.handle_go({"go", "wtime", "12junk", "movetime", "100", "movestogo", "nope"});
+    uci.wait_for_search();
     std::cout.rdbuf(old_buf);
 
     EXPECT_NE(oss.str().find("bestmove"), std::string::npos);
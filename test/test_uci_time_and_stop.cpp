@@ -18,6 +18,7 @@ int main() {
     // Run search_best_move in a separate thread
     std::thread search_thread([&uci, &go_cmd]() {
         uci.handle_go(go_cmd);
+        uci.wait_for_search();
     });
 
     // Wait briefly and then send stop
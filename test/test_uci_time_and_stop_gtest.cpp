@@ -26,6 +26,7 @@ TEST(UCIIntegration, StopInterruptsQuicklyAndReturnsBestMove) {
     // Run search in background
     std::thread search_thread([&uci, &go_cmd]() {
         uci.handle_go(go_cmd);
+        uci.wait_for_search();
     });
 
     // Wait a short time then stop
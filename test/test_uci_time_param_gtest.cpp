@@ -28,6 +28,7 @@ TEST_P(UCIParamTest, StopInterruptsQuicklyAcrossVariants) {
 
     std::thread search_thread([&uci, &go_cmd]() {
         uci.handle_go(go_cmd);
+        uci.wait_for_search();
     });
 
     // Stop after a short delay
@@ -172,7 +172,8 @@ TEST(UciTranscript, SilentUntilUciThenHonestOptions) {
     EXPECT_NE(t.find("id name Huginn"), std::string::npos);
     EXPECT_NE(t.find("option name SyzygyPath type string default <empty>"), std::string::npos);
     EXPECT_EQ(t.find("option name Threads"), std::string::npos);
-    EXPECT_EQ(t.find("option name Ponder"), std::string::npos);
+    EXPECT_NE(t.find("option name Ponder type check default false"), std::string::npos);
+    EXPECT_NE(t.find("option name MultiPV type spin"), std::string::npos);
 
     eng.send("quit");
     EXPECT_TRUE(eng.wait_exit(2000));
@@ -0,0 +1,183 @@
+/**
+ * @file book_builder.cpp
+ * @brief Sharded (key, move) aggregation and Polyglot output (user-047).
+ */
+#include "book_builder.hpp"
+
+#include "pgn.hpp"
+#include "polyglot_keys.hpp"
+#include "position.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+namespace Huginn {
+namespace BookGen {
+
+namespace {
+
+constexpr std::size_t BATCH_RECORDS = 4096;
+
+void put_be(unsigned char* p, uint64_t v, int bytes) {
+    for (int i = bytes - 1; i >= 0; --i) {
+        p[i] = static_cast<unsigned char>(v & 0xFF);
+        v >>= 8;
+    }
+}
+
+std::size_t slot_hash(uint64_t key, uint16_t move) {
+    return static_cast<std::size_t>(key ^ (uint64_t(move) * 0x9E3779B97F4A7C15ULL));
+}
+
+} // namespace
+
+MoveStats& BookBuilder::StatsTable::at(uint64_t key, uint16_t move) {
+    if (4 * (count_ + 1) > 3 * slots_.size()) grow();  // keep load <= 75%
+    const std::size_t mask = slots_.size() - 1;
+    for (std::size_t i = slot_hash(key, move) & mask;; i = (i + 1) & mask) {
+        Slot& slot = slots_[i];
+        if (!slot.used) {
+            slot.used = true;
+            slot.key = key;
+            slot.move = move;
+            ++count_;
+            return slot.stats;
+        }
+        if (slot.key == key && slot.move == move) return slot.stats;
+    }
+}
+
+void BookBuilder::StatsTable::grow() {
+    std::vector<Slot> old = std::move(slots_);
+    slots_.assign(old.empty() ? 1024 : 2 * old.size(), Slot{});
+    const std::size_t mask = slots_.size() - 1;
+    for (const Slot& slot : old) {
+        if (!slot.used) continue;
+        std::size_t i = slot_hash(slot.key, slot.move) & mask;
+        while (slots_[i].used) i = (i + 1) & mask;
+        slots_[i] = slot;
+    }
+}
+
+void BookBuilder::flush(std::vector<Record>& batch, int shard) {
+    Shard& s = shards_[shard];
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        for (const Record& r : batch) {
+            MoveStats& stats = s.moves.at(r.key, r.move);
+            if (r.outcome == 0) ++stats.wins;
+            else if (r.outcome == 1) ++stats.draws;
+            else ++stats.losses;
+        }
+    }
+    batch.clear();
+}
+
+void BookBuilder::add_games(std::string_view pgn) {
+    Batches batches;
+    std::vector<Record> game_records;
+    Position pos;
+    uint64_t games = 0, positions = 0, skipped = 0;
+
+    PgnReader reader(pgn);
+    PgnGame game;
+    while (reader.next(game)) {
+        ++games;
+        if (game.result == GameResult::Unknown) { ++skipped; continue; }
+        if (game.fen.empty()) pos.set_startpos();
+        else if (!pos.set_from_fen(std::string(game.fen))) { ++skipped; continue; }
+
+        // A game only counts if every recorded move replays
+        game_records.clear();
+        bool readable = true;
+        SanTokenizer moves(game.movetext);
+        std::string_view san;
+        for (int ply = 0; ply < options_.max_ply && moves.next(san); ++ply) {
+            const uint64_t key = PolyglotKeys::compute(pos);
+            const bool white = (pos.side_to_move == Color::White);
+            const S_MOVE move = play_san(pos, san);
+            if (move.move == 0) { readable = false; break; }
+
+            uint8_t outcome = 1;
+            if (game.result == GameResult::WhiteWin) outcome = white ? 0 : 2;
+            else if (game.result == GameResult::BlackWin) outcome = white ? 2 : 0;
+            game_records.push_back(Record{key, PolyglotBook::move_to_polyglot(move), outcome});
+        }
+        if (!readable) { ++skipped; continue; }
+
+        positions += game_records.size();
+        for (const Record& r : game_records) {
+            const int shard = shard_of(r.key);
+            batches[shard].push_back(r);
+            if (batches[shard].size() >= BATCH_RECORDS) flush(batches[shard], shard);
+        }
+    }
+    for (int shard = 0; shard < SHARDS; ++shard) {
+        if (!batches[shard].empty()) flush(batches[shard], shard);
+    }
+
+    games_.fetch_add(games, std::memory_order_relaxed);
+    positions_.fetch_add(positions, std::memory_order_relaxed);
+    skipped_.fetch_add(skipped, std::memory_order_relaxed);
+}
+
+std::vector<PolyglotEntry> BookBuilder::finish() const {
+    std::vector<PolyglotEntry> entries;
+    for (const Shard& s : shards_) {
+        for (const auto& slot : s.moves.slots()) {
+            if (!slot.used) continue;
+            const MoveStats& stats = slot.stats;
+            const uint32_t seen = stats.wins + stats.draws + stats.losses;
+            const uint32_t weight = 2 * stats.wins + stats.draws;
+            if (seen < options_.min_games || weight == 0) continue;
+            entries.emplace_back(slot.key, slot.move, uint16_t(0));
+            entries.back().learn = weight;  // scratch until scaled below
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const PolyglotEntry& a, const PolyglotEntry& b) {
+        if (a.key != b.key) return a.key < b.key;
+        if (a.learn != b.learn) return a.learn > b.learn;
+        return a.move < b.move;
+    });
+
+    // Scale each position so its heaviest move fits the 16-bit weight field
+    for (std::size_t first = 0; first < entries.size();) {
+        std::size_t last = first;
+        while (last < entries.size() && entries[last].key == entries[first].key) ++last;
+        const uint64_t top = entries[first].learn;
+        for (std::size_t i = first; i < last; ++i) {
+            uint64_t w = entries[i].learn;
+            if (top > 0xFFFF) w = std::max<uint64_t>(1, w * 0xFFFF / top);
+            entries[i].weight = static_cast<uint16_t>(w);
+            entries[i].learn = 0;
+        }
+        first = last;
+    }
+    return entries;
+}
+
+bool BookBuilder::write(const std::string& path, const std::vector<PolyglotEntry>& entries) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    std::vector<unsigned char> buf(16 * 4096);
+    std::size_t used = 0;
+    for (const PolyglotEntry& e : entries) {
+        unsigned char* p = buf.data() + used;
+        put_be(p, e.key, 8);
+        put_be(p + 8, e.move, 2);
+        put_be(p + 10, e.weight, 2);
+        put_be(p + 12, e.learn, 4);
+        used += 16;
+        if (used == buf.size()) {
+            out.write(reinterpret_cast<const char*>(buf.data()), static_cast<std::streamsize>(used));
+            used = 0;
+        }
+    }
+    out.write(reinterpret_cast<const char*>(buf.data()), static_cast<std::streamsize>(used));
+    return static_cast<bool>(out);
+}
+
+} // namespace BookGen
+} // namespace Huginn
@@ -0,0 +1,110 @@
+/**
+ * @file book_builder.hpp
+ * @brief Aggregates PGN games into a Polyglot book (user-047).
+ *
+ * add_games() may be called from any number of threads at once. Each call
+ * replays its games on a private Position and buffers one record per
+ * (Polyglot key, move, result) in thread-local batches, one per shard;
+ * a full batch is merged into its shard's hash map under that shard's lock,
+ * so workers only contend when they flush into the same shard at once.
+ *
+ * finish() turns the counts into Polyglot entries: weight = 2*wins + draws
+ * from the mover's point of view (Polyglot's own make-book scoring), moves
+ * played in fewer than min_games games or never scoring are dropped, and a
+ * position whose best weight overflows 16 bits is scaled down as a whole.
+ * Entries are sorted by key, heaviest move first: the order Polyglot
+ * readers binary-search (PolyglotBook::verify_key_order checks it).
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "polyglot_book.hpp"
+
+namespace Huginn {
+namespace BookGen {
+
+struct BookGenOptions {
+    int max_ply = 40;            ///< Record positions before this ply of each game.
+    uint32_t min_games = 3;      ///< Drop moves seen in fewer games.
+};
+
+/// @brief Win/draw/loss counts for one (position, move), mover's point of view.
+struct MoveStats {
+    uint32_t wins = 0;
+    uint32_t draws = 0;
+    uint32_t losses = 0;
+};
+
+class BookBuilder {
+public:
+    static constexpr int SHARDS = 64;
+
+    explicit BookBuilder(const BookGenOptions& options) : options_(options) {}
+
+    /// @brief Replay every game in @p pgn (complete games only). Thread-safe.
+    void add_games(std::string_view pgn);
+
+    /// @brief Book entries in Polyglot order (call after all add_games()).
+    std::vector<PolyglotEntry> finish() const;
+
+    /// @brief Write @p entries as a big-endian Polyglot .bin.
+    static bool write(const std::string& path, const std::vector<PolyglotEntry>& entries);
+
+    uint64_t games() const { return games_.load(std::memory_order_relaxed); }
+    uint64_t positions() const { return positions_.load(std::memory_order_relaxed); }
+    /// @brief Games dropped for an unknown result, a bad FEN or an unreadable move.
+    uint64_t skipped() const { return skipped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Record {
+        uint64_t key;
+        uint16_t move;
+        uint8_t outcome;  // 0 win, 1 draw, 2 loss for the side to move
+    };
+
+    // Open-addressing (key, move) -> MoveStats map. A node-based map spent
+    // a third of the build chasing pointers; here one probe is one slot.
+    class StatsTable {
+    public:
+        struct Slot {
+            uint64_t key = 0;
+            uint16_t move = 0;
+            bool used = false;
+            MoveStats stats;
+        };
+
+        MoveStats& at(uint64_t key, uint16_t move);
+        const std::vector<Slot>& slots() const { return slots_; }
+
+    private:
+        void grow();
+        std::vector<Slot> slots_;
+        std::size_t count_ = 0;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        StatsTable moves;
+    };
+
+    using Batches = std::array<std::vector<Record>, SHARDS>;
+
+    static int shard_of(uint64_t key) { return static_cast<int>(key >> 58); }  // top 6 bits
+    void flush(std::vector<Record>& batch, int shard);
+
+    BookGenOptions options_;
+    std::array<Shard, SHARDS> shards_;
+    std::atomic<uint64_t> games_{0};
+    std::atomic<uint64_t> positions_{0};
+    std::atomic<uint64_t> skipped_{0};
+};
+
+} // namespace BookGen
+} // namespace Huginn
@@ -0,0 +1,168 @@
+// Opening-book builder for Huginn (user-047).
+//
+// Reads PGN collections, replays each game's opening on Position and writes
+// a Polyglot .bin that PolyglotBook::load_book (and any Polyglot reader)
+// accepts. Replaces the external scripts we used to build books with.
+//
+// Pipeline: one reader thread streams each file in CHUNK_BYTES blocks, cut at
+// the last "[Event " line so every block holds complete games; worker threads
+// parse blocks in place (string_views, no per-game copies) and aggregate
+// (Polyglot key, move) -> W/D/L in BookBuilder's sharded maps. Memory is
+// bounded by the queue depth plus the distinct (position, move) pairs seen.
+//
+// Usage:
+//   huginn_bookgen [--threads N] [--max-ply N] [--min-games N] -o book.bin games.pgn...
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "init.hpp"
+#include "polyglot_book.hpp"
+#include "book_builder.hpp"
+#include "pgn.hpp"
+
+using namespace Huginn;
+using namespace Huginn::BookGen;
+
+namespace {
+
+constexpr std::size_t CHUNK_BYTES = 8u << 20;
+
+struct Block {
+    std::shared_ptr<const std::string> text;
+    std::size_t length = 0;  ///< Complete games end here; the rest carried over.
+};
+
+// Bounded single-producer / multi-consumer queue of PGN blocks.
+class BlockQueue {
+public:
+    explicit BlockQueue(std::size_t capacity) : capacity_(capacity) {}
+
+    void push(Block block) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [&] { return blocks_.size() < capacity_; });
+        blocks_.push_back(std::move(block));
+        not_empty_.notify_one();
+    }
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+    }
+    bool pop(Block& block) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [&] { return !blocks_.empty() || closed_; });
+        if (blocks_.empty()) return false;
+        block = std::move(blocks_.front());
+        blocks_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable not_empty_, not_full_;
+    std::deque<Block> blocks_;
+    std::size_t capacity_;
+    bool closed_ = false;
+};
+
+bool stream_file(const std::string& path, BlockQueue& queue) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Error: cannot open " << path << std::endl;
+        return false;
+    }
+    std::string carry;
+    while (true) {
+        auto text = std::make_shared<std::string>(std::move(carry));
+        const std::size_t have = text->size();
+        text->resize(have + CHUNK_BYTES);
+        in.read(text->data() + have, static_cast<std::streamsize>(CHUNK_BYTES));
+        text->resize(have + static_cast<std::size_t>(in.gcount()));
+        const bool eof = !in;
+
+        const std::size_t cut = eof ? text->size() : complete_games_prefix(*text);
+        carry.assign(*text, cut, std::string::npos);  // a partial game, usually < 4 KB
+        if (cut > 0) queue.push(Block{std::move(text), cut});
+        if (eof) return true;
+    }
+}
+
+int usage() {
+    std::cerr << "usage: huginn_bookgen [--threads N] [--max-ply N] [--min-games N] "
+                 "-o book.bin games.pgn..." << std::endl;
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BookGenOptions options;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string output;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = (i + 1 < argc);
+        if (arg == "-o" && has_value) output = argv[++i];
+        else if (arg == "--threads" && has_value) threads = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--max-ply" && has_value) options.max_ply = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--min-games" && has_value) options.min_games = std::max(1, std::atoi(argv[++i]));
+        else if (!arg.empty() && arg[0] == '-') return usage();
+        else inputs.push_back(arg);
+    }
+    if (output.empty() || inputs.empty()) return usage();
+
+    Huginn::init();
+    const auto t0 = std::chrono::steady_clock::now();
+
+    BookBuilder builder(options);
+    BlockQueue queue(2 * threads);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            Block block;
+            while (queue.pop(block)) builder.add_games(std::string_view(block.text->data(), block.length));
+        });
+    }
+    bool ok = true;
+    for (const std::string& path : inputs) ok = stream_file(path, queue) && ok;
+    queue.close();
+    for (auto& w : workers) w.join();
+
+    const auto entries = builder.finish();
+    if (!BookBuilder::write(output, entries)) {
+        std::cerr << "Error: cannot write " << output << std::endl;
+        return 1;
+    }
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::cout << "games      : " << builder.games() << " (" << builder.skipped() << " skipped)\n"
+              << "positions  : " << builder.positions() << "\n"
+              << "entries    : " << entries.size() << "\n"
+              << "time       : " << secs << " s, "
+              << static_cast<uint64_t>(builder.positions() / std::max(secs, 1e-9)) << " positions/s ("
+              << threads << " threads)" << std::endl;
+
+    // Acceptance: the engine's own loader (size) plus the full key-order
+    // pass that the engine skips at load
+    PolyglotBook book;
+    if (!book.load_book(output)) return 1;
+    if (!book.verify_key_order()) {
+        std::cerr << "Error: " << output << " is not sorted by key" << std::endl;
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+/**
+ * @file pgn.cpp
+ * @brief PGN reader / SAN resolver (user-047). See pgn.hpp.
+ */
+#include "pgn.hpp"
+
+#include "chess_types.hpp"
+#include "movegen.hpp"
+#include "movegen_bb.hpp"
+
+namespace Huginn {
+namespace BookGen {
+
+namespace {
+
+bool is_space(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+GameResult parse_result(std::string_view s) {
+    if (s == "1-0") return GameResult::WhiteWin;
+    if (s == "0-1") return GameResult::BlackWin;
+    if (s == "1/2-1/2") return GameResult::Draw;
+    return GameResult::Unknown;
+}
+
+bool is_castle_token(std::string_view t) {
+    return t.substr(0, 3) == "O-O" || t.substr(0, 3) == "0-0";
+}
+
+bool is_promotion_letter(char c) { return c == 'N' || c == 'B' || c == 'R' || c == 'Q'; }
+
+PieceType piece_letter(char c) {
+    switch (c) {
+        case 'N': return PieceType::Knight;
+        case 'B': return PieceType::Bishop;
+        case 'R': return PieceType::Rook;
+        case 'Q': return PieceType::Queen;
+        case 'K': return PieceType::King;
+        default:  return PieceType::None;
+    }
+}
+
+} // namespace
+
+bool PgnReader::next(PgnGame& game) {
+    const std::size_t n = text_.size();
+    while (pos_ < n && is_space(text_[pos_])) ++pos_;
+    if (pos_ >= n) return false;
+
+    game = PgnGame{};
+    while (pos_ < n && text_[pos_] == '[') {
+        std::size_t eol = text_.find('\n', pos_);
+        if (eol == std::string_view::npos) eol = n;
+        const std::string_view line = text_.substr(pos_, eol - pos_);
+        pos_ = eol;
+        while (pos_ < n && is_space(text_[pos_])) ++pos_;
+
+        const std::size_t name_end = line.find(' ');
+        const std::size_t q1 = line.find('"');
+        const std::size_t q2 = line.rfind('"');
+        if (name_end == std::string_view::npos || q1 == std::string_view::npos || q2 <= q1) continue;
+        const std::string_view name = line.substr(1, name_end - 1);
+        const std::string_view value = line.substr(q1 + 1, q2 - q1 - 1);
+        if (name == "FEN") game.fen = value;
+        else if (name == "Result") game.result = parse_result(value);
+    }
+
+    // Movetext runs to the next line that opens a tag section
+    const std::size_t start = pos_;
+    const std::size_t next_tags = text_.find("\n[", pos_);
+    pos_ = (next_tags == std::string_view::npos) ? n : next_tags + 1;
+    game.movetext = text_.substr(start, pos_ - start);
+    return true;
+}
+
+bool SanTokenizer::next(std::string_view& san) {
+    const std::size_t n = text_.size();
+    while (pos_ < n) {
+        const char c = text_[pos_];
+        if (is_space(c)) {
+            ++pos_;
+        } else if (c == '{') {
+            const std::size_t close = text_.find('}', pos_);
+            pos_ = (close == std::string_view::npos) ? n : close + 1;
+        } else if (c == ';' || (c == '%' && (pos_ == 0 || text_[pos_ - 1] == '\n'))) {
+            const std::size_t eol = text_.find('\n', pos_);
+            pos_ = (eol == std::string_view::npos) ? n : eol + 1;
+        } else if (c == '(') {
+            // Variations nest, and may hold comments with parentheses in them
+            int depth = 0;
+            do {
+                if (text_[pos_] == '{') {
+                    const std::size_t close = text_.find('}', pos_);
+                    pos_ = (close == std::string_view::npos) ? n - 1 : close;
+                } else if (text_[pos_] == '(') {
+                    ++depth;
+                } else if (text_[pos_] == ')') {
+                    --depth;
+                }
+                ++pos_;
+            } while (pos_ < n && depth > 0);
+        } else {
+            const std::size_t start = pos_;
+            while (pos_ < n && !is_space(text_[pos_]) && text_[pos_] != '{' &&
+                   text_[pos_] != '(' && text_[pos_] != ';') {
+                ++pos_;
+            }
+            std::string_view tok = text_.substr(start, pos_ - start);
+            if (tok == "*" || parse_result(tok) != GameResult::Unknown) {
+                pos_ = n;
+                return false;
+            }
+            if (tok[0] == '$' || tok[0] == ')') continue;  // NAG, stray close
+            if (!is_castle_token(tok)) {
+                // Move numbers ("12.", "12...") may be glued to the move
+                std::size_t skip = 0;
+                while (skip < tok.size() && ((tok[skip] >= '0' && tok[skip] <= '9') || tok[skip] == '.')) ++skip;
+                tok.remove_prefix(skip);
+                if (tok.empty()) continue;
+            }
+            san = tok;
+            return true;
+        }
+    }
+    return false;
+}
+
+S_MOVE play_san(Position& pos, std::string_view san) {
+    while (!san.empty() && (san.back() == '+' || san.back() == '#' || san.back() == '!' || san.back() == '?')) {
+        san.remove_suffix(1);
+    }
+    if (san.size() < 2) return S_MOVE();
+
+    S_MOVELIST list;
+    if (is_castle_token(san)) {
+        generate_all_moves(pos, list);  // castling is only emitted by the full generator
+        const int king_file = (san.size() >= 5) ? 2 : 6;  // O-O-O : O-O
+        for (int i = 0; i < list.count; ++i) {
+            const S_MOVE m = list.moves[i];
+            if (m.is_castle() && (m.get_to() & 7) == king_file && pos.MakeMove(m)) return m;
+        }
+        return S_MOVE();
+    }
+
+    PieceType moving = PieceType::Pawn;
+    std::size_t first = 0;
+    if (const PieceType pt = piece_letter(san[0]); pt != PieceType::None) {
+        moving = pt;
+        first = 1;
+    }
+
+    // Promotion: "e8=Q", also the older "e8Q"
+    PieceType promoted = PieceType::None;
+    std::size_t end = san.size();
+    if (moving == PieceType::Pawn && is_promotion_letter(san[end - 1])) {
+        promoted = piece_letter(san[end - 1]);
+        end -= (san[end - 2] == '=') ? 2 : 1;
+    }
+    if (end < first + 2) return S_MOVE();
+
+    const int to_file = san[end - 2] - 'a';
+    const int to_rank = san[end - 1] - '1';
+    if (to_file < 0 || to_file > 7 || to_rank < 0 || to_rank > 7) return S_MOVE();
+    const int to = to_rank * 8 + to_file;
+
+    int from_file = -1, from_rank = -1;
+    for (std::size_t i = first; i < end - 2; ++i) {
+        const char c = san[i];
+        if (c >= 'a' && c <= 'h') from_file = c - 'a';
+        else if (c >= '1' && c <= '8') from_rank = c - '1';
+        else if (c != 'x' && c != '-' && c != ':') return S_MOVE();
+    }
+
+    // Only the named piece's moves can match; skipping the rest halves the
+    // cost of a ply
+    const Color us = pos.side_to_move;
+    switch (moving) {
+        case PieceType::Pawn:   BitboardMoveGen::generate_pawn_moves_bitboard(pos, list, us); break;
+        case PieceType::Knight: BitboardMoveGen::generate_knight_moves_bitboard(pos, list, us); break;
+        case PieceType::Bishop: BitboardMoveGen::generate_bishop_moves_bitboard(pos, list, us); break;
+        case PieceType::Rook:   BitboardMoveGen::generate_rook_moves_bitboard(pos, list, us); break;
+        case PieceType::Queen:  BitboardMoveGen::generate_queen_moves_bitboard(pos, list, us); break;
+        default:                BitboardMoveGen::generate_king_moves_bitboard(pos, list, us); break;
+    }
+
+    for (int i = 0; i < list.count; ++i) {
+        const S_MOVE m = list.moves[i];
+        if (m.get_to() != to || m.get_promoted() != promoted) continue;
+        const int from = m.get_from();
+        if (from_file >= 0 && (from & 7) != from_file) continue;
+        if (from_rank >= 0 && (from >> 3) != from_rank) continue;
+        if (pos.MakeMove(m)) return m;
+    }
+    return S_MOVE();
+}
+
+std::size_t complete_games_prefix(std::string_view buf) {
+    const std::size_t at = buf.rfind("\n[Event ");
+    return (at == std::string_view::npos) ? 0 : at + 1;
+}
+
+} // namespace BookGen
+} // namespace Huginn
@@ -0,0 +1,78 @@
+/**
+ * @file pgn.hpp
+ * @brief Streaming PGN reader and SAN resolver for huginn_bookgen (user-047).
+ *
+ * Nothing here copies game text: PgnReader walks a buffer of complete games
+ * and hands out string_views into it (tags, movetext), SanTokenizer walks a
+ * movetext view and yields SAN tokens, skipping move numbers, comments,
+ * variations and NAGs. play_san() resolves one token against the position by
+ * matching the pseudo-legal list and lets MakeMove() reject illegal
+ * candidates, so there is no separate legality pass per ply.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "move.hpp"
+#include "position.hpp"
+
+namespace Huginn {
+namespace BookGen {
+
+enum class GameResult { WhiteWin, Draw, BlackWin, Unknown };
+
+/// @brief One game, viewed in place inside the reader's buffer.
+struct PgnGame {
+    std::string_view fen;       ///< [FEN] tag value; empty for the standard start.
+    std::string_view movetext;  ///< Everything after the tag section.
+    GameResult result = GameResult::Unknown;  ///< From the [Result] tag.
+};
+
+/**
+ * @brief Splits a buffer of complete PGN games.
+ *
+ * A game starts at a line beginning with '[' that follows movetext (or the
+ * start of the buffer). Malformed tag lines are skipped, not fatal.
+ */
+class PgnReader {
+public:
+    explicit PgnReader(std::string_view text) : text_(text) {}
+    /// @brief Next game, or false at the end of the buffer.
+    bool next(PgnGame& game);
+
+private:
+    std::string_view text_;
+    std::size_t pos_ = 0;
+};
+
+/// @brief Iterates the SAN tokens of one game's movetext.
+class SanTokenizer {
+public:
+    explicit SanTokenizer(std::string_view movetext) : text_(movetext) {}
+    /// @brief Next SAN token (annotations like "+", "!?" still attached), or
+    ///        false at the result token or the end of the movetext.
+    bool next(std::string_view& san);
+
+private:
+    std::string_view text_;
+    std::size_t pos_ = 0;
+};
+
+/**
+ * @brief Resolve @p san in @p pos and play it.
+ * @return The move made, or a null move (position untouched) if no legal
+ *         move matches. A correctly disambiguated SAN matches one move, so
+ *         the first legal match is taken without checking the rest.
+ */
+S_MOVE play_san(Position& pos, std::string_view san);
+
+/**
+ * @brief Length of the prefix of @p buf that holds only complete games: up to
+ *        the start of the last line that begins with "[Event ". Returns 0 if
+ *        no game starts after offset 0 (the caller needs more input).
+ */
+std::size_t complete_games_prefix(std::string_view buf);
+
+} // namespace BookGen
+} // namespace Huginn
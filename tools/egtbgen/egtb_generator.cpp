@@ -0,0 +1,497 @@
+/**
+ * @file egtb_generator.cpp
+ * @brief Retrograde endgame table generator (user-048). See egtb_generator.hpp.
+ */
+#include "egtb_generator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "attack_tables.hpp"
+#include "bitboard.hpp"
+
+namespace Huginn {
+namespace EgtbGen {
+
+namespace {
+
+using Egtb::TableLayout;
+
+constexpr uint8_t UNKNOWN = Egtb::DRAW;  // unresolved while generating, a draw once done
+
+Bitboard bit(int sq) { return 1ULL << sq; }
+
+// A position as a bare piece list: all a ≤4-man ending needs, and far
+// cheaper to copy and move on than Position. Pieces stay in table layout
+// order until a capture removes one.
+struct Board {
+    int count = 0;
+    Piece pieces[Egtb::MAX_PIECES];
+    int squares[Egtb::MAX_PIECES];
+    Color stm = Color::White;
+    int ep_square = -1;
+
+    Bitboard occupied() const {
+        Bitboard occ = 0;
+        for (int i = 0; i < count; ++i) occ |= bit(squares[i]);
+        return occ;
+    }
+    Bitboard occupied_by(Color c) const {
+        Bitboard occ = 0;
+        for (int i = 0; i < count; ++i) {
+            if (color_of(pieces[i]) == c) occ |= bit(squares[i]);
+        }
+        return occ;
+    }
+    Bitboard pieces_of(Color c, PieceType t) const {
+        Bitboard bb = 0;
+        for (int i = 0; i < count; ++i) {
+            if (pieces[i] == make_piece(c, t)) bb |= bit(squares[i]);
+        }
+        return bb;
+    }
+    int king_square(Color c) const {
+        for (int i = 0; i < count; ++i) {
+            if (pieces[i] == make_piece(c, PieceType::King)) return squares[i];
+        }
+        return -1;
+    }
+    void remove(int i) {
+        --count;
+        pieces[i] = pieces[count];
+        squares[i] = squares[count];
+    }
+};
+
+Bitboard attacks_from(Piece p, int sq, Bitboard occ) {
+    switch (type_of(p)) {
+        case PieceType::Pawn:   return pawn_attacks[int(color_of(p))][sq];
+        case PieceType::Knight: return knight_attacks[sq];
+        case PieceType::Bishop: return bishop_attacks(sq, occ);
+        case PieceType::Rook:   return rook_attacks(sq, occ);
+        case PieceType::Queen:  return queen_attacks(sq, occ);
+        default:                return king_attacks[sq];
+    }
+}
+
+bool attacked(const Board& b, int sq, Color by, Bitboard occ) {
+    for (int i = 0; i < b.count; ++i) {
+        if (color_of(b.pieces[i]) == by && (attacks_from(b.pieces[i], b.squares[i], occ) & bit(sq))) return true;
+    }
+    return false;
+}
+
+bool in_check(const Board& b) {
+    return attacked(b, b.king_square(b.stm), !b.stm, b.occupied());
+}
+
+// The side that just moved is in check: the position cannot arise
+bool mover_in_check(const Board& b) {
+    return attacked(b, b.king_square(!b.stm), b.stm, b.occupied());
+}
+
+/// Calls visit(child) for every legal move of the side to move; returns how many.
+/// A double push records the en passant square only when a pawn can take on it.
+template <typename Visit>
+int for_each_move(const Board& b, Visit&& visit) {
+    const Color us = b.stm;
+    const Color them = !us;
+    const Bitboard occ = b.occupied();
+    const Bitboard own = b.occupied_by(us);
+    int legal = 0;
+
+    auto emit = [&](Board& child) {
+        child.stm = them;
+        if (mover_in_check(child)) return;
+        ++legal;
+        visit(static_cast<const Board&>(child));
+    };
+    auto move_to = [&](int i, int to, Piece placed, int ep_square) {
+        Board child = b;
+        child.ep_square = ep_square;
+        child.squares[i] = to;
+        child.pieces[i] = placed;
+        for (int j = 0; j < child.count; ++j) {
+            if (j != i && child.squares[j] == to) {
+                child.remove(j);
+                break;
+            }
+        }
+        emit(child);
+    };
+
+    for (int i = 0; i < b.count; ++i) {
+        const Piece p = b.pieces[i];
+        if (color_of(p) != us) continue;
+        const int from = b.squares[i];
+        if (type_of(p) != PieceType::Pawn) {
+            Bitboard targets = attacks_from(p, from, occ) & ~own;
+            while (targets) move_to(i, pop_lsb(targets), p, -1);
+            continue;
+        }
+
+        const int dir = (us == Color::White) ? 8 : -8;
+        const int last_rank = (us == Color::White) ? 7 : 0;
+        const int start_rank = (us == Color::White) ? 1 : 6;
+        auto pawn_to = [&](int to) {
+            if ((to >> 3) != last_rank) {
+                move_to(i, to, p, -1);
+                return;
+            }
+            for (PieceType t : {PieceType::Queen, PieceType::Rook, PieceType::Bishop, PieceType::Knight}) {
+                move_to(i, to, make_piece(us, t), -1);
+            }
+        };
+        const int one = from + dir;
+        if (!(occ & bit(one))) {
+            pawn_to(one);
+            const int two = one + dir;
+            if ((from >> 3) == start_rank && !(occ & bit(two))) {
+                const bool capturable = pawn_attacks[int(us)][one] & b.pieces_of(them, PieceType::Pawn);
+                move_to(i, two, p, capturable ? one : -1);
+            }
+        }
+        Bitboard captures = pawn_attacks[int(us)][from] & b.occupied_by(them);
+        while (captures) pawn_to(pop_lsb(captures));
+        if (b.ep_square >= 0 && (pawn_attacks[int(us)][from] & bit(b.ep_square))) {
+            Board child = b;
+            child.ep_square = -1;
+            child.squares[i] = b.ep_square;
+            for (int j = 0; j < child.count; ++j) {
+                if (child.squares[j] == b.ep_square - dir) {
+                    child.remove(j);
+                    break;
+                }
+            }
+            emit(child);
+        }
+    }
+    return legal;
+}
+
+/// Calls emit(index) for every position one non-capturing, non-promoting
+/// move before @p b (pieces in layout order). Legality is left to the caller.
+template <typename Emit>
+void for_each_unmove(const TableLayout& layout, const Board& b, Emit&& emit) {
+    const Color mover = !b.stm;
+    const Bitboard occ = b.occupied();
+    for (int i = 0; i < b.count; ++i) {
+        const Piece p = b.pieces[i];
+        if (color_of(p) != mover) continue;
+        const int sq = b.squares[i];
+        Bitboard origins = 0;
+        if (type_of(p) == PieceType::Pawn) {
+            const int dir = (mover == Color::White) ? 8 : -8;
+            const int one = sq - dir;
+            if ((one >> 3) >= 1 && (one >> 3) <= 6 && !(occ & bit(one))) {
+                origins |= bit(one);
+                const int double_rank = (mover == Color::White) ? 3 : 4;
+                if ((sq >> 3) == double_rank && !(occ & bit(one - dir))) origins |= bit(one - dir);
+            }
+        } else {
+            origins = attacks_from(p, sq, occ) & ~occ;
+        }
+        while (origins) {
+            Board pred = b;
+            pred.squares[i] = pop_lsb(origins);
+            emit(Egtb::encode(layout, pred.squares, mover));
+        }
+    }
+}
+
+/// Decode @p index; false unless it is a legal position in canonical form.
+bool decode_board(const TableLayout& layout, uint32_t index, Board& b) {
+    b.count = layout.count;
+    b.ep_square = -1;
+    std::copy(layout.pieces.begin(), layout.pieces.begin() + layout.count, b.pieces);
+    Egtb::decode(layout, index, b.squares, b.stm);
+
+    Bitboard occ = 0;
+    for (int i = 0; i < b.count; ++i) {
+        const int sq = b.squares[i];
+        if (occ & bit(sq)) return false;
+        occ |= bit(sq);
+        if (type_of(b.pieces[i]) == PieceType::Pawn && ((sq >> 3) == 0 || (sq >> 3) == 7)) return false;
+    }
+    return Egtb::encode(layout, b.squares, b.stm) == index && !mover_in_check(b);
+}
+
+uint8_t evaluate(const EndgameTables& tables, const Board& b, int n);
+
+// A child's value, or UNKNOWN unless it is decisive in fewer than n plies
+uint8_t child_value(const EndgameTables& tables, const Board& child, int n) {
+    uint8_t v = UNKNOWN;
+    if (child.ep_square >= 0) {
+        v = evaluate(tables, child, n);  // tables assume no en passant right
+    } else if (!tables.probe_squares(child.pieces, child.squares, child.count, child.stm, v)) {
+        v = UNKNOWN;
+    }
+    return (v >= Egtb::DTM_BASE && v - Egtb::DTM_BASE < n) ? v : UNKNOWN;
+}
+
+// What the children decisive in fewer than n plies prove about b
+uint8_t evaluate(const EndgameTables& tables, const Board& b, int n) {
+    int fastest_loss = INT_MAX;  // best child for us
+    int slowest_win = -1;
+    bool all_known = true;
+    const int moves = for_each_move(b, [&](const Board& child) {
+        const uint8_t v = child_value(tables, child, n);
+        if (v == UNKNOWN) {
+            all_known = false;
+            return;
+        }
+        const int d = v - Egtb::DTM_BASE;
+        if (d & 1) slowest_win = std::max(slowest_win, d);
+        else fastest_loss = std::min(fastest_loss, d);
+    });
+    if (moves == 0) return in_check(b) ? Egtb::DTM_BASE : UNKNOWN;
+    if (fastest_loss != INT_MAX) return uint8_t(Egtb::DTM_BASE + fastest_loss + 1);
+    if (all_known) return uint8_t(Egtb::DTM_BASE + slowest_win + 1);
+    return UNKNOWN;
+}
+
+/// Run fn(begin, end) over [0, count) in chunks on @p threads threads.
+template <typename Fn>
+void parallel_for(std::size_t count, int threads, Fn&& fn) {
+    constexpr std::size_t CHUNK = 1 << 14;
+    std::atomic<std::size_t> next{0};
+    auto worker = [&] {
+        for (;;) {
+            const std::size_t begin = next.fetch_add(CHUNK);
+            if (begin >= count) return;
+            fn(begin, std::min(begin + CHUNK, count));
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+}
+
+void multisets(const std::string& letters, std::size_t first, std::size_t size, std::string& cur,
+               std::vector<std::string>& out) {
+    if (cur.size() == size) {
+        out.push_back(cur);
+        return;
+    }
+    for (std::size_t i = first; i < letters.size(); ++i) {
+        cur.push_back(letters[i]);
+        multisets(letters, i, size, cur, out);
+        cur.pop_back();
+    }
+}
+
+} // namespace
+
+std::vector<std::string> all_tables(int max_pieces) {
+    const int extras = std::min(max_pieces, Egtb::MAX_PIECES) - 2;
+    std::vector<std::vector<std::string>> sets(std::max(extras, 0) + 1);
+    for (int k = 0; k <= extras; ++k) {
+        std::string cur;
+        multisets("QRBNP", 0, std::size_t(k), cur, sets[k]);
+    }
+
+    std::vector<std::string> names;
+    for (int total = 1; total <= extras; ++total) {
+        for (int w = total; w >= 0; --w) {
+            for (const std::string& white : sets[w]) {
+                for (const std::string& black : sets[total - w]) {
+                    const std::string name = Egtb::canonical_name(white, black);
+                    if (std::find(names.begin(), names.end(), name) == names.end()) names.push_back(name);
+                }
+            }
+        }
+    }
+    // Pawnless first within each size: their tables are smaller
+    std::stable_sort(names.begin(), names.end(), [](const std::string& a, const std::string& b) {
+        if (a.size() != b.size()) return a.size() < b.size();
+        return std::count(a.begin(), a.end(), 'P') < std::count(b.begin(), b.end(), 'P');
+    });
+    return names;
+}
+
+std::vector<std::string> dependencies(const std::string& name) {
+    TableLayout layout;
+    if (!Egtb::parse_layout(name, layout)) return {};
+    const std::size_t second_king = name.find('K', 1);
+    const std::string sides[2] = {name.substr(1, second_king - 1), name.substr(second_king + 1)};
+
+    std::vector<std::string> deps;
+    auto add = [&](const std::string& w, const std::string& b) {
+        if (w.empty() && b.empty()) return;  // KK
+        const std::string dep = Egtb::canonical_name(w, b);
+        if (std::find(deps.begin(), deps.end(), dep) == deps.end()) deps.push_back(dep);
+    };
+    for (int s = 0; s < 2; ++s) {
+        for (std::size_t i = 0; i < sides[s].size(); ++i) {
+            std::string side = sides[s];
+            side.erase(i, 1);
+            add(s == 0 ? side : sides[0], s == 0 ? sides[1] : side);
+            if (sides[s][i] != 'P') continue;
+            for (char promoted : std::string("QRBN")) {
+                side = sides[s];
+                side[i] = promoted;
+                add(s == 0 ? side : sides[0], s == 0 ? sides[1] : side);
+            }
+        }
+    }
+    return deps;
+}
+
+Generator::Generator(int threads) : threads_(std::max(1, threads)) {}
+
+bool Generator::generate(const std::string& name) {
+    TableLayout layout;
+    if (!Egtb::parse_layout(name, layout) || layout.count < 3) return false;
+    if (data_.count(name)) return true;
+    for (const std::string& dep : dependencies(name)) {
+        if (!generate(dep)) return false;
+    }
+    build(layout);
+    order_.push_back(name);
+    return true;
+}
+
+bool Generator::write(const std::string& path) const {
+    std::vector<std::pair<std::string, const std::vector<uint8_t>*>> tables;
+    for (const std::string& name : order_) tables.emplace_back(name, &data_.at(name));
+    return Egtb::write_file(path, tables);
+}
+
+void Generator::build(const TableLayout& layout) {
+    const auto t0 = std::chrono::steady_clock::now();
+    std::vector<uint8_t>& table = data_[layout.name];
+    table.assign(layout.size, UNKNOWN);
+    tables_.add_table(layout.name, table.data(), table.size());
+
+    // Start-up: legality, mates, and the pass at which each exit matters
+    std::vector<std::vector<uint32_t>> buckets(Egtb::MAX_DTM + 2);
+    std::vector<uint32_t> frontier;      // resolved by the previous pass
+    std::vector<uint32_t> en_passant;    // a double push gives the opponent an ep capture
+    std::mutex merge;
+    parallel_for(layout.size, threads_, [&](std::size_t begin, std::size_t end) {
+        std::vector<std::pair<int, uint32_t>> local_buckets;
+        std::vector<uint32_t> local_mates, local_ep;
+        for (std::size_t idx = begin; idx < end; ++idx) {
+            Board b;
+            if (!decode_board(layout, uint32_t(idx), b)) {
+                table[idx] = Egtb::ILLEGAL;
+                continue;
+            }
+            int fastest_loss = INT_MAX, slowest_win = -1;
+            bool any_exit = false, exits_all_win = true, ep = false;
+            const int moves = for_each_move(b, [&](const Board& child) {
+                if (child.ep_square >= 0) {
+                    ep = true;
+                    return;
+                }
+                if (child.count == b.count && std::equal(child.pieces, child.pieces + b.count, b.pieces)) return;
+                any_exit = true;
+                uint8_t v;
+                if (!tables_.probe_squares(child.pieces, child.squares, child.count, child.stm, v) ||
+                    v < Egtb::DTM_BASE) {
+                    exits_all_win = false;
+                    return;
+                }
+                const int d = v - Egtb::DTM_BASE;
+                if (d & 1) slowest_win = std::max(slowest_win, d);
+                else fastest_loss = std::min(fastest_loss, d);
+            });
+            if (moves == 0) {
+                if (in_check(b)) {
+                    table[idx] = Egtb::DTM_BASE;
+                    local_mates.push_back(uint32_t(idx));
+                }
+                continue;
+            }
+            if (ep) local_ep.push_back(uint32_t(idx));
+            if (fastest_loss != INT_MAX) local_buckets.emplace_back(fastest_loss + 1, uint32_t(idx));
+            else if (any_exit && exits_all_win) local_buckets.emplace_back(slowest_win + 1, uint32_t(idx));
+        }
+        std::lock_guard<std::mutex> lock(merge);
+        for (const auto& [n, idx] : local_buckets) buckets[n].push_back(idx);
+        frontier.insert(frontier.end(), local_mates.begin(), local_mates.end());
+        en_passant.insert(en_passant.end(), local_ep.begin(), local_ep.end());
+    });
+
+    // An en passant child is not stored, so a mate can run through it (and
+    // through its captures into smaller tables) with no pass resolving
+    // anything on the way: with such positions, keep going past the longest
+    // mate of the tables we depend on and past a one-pass gap
+    int dependency_dtm = 0;
+    for (const std::string& dep : dependencies(layout.name)) {
+        dependency_dtm = std::max(dependency_dtm, stats_.at(dep).max_dtm);
+    }
+    int idle = 0;
+
+    // Pass n resolves mate-in-n; stamp dedupes candidates within a pass
+    std::vector<uint8_t> stamp(layout.size, 0);
+    int n = 1;
+    for (; n <= Egtb::MAX_DTM; ++n) {
+        std::vector<uint32_t> candidates;
+        parallel_for(frontier.size(), threads_, [&](std::size_t begin, std::size_t end) {
+            std::vector<uint32_t> local;
+            for (std::size_t k = begin; k < end; ++k) {
+                Board c;
+                decode_board(layout, frontier[k], c);
+                for_each_unmove(layout, c, [&](uint32_t idx) { local.push_back(idx); });
+            }
+            std::lock_guard<std::mutex> lock(merge);
+            candidates.insert(candidates.end(), local.begin(), local.end());
+        });
+        candidates.insert(candidates.end(), buckets[n].begin(), buckets[n].end());
+        candidates.insert(candidates.end(), en_passant.begin(), en_passant.end());
+        std::vector<uint32_t>().swap(buckets[n]);
+
+        std::size_t kept = 0;
+        for (const uint32_t idx : candidates) {
+            if (table[idx] != UNKNOWN || stamp[idx] == uint8_t(n)) continue;
+            stamp[idx] = uint8_t(n);
+            candidates[kept++] = idx;
+        }
+        candidates.resize(kept);
+
+        std::vector<uint32_t> resolved;
+        parallel_for(candidates.size(), threads_, [&](std::size_t begin, std::size_t end) {
+            std::vector<uint32_t> local;
+            for (std::size_t k = begin; k < end; ++k) {
+                Board b;
+                decode_board(layout, candidates[k], b);
+                if (evaluate(tables_, b, n) == Egtb::DTM_BASE + n) local.push_back(candidates[k]);
+            }
+            std::lock_guard<std::mutex> lock(merge);
+            resolved.insert(resolved.end(), local.begin(), local.end());
+        });
+        for (const uint32_t idx : resolved) table[idx] = uint8_t(Egtb::DTM_BASE + n);
+        frontier.swap(resolved);
+
+        idle = frontier.empty() ? idle + 1 : 0;
+        const bool more_exits =
+            std::any_of(buckets.begin() + n + 1, buckets.end(), [](const auto& b) { return !b.empty(); });
+        const bool more_en_passant = !en_passant.empty() && (idle < 2 || n <= dependency_dtm + 2);
+        if (idle > 0 && !more_exits && !more_en_passant) break;
+    }
+
+    TableStats& stats = stats_[layout.name];
+    stats = TableStats{};
+    for (const uint8_t v : table) {
+        if (v == Egtb::ILLEGAL) continue;
+        if (v == UNKNOWN) {
+            ++stats.draws;
+            continue;
+        }
+        const int d = v - Egtb::DTM_BASE;
+        ++((d & 1) ? stats.wins : stats.losses);
+        stats.max_dtm = std::max(stats.max_dtm, d);
+    }
+    stats.passes = n;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace EgtbGen
+} // namespace Huginn
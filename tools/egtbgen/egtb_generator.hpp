@@ -0,0 +1,79 @@
+/**
+ * @file egtb_generator.hpp
+ * @brief Retrograde generator for Huginn's endgame tables (user-048).
+ *
+ * Builds one table at a time, smaller tables first: captures and promotions
+ * leave the table, so their values come from finished tables through
+ * EndgameTables::probe_squares(). Within a table, pass n resolves exactly
+ * the positions with mate in n plies:
+ *
+ * - Candidates for pass n are the un-move predecessors of the positions
+ *   resolved in pass n-1, the positions whose best capture/promotion exit is
+ *   worth n (queued at start-up), and the positions whose double pawn push
+ *   grants an en passant capture (re-checked every pass; only KPKP has them).
+ * - A candidate is scored by a one-ply look at its children, where anything
+ *   not yet known to be decisive in fewer than n plies counts as unknown:
+ *   a known losing child proves a win, and only all-known winning children
+ *   prove a loss. Candidates that come out at exactly n are resolved.
+ *
+ * Unresolved positions are draws once no pass makes progress. The passes
+ * are parallel over candidates; results are applied between passes.
+ */
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "endgame_tables.hpp"
+
+namespace Huginn {
+namespace EgtbGen {
+
+/// @brief Every canonical table name with 3..max_pieces pieces, fewest pieces first.
+std::vector<std::string> all_tables(int max_pieces);
+
+/// @brief Tables that captures and promotions from @p name lead into (excluding KK).
+std::vector<std::string> dependencies(const std::string& name);
+
+/// @brief Outcome counts for one generated table (legal entries, side to move's view).
+struct TableStats {
+    uint64_t wins = 0;
+    uint64_t losses = 0;
+    uint64_t draws = 0;
+    int max_dtm = 0;    ///< Longest mate in plies.
+    int passes = 0;
+    double seconds = 0.0;
+};
+
+class Generator {
+public:
+    explicit Generator(int threads);
+
+    /// @brief Generate @p name and, first, everything it depends on. False on a bad name.
+    bool generate(const std::string& name);
+
+    /// @brief Write every generated table into one file (see Egtb::write_file).
+    bool write(const std::string& path) const;
+
+    /// @brief Finished tables, in generation order.
+    const std::vector<std::string>& generated() const { return order_; }
+    const TableStats& stats(const std::string& name) const { return stats_.at(name); }
+    const std::vector<uint8_t>& data(const std::string& name) const { return data_.at(name); }
+
+    /// @brief Lookup over every finished table.
+    const EndgameTables& tables() const { return tables_; }
+
+private:
+    void build(const Egtb::TableLayout& layout);
+
+    int threads_;
+    std::map<std::string, std::vector<uint8_t>> data_;  // node-based: registered pointers stay valid
+    std::map<std::string, TableStats> stats_;
+    std::vector<std::string> order_;
+    EndgameTables tables_;
+};
+
+} // namespace EgtbGen
+} // namespace Huginn
@@ -0,0 +1,132 @@
+// Endgame table generator for Huginn (user-048).
+//
+// Generates exact depth-to-mate tables for every ending with up to four
+// pieces (kings included) and writes them into one file that the engine maps
+// through its EGTBFile option. Tables named on the command line are built
+// together with everything they depend on; with no names, the full set is.
+//
+// --verify N re-checks every Nth entry of each table against a one-ply look
+// at its children through Position / MakeMove, independent of the
+// generator's own move code.
+//
+// Usage:
+//   huginn_egtbgen [--threads N] [--max-pieces N] [--verify N] -o huginn.egtb [KQK KRKN ...]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "init.hpp"
+#include "position.hpp"
+#include "endgame_tables.hpp"
+#include "egtb_generator.hpp"
+
+using namespace Huginn;
+using namespace Huginn::EgtbGen;
+
+namespace {
+
+int usage() {
+    std::cerr << "usage: huginn_egtbgen [--threads N] [--max-pieces N] [--verify N] -o huginn.egtb [TABLE...]"
+              << std::endl;
+    return 2;
+}
+
+// Entries of @p name whose stored value disagrees with their children
+uint64_t verify(const Generator& generator, const std::string& name, uint32_t stride, uint64_t& checked) {
+    Egtb::TableLayout layout;
+    Egtb::parse_layout(name, layout);
+    const std::vector<uint8_t>& table = generator.data(name);
+    uint64_t bad = 0;
+    for (uint32_t idx = 0; idx < layout.size; idx += stride) {
+        EgtbResult stored, searched;
+        if (!Egtb::to_result(table[idx], stored)) continue;
+        int squares[Egtb::MAX_PIECES];
+        Color stm;
+        Egtb::decode(layout, idx, squares, stm);
+        Position pos;
+        pos.reset();
+        for (int i = 0; i < layout.count; ++i) pos.set_sq64(squares[i], layout.pieces[i]);
+        pos.side_to_move = stm;
+        pos.rebuild_counts();
+        pos.update_zobrist_key();
+        generator.tables().probe_root(pos, searched);
+        if (stored.wdl != searched.wdl || stored.dtm != searched.dtm) {
+            if (bad++ < 5) std::cerr << "mismatch " << name << " " << pos.to_fen() << std::endl;
+        }
+        ++checked;
+    }
+    return bad;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int threads = int(std::max(1u, std::thread::hardware_concurrency()));
+    int max_pieces = Egtb::MAX_PIECES;
+    uint32_t verify_stride = 0;
+    std::string output;
+    std::vector<std::string> names;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = (i + 1 < argc);
+        if (arg == "-o" && has_value) output = argv[++i];
+        else if (arg == "--threads" && has_value) threads = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--max-pieces" && has_value) max_pieces = std::clamp(std::atoi(argv[++i]), 3, Egtb::MAX_PIECES);
+        else if (arg == "--verify" && has_value) verify_stride = uint32_t(std::max(1, std::atoi(argv[++i])));
+        else if (!arg.empty() && arg[0] == '-') return usage();
+        else names.push_back(arg);
+    }
+    if (output.empty()) return usage();
+    if (names.empty()) names = all_tables(max_pieces);
+
+    Huginn::init();
+    const auto t0 = std::chrono::steady_clock::now();
+
+    Generator generator(threads);
+    for (const std::string& name : names) {
+        const std::size_t before = generator.generated().size();
+        if (!generator.generate(name)) {
+            std::cerr << "Error: not a table name: " << name << std::endl;
+            return 1;
+        }
+        for (std::size_t i = before; i < generator.generated().size(); ++i) {
+            const std::string& done = generator.generated()[i];
+            const TableStats& s = generator.stats(done);
+            std::cout << std::left << std::setw(6) << done << std::right
+                      << std::setw(10) << generator.data(done).size() / 1024 << " KB"
+                      << "  max dtm " << std::setw(3) << s.max_dtm
+                      << "  W " << std::setw(9) << s.wins << "  L " << std::setw(9) << s.losses
+                      << "  D " << std::setw(9) << s.draws
+                      << "  " << std::fixed << std::setprecision(2) << s.seconds << " s" << std::endl;
+        }
+    }
+
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    if (verify_stride > 0) {
+        uint64_t checked = 0, bad = 0;
+        for (const std::string& name : generator.generated()) bad += verify(generator, name, verify_stride, checked);
+        std::cout << "verified   : " << checked << " entries, " << bad << " mismatches" << std::endl;
+        if (bad > 0) return 1;
+    }
+
+    if (!generator.write(output)) {
+        std::cerr << "Error: cannot write " << output << std::endl;
+        return 1;
+    }
+    std::cout << "tables     : " << generator.generated().size() << " (" << threads << " threads, "
+              << std::fixed << std::setprecision(1) << secs << " s)" << std::endl;
+
+    // The engine's own loader is the acceptance check
+    EndgameTables tables;
+    if (!tables.load(output)) return 1;
+    std::cout << "file       : " << output << ", " << tables.get_info() << std::endl;
+    return 0;
+}
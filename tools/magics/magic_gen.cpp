@@ -0,0 +1,99 @@
+/**
+ * @file magic_gen.cpp
+ * @brief Generator / checker for the shipped slider magics (user-029).
+ *
+ * The engine no longer searches for magic multipliers at startup; it fills
+ * its attack tables from the constexpr numbers in src/magic_numbers.hpp.
+ * This tool owns that file:
+ *
+ *   magic_gen                    verify the shipped magics (exhaustive check)
+ *   magic_gen --regen-magics     re-run the deterministic PRNG search and
+ *                                print a fresh magic_numbers.hpp to stdout
+ *   magic_gen --regen-magics F   ... and write it to file F instead
+ *
+ * Regenerating with an unchanged MAGIC_SEED / finder reproduces the shipped
+ * file byte for byte; only edit the finder or seed if you mean to change it.
+ *
+ * @author MTDuke71
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "magic_bitboards.hpp"
+
+namespace {
+
+void emit_table(std::ostream& out, const char* name, const uint64_t (&magics)[64]) {
+    out << "constexpr uint64_t " << name << "[64] = {\n";
+    char buf[32];
+    for (int sq = 0; sq < 64; ++sq) {
+        if (sq % 4 == 0) out << "   ";
+        std::snprintf(buf, sizeof buf, " 0x%016llxULL,", static_cast<unsigned long long>(magics[sq]));
+        out << buf;
+        if (sq % 4 == 3) out << '\n';
+    }
+    out << "};\n";
+}
+
+std::string render_header(const uint64_t (&rook)[64], const uint64_t (&bishop)[64]) {
+    std::ostringstream out;
+    out << "/**\n"
+           " * @file magic_numbers.hpp\n"
+           " * @brief Shipped fancy-magic multipliers for rook and bishop attacks.\n"
+           " *\n"
+           " * GENERATED by `magic_gen --regen-magics` (tools/magics/magic_gen.cpp) —\n"
+           " * do not edit by hand. Index = square (a1 = 0 ... h8 = 63). Each magic\n"
+           " * hashes its square's blocker subsets into a 2^popcount(mask)-slot slice\n"
+           " * (see magic_bitboards.hpp); init_magic_bitboards() aborts if one\n"
+           " * does not.\n"
+           " */\n"
+           "#pragma once\n\n"
+           "#include <cstdint>\n\n"
+           "namespace Magic {\n\n";
+    emit_table(out, "ROOK_MAGIC_NUMBERS", rook);
+    out << '\n';
+    emit_table(out, "BISHOP_MAGIC_NUMBERS", bishop);
+    out << "\n} // namespace Magic\n";
+    return out.str();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "--regen-magics") == 0) {
+        uint64_t rook[64], bishop[64];
+        if (!Magic::search_magics(rook, bishop)) {
+            std::cerr << "magic search failed\n";
+            return 1;
+        }
+        const std::string header = render_header(rook, bishop);
+        if (argc > 2) {
+            std::ofstream file(argv[2], std::ios::binary);
+            if (!file) {
+                std::cerr << "cannot write " << argv[2] << '\n';
+                return 1;
+            }
+            file << header;
+            std::cerr << "wrote " << argv[2] << '\n';
+        } else {
+            std::cout << header;
+        }
+        return 0;
+    }
+
+    if (argc > 1) {
+        std::cerr << "usage: magic_gen [--regen-magics [output.hpp]]\n";
+        return 2;
+    }
+
+    Magic::init_magic_bitboards();   // aborts on a colliding magic
+    Magic::verify_magic_tables();    // independent exhaustive pass
+    std::cout << "shipped magics OK (" << Magic::slider_backend_name() << " backend verified)\n";
+    return 0;
+}
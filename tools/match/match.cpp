@@ -0,0 +1,194 @@
+// Self-play match runner for Huginn (user-050).
+//
+// Plays two engine configurations against each other over N concurrent game
+// slots, each on its own thread, with the options spelled the way fastchess
+// and cutechess-cli spell them so the gauntlet scripts translate directly.
+// An engine without cmd= is an in-process Huginn Engine; with cmd= it is any
+// UCI program run as a child process.
+//
+// Usage:
+//   huginn_match -engine name=dev [cmd=./huginn] [option.Hash=16 ...]
+//                -engine name=base cmd=./huginn_base
+//                [-each tc=8+0.08 [timemargin=MS] [option.X=Y ...]]
+//                [-games N | -rounds N] [-concurrency N]
+//                [-openings file=book.epd [order=random|sequential] [seed=N]]
+//                [-pgnout file=games.pgn] [-sprt elo0=0 elo1=5 alpha=0.05 beta=0.05]
+//                [-draw movenumber=40 movecount=8 score=10] [-resign movecount=3 score=600]
+//                [-maxmoves N] [-report N]
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "init.hpp"
+#include "match_runner.hpp"
+
+using namespace Huginn;
+using namespace Huginn::Match;
+
+namespace {
+
+int usage() {
+    std::cerr << "usage: huginn_match -engine name=A [cmd=PATH] [option.NAME=VALUE ...] -engine name=B ...\n"
+                 "                    [-each tc=BASE+INC [timemargin=MS] [option.NAME=VALUE ...]]\n"
+                 "                    [-games N | -rounds N] [-concurrency N]\n"
+                 "                    [-openings file=FILE [order=random|sequential] [seed=N]]\n"
+                 "                    [-pgnout file=FILE] [-sprt elo0=E0 elo1=E1 alpha=A beta=B]\n"
+                 "                    [-draw movenumber=N movecount=N score=CP] [-resign movecount=N score=CP]\n"
+                 "                    [-maxmoves N] [-report N]"
+              << std::endl;
+    return 2;
+}
+
+bool split_pair(const std::string& arg, std::string& key, std::string& value) {
+    const size_t eq = arg.find('=');
+    if (eq == std::string::npos || eq == 0) return false;
+    key = arg.substr(0, eq);
+    value = arg.substr(eq + 1);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    MatchConfig config;
+    config.concurrency = int(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<EngineConfig> engines;
+    EngineConfig each;
+    std::string openings_file, order = "sequential";
+    unsigned seed = 0;
+    int rounds = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string group = argv[i];
+        // key=value pairs up to the next -group
+        std::vector<std::pair<std::string, std::string>> pairs;
+        std::vector<std::string> plain;
+        while (i + 1 < argc && argv[i + 1][0] != '-') {
+            std::string key, value;
+            if (split_pair(argv[++i], key, value)) pairs.emplace_back(key, value);
+            else plain.push_back(argv[i]);
+        }
+        auto number = [&](int& out) {
+            if (plain.size() != 1) return false;
+            out = std::atoi(plain[0].c_str());
+            return true;
+        };
+
+        if (group == "-engine" || group == "-each") {
+            EngineConfig& e = (group == "-each") ? each : engines.emplace_back();
+            for (const auto& [key, value] : pairs) {
+                if (key == "name") e.name = value;
+                else if (key == "cmd") e.command = value;
+                else if (key.rfind("option.", 0) == 0) e.options.emplace_back(key.substr(7), value);
+                else if (key == "tc" && group == "-each") {
+                    if (!parse_time_control(value, config.game.tc)) {
+                        std::cerr << "Error: bad time control " << value << std::endl;
+                        return 2;
+                    }
+                }
+                else if (key == "timemargin" && group == "-each") config.game.tc.margin_ms = std::atoll(value.c_str());
+                else return usage();
+            }
+        } else if (group == "-games") {
+            if (!number(config.games)) return usage();
+        } else if (group == "-rounds") {
+            if (!number(rounds)) return usage();
+        } else if (group == "-concurrency") {
+            if (!number(config.concurrency)) return usage();
+        } else if (group == "-maxmoves") {
+            if (!number(config.game.adjudication.max_moves)) return usage();
+        } else if (group == "-report") {
+            if (!number(config.report_every)) return usage();
+        } else if (group == "-openings") {
+            for (const auto& [key, value] : pairs) {
+                if (key == "file") openings_file = value;
+                else if (key == "order") order = value;
+                else if (key == "seed") seed = unsigned(std::strtoul(value.c_str(), nullptr, 10));
+                else if (key != "format") return usage();  // EPD and FEN lines are both accepted
+            }
+        } else if (group == "-pgnout") {
+            for (const auto& [key, value] : pairs) {
+                if (key == "file") config.pgn_path = value;
+                else return usage();
+            }
+        } else if (group == "-sprt") {
+            config.sprt.enabled = true;
+            for (const auto& [key, value] : pairs) {
+                const double v = std::atof(value.c_str());
+                if (key == "elo0") config.sprt.elo0 = v;
+                else if (key == "elo1") config.sprt.elo1 = v;
+                else if (key == "alpha") config.sprt.alpha = v;
+                else if (key == "beta") config.sprt.beta = v;
+                else return usage();
+            }
+        } else if (group == "-draw" || group == "-resign") {
+            Adjudication& adj = config.game.adjudication;
+            const bool draw = (group == "-draw");
+            for (const auto& [key, value] : pairs) {
+                const int v = std::atoi(value.c_str());
+                if (key == "movenumber" && draw) adj.draw_move_number = v;
+                else if (key == "movecount" && draw) adj.draw_move_count = v;
+                else if (key == "score" && draw) adj.draw_score = v;
+                else if (key == "movecount") adj.resign_move_count = v;
+                else if (key == "score") adj.resign_score = v;
+                else return usage();
+            }
+        } else {
+            return usage();
+        }
+    }
+
+    if (engines.size() != 2) return usage();
+    for (size_t e = 0; e < 2; ++e) {
+        config.engines[e] = engines[e];
+        if (config.engines[e].name.empty()) config.engines[e].name = "engine" + std::to_string(e + 1);
+        // -each options first, so an engine's own setting wins
+        config.engines[e].options.insert(config.engines[e].options.begin(), each.options.begin(), each.options.end());
+    }
+    if (rounds > 0) config.games = 2 * rounds;
+    config.games += config.games % 2;  // whole colour-reversed pairs
+
+    if (!openings_file.empty()) {
+        std::ifstream in(openings_file);
+        if (!in) {
+            std::cerr << "Error: cannot read " << openings_file << std::endl;
+            return 1;
+        }
+        std::string line, fen;
+        while (std::getline(in, line)) {
+            if (parse_opening_line(line, fen)) config.openings.push_back(fen);
+        }
+        if (config.openings.empty()) {
+            std::cerr << "Error: no positions in " << openings_file << std::endl;
+            return 1;
+        }
+        if (order == "random") {
+            std::mt19937 rng(seed);
+            std::shuffle(config.openings.begin(), config.openings.end(), rng);
+        }
+    }
+
+    Huginn::init();
+    std::cout << config.engines[0].name << " vs " << config.engines[1].name << ": " << config.games
+              << " games, " << config.concurrency << " concurrent, tc " << config.game.tc.base_ms / 1000.0
+              << "+" << config.game.tc.inc_ms / 1000.0 << ", "
+              << (config.openings.empty() ? std::string("start position")
+                                          : std::to_string(config.openings.size()) + " openings")
+              << std::endl;
+
+    const MatchResult result = run_match(config, std::cout);
+    if (!result.ok) {
+        std::cerr << "Error: " << result.error << std::endl;
+        return 1;
+    }
+    if (result.time_losses || result.illegal_moves) {
+        std::cout << "Time losses " << result.time_losses << ", illegal moves " << result.illegal_moves << std::endl;
+    }
+    return 0;
+}
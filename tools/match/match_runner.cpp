@@ -0,0 +1,419 @@
+// Game loop, PGN output and the concurrent match driver for huginn_match (user-050).
+
+#include "match_runner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <thread>
+
+#include "movegen.hpp"
+#include "uci_utils.hpp"
+
+namespace Huginn {
+namespace Match {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const std::string START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+std::string square_name(int sq) {
+    return {char('a' + sq % 8), char('1' + sq / 8)};
+}
+
+char piece_letter(PieceType type) {
+    switch (type) {
+        case PieceType::Knight: return 'N';
+        case PieceType::Bishop: return 'B';
+        case PieceType::Rook:   return 'R';
+        case PieceType::Queen:  return 'Q';
+        case PieceType::King:   return 'K';
+        default:                return 'P';
+    }
+}
+
+bool is_number(const std::string& s) {
+    return !s.empty() && std::all_of(s.begin(), s.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+// Neither side can ever mate: bare kings plus at most one minor piece, or
+// only bishops, all on squares of one colour
+bool dead_position(const Position& pos) {
+    uint64_t heavy = 0, knights = 0, bishops = 0;
+    for (int c = 0; c < 2; ++c) {
+        heavy |= pos.piece_bitboards[c][int(PieceType::Pawn)] | pos.piece_bitboards[c][int(PieceType::Rook)]
+               | pos.piece_bitboards[c][int(PieceType::Queen)];
+        knights |= pos.piece_bitboards[c][int(PieceType::Knight)];
+        bishops |= pos.piece_bitboards[c][int(PieceType::Bishop)];
+    }
+    if (heavy) return false;
+    if (popcount(knights | bishops) <= 1) return true;
+    constexpr uint64_t DARK = 0xAA55AA55AA55AA55ULL;
+    return knights == 0 && ((bishops & DARK) == 0 || (bishops & ~DARK) == 0);
+}
+
+const char* color_name(Color c) {
+    return c == Color::White ? "White" : "Black";
+}
+
+Outcome win_for(Color c) {
+    return c == Color::White ? Outcome::WhiteWins : Outcome::BlackWins;
+}
+
+} // namespace
+
+std::string to_san(const Position& pos, const S_MOVE& move) {
+    const int from = move.get_from();
+    const int to = move.get_to();
+    std::string san;
+    if (move.is_castle()) {
+        san = (to % 8 > from % 8) ? "O-O" : "O-O-O";
+    } else {
+        const PieceType type = type_of(pos.at_sq64(from));
+        if (type == PieceType::Pawn) {
+            if (move.is_capture()) {
+                san += char('a' + from % 8);
+                san += 'x';
+            }
+            san += square_name(to);
+            if (move.is_promotion()) {
+                san += '=';
+                san += piece_letter(move.get_promoted());
+            }
+        } else {
+            san += piece_letter(type);
+            // Disambiguate against other legal moves of the same piece type to `to`
+            Position scratch = pos;
+            S_MOVELIST legal;
+            generate_legal_moves(scratch, legal);
+            bool ambiguous = false, same_file = false, same_rank = false;
+            for (int i = 0; i < legal.count; ++i) {
+                const S_MOVE& other = legal.moves[i];
+                const int other_from = other.get_from();
+                if (other.get_to() != to || other_from == from) continue;
+                if (type_of(pos.at_sq64(other_from)) != type) continue;
+                ambiguous = true;
+                same_file |= (other_from % 8 == from % 8);
+                same_rank |= (other_from / 8 == from / 8);
+            }
+            if (ambiguous) {
+                if (!same_file) {
+                    san += char('a' + from % 8);
+                } else if (!same_rank) {
+                    san += char('1' + from / 8);
+                } else {
+                    san += square_name(from);
+                }
+            }
+            if (move.is_capture()) san += 'x';
+            san += square_name(to);
+        }
+    }
+
+    Position after = pos;
+    if (after.MakeMove(move) == 1 && in_check(after)) {
+        S_MOVELIST replies;
+        generate_legal_moves(after, replies);
+        san += (replies.count == 0) ? '#' : '+';
+    }
+    return san;
+}
+
+bool parse_opening_line(const std::string& line, std::string& fen) {
+    std::istringstream in(line);
+    std::vector<std::string> w;
+    std::string word;
+    while (in >> word) w.push_back(word);
+    if (w.size() < 4 || w[0][0] == '#') return false;
+
+    std::string halfmove = "0", fullmove = "1";
+    if (w.size() >= 6 && is_number(w[4]) && is_number(w[5])) {
+        halfmove = w[4];
+        fullmove = w[5];
+    } else {
+        for (size_t i = 4; i + 1 < w.size(); ++i) {
+            std::string value = w[i + 1];
+            if (!value.empty() && value.back() == ';') value.pop_back();
+            if (w[i] == "hmvc" && is_number(value)) halfmove = value;
+            if (w[i] == "fmvn" && is_number(value)) fullmove = value;
+        }
+    }
+    Position pos;
+    if (!pos.set_from_fen(w[0] + " " + w[1] + " " + w[2] + " " + w[3] + " " + halfmove + " " + fullmove)) {
+        return false;
+    }
+    if (!validate_uci_position(pos)) return false;
+    fen = pos.to_fen();
+    return true;
+}
+
+bool parse_time_control(const std::string& text, TimeControl& tc) {
+    const size_t plus = text.find('+');
+    char* end = nullptr;
+    const std::string base = text.substr(0, plus);
+    const double base_s = std::strtod(base.c_str(), &end);
+    if (base.empty() || *end != '\0' || base_s <= 0) return false;
+    double inc_s = 0.0;
+    if (plus != std::string::npos) {
+        const std::string inc = text.substr(plus + 1);
+        inc_s = std::strtod(inc.c_str(), &end);
+        if (inc.empty() || *end != '\0' || inc_s < 0) return false;
+    }
+    tc.base_ms = int64_t(base_s * 1000.0 + 0.5);
+    tc.inc_ms = int64_t(inc_s * 1000.0 + 0.5);
+    return true;
+}
+
+const char* result_token(Outcome outcome) {
+    switch (outcome) {
+        case Outcome::WhiteWins: return "1-0";
+        case Outcome::BlackWins: return "0-1";
+        default:                 return "1/2-1/2";
+    }
+}
+
+GameRecord play_game(Player& white, Player& black, const std::string& start_fen,
+                     const GameConfig& config, const std::string& white_name,
+                     const std::string& black_name, uint64_t game_seed) {
+    GameRecord game;
+    game.white = white_name;
+    game.black = black_name;
+    game.start_fen = start_fen;
+
+    Position pos;
+    pos.set_from_fen(start_fen);
+    std::vector<std::string> moves;
+    std::vector<uint64_t> keys{pos.zobrist_key};  // since the last irreversible move
+    Player* players[2] = {&white, &black};
+    int64_t clock[2] = {config.tc.base_ms, config.tc.base_ms};
+    const Adjudication& adj = config.adjudication;
+    int draw_plies = 0;
+    int winning_plies[2] = {0, 0};  // consecutive plies both engines agree this colour is winning
+
+    white.new_game(game_seed);
+    black.new_game(game_seed);
+
+    auto finish = [&](Outcome outcome, std::string reason, const char* termination) {
+        game.outcome = outcome;
+        game.reason = std::move(reason);
+        game.termination = termination;
+        return game;
+    };
+
+    for (;;) {
+        const Color stm = pos.side_to_move;
+        const int us = int(stm);
+
+        // Rules first
+        S_MOVELIST legal;
+        Position scratch = pos;
+        generate_legal_moves(scratch, legal);
+        if (legal.count == 0) {
+            if (in_check(pos)) return finish(win_for(!stm), std::string(color_name(!stm)) + " mates", "normal");
+            return finish(Outcome::Draw, "Draw by stalemate", "normal");
+        }
+        if (pos.halfmove_clock >= 100) return finish(Outcome::Draw, "Draw by fifty moves rule", "normal");
+        if (std::count(keys.begin(), keys.end(), pos.zobrist_key) >= 3) {
+            return finish(Outcome::Draw, "Draw by 3-fold repetition", "normal");
+        }
+        if (dead_position(pos)) return finish(Outcome::Draw, "Draw by insufficient mating material", "normal");
+
+        // Then adjudication
+        for (Color c : {Color::White, Color::Black}) {
+            if (adj.resign_move_count > 0 && winning_plies[int(c)] >= 2 * adj.resign_move_count) {
+                return finish(win_for(c), std::string(color_name(!c)) + " resigns by adjudication", "adjudication");
+            }
+        }
+        if (adj.draw_move_count > 0 && draw_plies >= 2 * adj.draw_move_count) {
+            return finish(Outcome::Draw, "Draw by adjudication", "adjudication");
+        }
+        if (adj.max_moves > 0 && int(game.san.size()) >= 2 * adj.max_moves) {
+            return finish(Outcome::Draw, "Draw by move limit", "adjudication");
+        }
+
+        MoveRequest request;
+        request.start_fen = &start_fen;
+        request.moves = &moves;
+        request.position = &pos;
+        request.wtime_ms = clock[0];
+        request.btime_ms = clock[1];
+        request.winc_ms = request.binc_ms = config.tc.inc_ms;
+
+        const auto t0 = Clock::now();
+        const MoveReply reply = players[us]->go(request, clock[us] + config.tc.margin_ms);
+        clock[us] -= std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - t0).count();
+
+        if (reply.crashed) {
+            return finish(win_for(!stm), std::string(color_name(stm)) + " disconnects", "abandoned");
+        }
+        if (clock[us] < -config.tc.margin_ms) {
+            return finish(win_for(!stm), std::string(color_name(stm)) + " loses on time", "time forfeit");
+        }
+        bool is_legal = false;
+        for (int i = 0; i < legal.count && !is_legal; ++i) is_legal = (legal.moves[i].move == reply.move.move);
+        if (reply.move.move == 0 || !is_legal) {
+            return finish(win_for(!stm), std::string(color_name(stm)) + " makes an illegal move: " + reply.text,
+                          "rules infraction");
+        }
+        clock[us] += config.tc.inc_ms;
+
+        game.san.push_back(to_san(pos, reply.move));
+        moves.push_back(reply.move.to_string());
+        pos.MakeMove(reply.move);
+        if (pos.halfmove_clock == 0) keys.clear();
+        keys.push_back(pos.zobrist_key);
+
+        // Adjudication counters, from White's point of view
+        if (!reply.has_score) {
+            draw_plies = winning_plies[0] = winning_plies[1] = 0;
+            continue;
+        }
+        const int white_score = (stm == Color::White) ? reply.score : -reply.score;
+        const bool draw_window = pos.fullmove_number >= adj.draw_move_number
+                                 && std::abs(white_score) <= adj.draw_score;
+        draw_plies = draw_window ? draw_plies + 1 : 0;
+        winning_plies[0] = (white_score >= adj.resign_score) ? winning_plies[0] + 1 : 0;
+        winning_plies[1] = (-white_score >= adj.resign_score) ? winning_plies[1] + 1 : 0;
+    }
+}
+
+std::string to_pgn(const GameRecord& game, const std::string& event, const TimeControl& tc) {
+    char date[16] = "????.??.??";
+    const std::time_t now = std::time(nullptr);
+    if (const std::tm* t = std::localtime(&now)) std::strftime(date, sizeof(date), "%Y.%m.%d", t);
+
+    std::ostringstream out;
+    out << "[Event \"" << event << "\"]\n"
+        << "[Site \"?\"]\n"
+        << "[Date \"" << date << "\"]\n"
+        << "[Round \"" << game.round << "\"]\n"
+        << "[White \"" << game.white << "\"]\n"
+        << "[Black \"" << game.black << "\"]\n"
+        << "[Result \"" << result_token(game.outcome) << "\"]\n";
+    if (game.start_fen != START_FEN) {
+        out << "[SetUp \"1\"]\n"
+            << "[FEN \"" << game.start_fen << "\"]\n";
+    }
+    out << "[PlyCount \"" << game.san.size() << "\"]\n"
+        << "[TimeControl \"" << tc.base_ms / 1000.0 << "+" << tc.inc_ms / 1000.0 << "\"]\n"
+        << "[Termination \"" << game.termination << "\"]\n\n";
+
+    Position pos;
+    pos.set_from_fen(game.start_fen);
+    int number = pos.fullmove_number;
+    bool white_to_move = (pos.side_to_move == Color::White);
+    std::string text, line;
+    auto put = [&](const std::string& token) {
+        if (!line.empty() && line.size() + 1 + token.size() > 80) {
+            text += line + "\n";
+            line.clear();
+        }
+        line += (line.empty() ? "" : " ") + token;
+    };
+    for (size_t i = 0; i < game.san.size(); ++i) {
+        if (white_to_move) put(std::to_string(number) + ". " + game.san[i]);
+        else if (i == 0) put(std::to_string(number) + "... " + game.san[i]);
+        else put(game.san[i]);
+        if (!white_to_move) ++number;
+        white_to_move = !white_to_move;
+    }
+    put("{" + game.reason + "}");
+    put(result_token(game.outcome));
+    text += line + "\n\n";
+    out << text;
+    return out.str();
+}
+
+MatchResult run_match(const MatchConfig& config, std::ostream& report) {
+    MatchResult result;
+    const Sprt sprt(config.sprt);
+    const std::vector<std::string> openings =
+        config.openings.empty() ? std::vector<std::string>{START_FEN} : config.openings;
+
+    std::ofstream pgn;
+    if (!config.pgn_path.empty()) {
+        pgn.open(config.pgn_path, std::ios::app);
+        if (!pgn) {
+            result.ok = false;
+            result.error = "cannot write " + config.pgn_path;
+            return result;
+        }
+    }
+
+    std::atomic<int> next_game{0};
+    std::atomic<bool> stop{false};
+    std::mutex mutex;  // result, report, PGN
+    int finished = 0;
+
+    auto slot = [&]() {
+        std::unique_ptr<Player> players[2];
+        for (int e = 0; e < 2; ++e) {
+            players[e] = make_player(config.engines[e]);
+            std::string error;
+            if (!players[e]->start(error)) {
+                std::lock_guard<std::mutex> lock(mutex);
+                result.ok = false;
+                if (result.error.empty()) result.error = error;
+                stop = true;
+                return;
+            }
+        }
+        for (;;) {
+            if (stop) return;
+            const int index = next_game++;
+            if (index >= config.games) return;
+
+            // Game pair: same opening, engine 0 White in the first game
+            const std::string& fen = openings[size_t(index / 2) % openings.size()];
+            const int white = index % 2;
+            const int black = 1 - white;
+            GameRecord game = play_game(*players[white], *players[black], fen, config.game,
+                                        config.engines[white].name, config.engines[black].name,
+                                        uint64_t(index) + 1);
+            game.round = index + 1;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (game.outcome == Outcome::Draw) {
+                ++result.score.draws;
+            } else if ((game.outcome == Outcome::WhiteWins) == (white == 0)) {
+                ++result.score.wins;
+            } else {
+                ++result.score.losses;
+            }
+            if (game.termination == "time forfeit") ++result.time_losses;
+            if (game.termination == "rules infraction") ++result.illegal_moves;
+            if (pgn.is_open()) pgn << to_pgn(game, config.event, config.game.tc) << std::flush;
+
+            ++finished;
+            if (config.report_every > 0 && finished % config.report_every == 0) {
+                report << format_report(result.score, sprt) << std::endl;
+            }
+            if (config.sprt.enabled && result.decision == Sprt::Decision::Continue) {
+                result.decision = sprt.decide(result.score);
+                if (result.decision != Sprt::Decision::Continue) stop = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < std::max(1, config.concurrency); ++i) threads.emplace_back(slot);
+    for (std::thread& t : threads) t.join();
+
+    if (result.ok) {
+        report << format_report(result.score, sprt) << std::endl;
+        if (result.decision == Sprt::Decision::AcceptH1) report << "SPRT: H1 accepted" << std::endl;
+        if (result.decision == Sprt::Decision::AcceptH0) report << "SPRT: H0 accepted" << std::endl;
+    }
+    return result;
+}
+
+} // namespace Match
+} // namespace Huginn
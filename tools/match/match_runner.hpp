@@ -0,0 +1,109 @@
+/**
+ * @file match_runner.hpp
+ * @brief Games and matches for huginn_match (user-050).
+ *
+ * play_game() runs one game between two Players on a clock with increment
+ * and ends it by the rules (mate, stalemate, threefold, fifty moves, dead
+ * material), by the clock, by an illegal or missing move, or by
+ * adjudication. run_match() spreads the games over N slots, one thread each;
+ * each opening is played twice with colours reversed, finished games go to
+ * the PGN file in completion order, and the running score is reported every
+ * few games. With an SPRT configured the match stops at its first decision;
+ * games already running are finished and counted.
+ */
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "players.hpp"
+#include "position.hpp"
+#include "sprt.hpp"
+
+namespace Huginn {
+namespace Match {
+
+/// @brief "e4", "Nbd2", "exd6", "O-O", "e8=Q+", "Qh7#" for @p move in @p pos.
+std::string to_san(const Position& pos, const S_MOVE& move);
+
+/// @brief An opening line from an EPD (four FEN fields, optional "hmvc" /
+///        "fmvn" opcodes) or FEN file, as a full FEN. False for blank or
+///        comment lines and for anything that is not a legal position.
+bool parse_opening_line(const std::string& line, std::string& fen);
+
+struct TimeControl {
+    int64_t base_ms = 10000;
+    int64_t inc_ms = 100;
+    int64_t margin_ms = 0;  ///< Overrun tolerated before a time forfeit.
+};
+
+/// @brief "8+0.08" / "60" in seconds (cutechess / fastchess style).
+bool parse_time_control(const std::string& text, TimeControl& tc);
+
+/// @brief Score-based adjudication; a count of 0 disables that rule.
+struct Adjudication {
+    int draw_move_number = 0;   ///< First full move at which draws may be adjudicated.
+    int draw_move_count = 0;    ///< Consecutive moves with both |scores| <= draw_score.
+    int draw_score = 10;
+    int resign_move_count = 0;  ///< Consecutive moves with both engines agreeing on >= resign_score.
+    int resign_score = 600;
+    int max_moves = 0;          ///< Full moves after which the game is a draw.
+};
+
+struct GameConfig {
+    TimeControl tc;
+    Adjudication adjudication;
+};
+
+enum class Outcome { WhiteWins, BlackWins, Draw };
+
+struct GameRecord {
+    std::string white, black;
+    std::string start_fen;
+    std::vector<std::string> san;
+    Outcome outcome = Outcome::Draw;
+    std::string reason;        ///< "White mates", "Black loses on time", "Draw by adjudication", ...
+    std::string termination;   ///< PGN Termination tag: normal, time forfeit, adjudication, rules infraction, abandoned.
+    int round = 0;
+};
+
+/// @brief PGN result token for @p outcome: "1-0", "0-1", "1/2-1/2".
+const char* result_token(Outcome outcome);
+
+/// @brief Play one game from @p start_fen. The players must be started;
+///        @p game_seed is passed to their new_game().
+GameRecord play_game(Player& white, Player& black, const std::string& start_fen,
+                     const GameConfig& config, const std::string& white_name,
+                     const std::string& black_name, uint64_t game_seed = 0);
+
+/// @brief The game as PGN (tags, SAN movetext wrapped at 80 columns, result).
+std::string to_pgn(const GameRecord& game, const std::string& event, const TimeControl& tc);
+
+struct MatchConfig {
+    EngineConfig engines[2];
+    GameConfig game;
+    std::vector<std::string> openings;  ///< FENs; empty plays from the standard start.
+    int games = 2;                      ///< Total games, played in colour-reversed pairs.
+    int concurrency = 1;
+    std::string pgn_path;               ///< Empty: no PGN.
+    std::string event = "huginn_match";
+    SprtConfig sprt;
+    int report_every = 10;              ///< Games between report lines.
+};
+
+struct MatchResult {
+    Score score;                        ///< From engines[0]'s point of view.
+    Sprt::Decision decision = Sprt::Decision::Continue;
+    uint64_t time_losses = 0;
+    uint64_t illegal_moves = 0;
+    bool ok = true;                     ///< False if an engine could not be started.
+    std::string error;
+};
+
+/// @brief Play the match, writing report lines to @p report.
+MatchResult run_match(const MatchConfig& config, std::ostream& report);
+
+} // namespace Match
+} // namespace Huginn
@@ -0,0 +1,483 @@
+// In-process and child-process players for huginn_match (user-050).
+
+#include "players.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <streambuf>
+#include <thread>
+
+#include "search.hpp"
+#include "syzygy_tablebase.hpp"
+#include "uci_utils.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace Huginn {
+namespace Match {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int64_t HANDSHAKE_TIMEOUT_MS = 10000;  // uciok / readyok
+constexpr int64_t STOP_GRACE_MS = 1000;          // bestmove after a late `stop`
+constexpr size_t IN_PROCESS_DEFAULT_HASH_MB = 16;
+
+const std::string START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+int64_t ms_until(Clock::time_point deadline) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+}
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+std::vector<std::string> split_words(const std::string& s) {
+    std::istringstream in(s);
+    std::vector<std::string> words;
+    std::string w;
+    while (in >> w) words.push_back(w);
+    return words;
+}
+
+std::vector<std::string> go_tokens(const MoveRequest& r) {
+    return {"go", "wtime", std::to_string(r.wtime_ms), "btime", std::to_string(r.btime_ms),
+            "winc", std::to_string(r.winc_ms), "binc", std::to_string(r.binc_ms)};
+}
+
+// ---------------------------------------------------------------------------
+// In-process
+// ---------------------------------------------------------------------------
+
+class InProcessPlayer : public Player {
+public:
+    explicit InProcessPlayer(const EngineConfig& config) : config_(config), null_out_(&null_buffer_) {}
+
+    bool start(std::string& error) override {
+        tablebase_ = std::make_unique<SyzygyTablebase>();
+        engine_ = std::make_unique<Engine>(tablebase_.get());
+        engine_->info_out = &null_out_;
+        engine_->tt_table.resize_mb(IN_PROCESS_DEFAULT_HASH_MB);
+        std::string book_file = "src/performance.bin";
+        bool own_book = false;
+        for (const auto& [name, value] : config_.options) {
+            long long v = 0;
+            bool ok = true;
+            if (name == "Hash") {
+                ok = parse_spin_clamped(value, 1, 4096, v);
+                if (ok) engine_->tt_table.resize_mb(static_cast<size_t>(v));
+            } else if (name == "SyzygyPath") {
+                ok = tablebase_->initialize(value);
+            } else if (name == "SyzygyProbeDepth") {
+                ok = parse_spin_clamped(value, 1, 100, v);
+                if (ok) engine_->syzygy_probe_depth = static_cast<int>(v);
+            } else if (name == "SyzygyProbeLimit") {
+                ok = parse_spin_clamped(value, 0, 7, v);
+                if (ok) engine_->syzygy_probe_limit = static_cast<int>(v);
+            } else if (name == "EGTBFile") {
+                ok = engine_->load_endgame_tables(value);
+            } else if (name == "OwnBook") {
+                own_book = (value == "true");
+            } else if (name == "BookFile") {
+                book_file = value;
+            } else if (name == "BookSeed") {
+                ok = parse_spin_clamped(value, 0, 2147483647, v);
+                if (ok) book_seed_ = static_cast<uint64_t>(v);
+            } else {
+                error = config_.name + ": option " + name + " is not supported in-process";
+                return false;
+            }
+            if (!ok) {
+                error = config_.name + ": bad value for " + name + ": " + value;
+                return false;
+            }
+        }
+        if (own_book && !engine_->load_opening_book(book_file)) {
+            error = config_.name + ": cannot load book " + book_file;
+            return false;
+        }
+        return true;
+    }
+
+    void new_game(uint64_t game_seed) override {
+        // Same as the UCI front-end's `ucinewgame`
+        engine_->reset();
+        engine_->tt_table.clear();
+        engine_->clear_search_tables();
+        if (book_seed_ != 0) {
+            engine_->opening_book.set_seed(book_seed_ ^ (game_seed * 0x9E3779B97F4A7C15ULL));
+        }
+    }
+
+    MoveReply go(const MoveRequest& request, int64_t) override {
+        Position root = *request.position;
+        bool infinite_requested = false;
+        const MinimalLimits limits = parse_go_command(go_tokens(request), root.side_to_move, infinite_requested);
+
+        SearchInfo info;
+        info.max_depth = limits.max_depth;
+        info.infinite = limits.infinite;
+        info.start_time = Clock::now();
+        info.stop_time = info.start_time + std::chrono::milliseconds(limits.max_time_ms);
+
+        engine_->reset();
+        MoveReply reply;
+        reply.move = engine_->searchPosition(root, info);
+        reply.text = reply.move.to_string();
+        // The reported score belongs to the move only if the search (not the
+        // book or a table) chose it
+        if (!engine_->root_lines.empty() && engine_->root_lines[0].move.move == reply.move.move
+                && reply.move.move != 0) {
+            reply.has_score = true;
+            reply.score = engine_->root_lines[0].score;
+        }
+        return reply;
+    }
+
+private:
+    EngineConfig config_;
+    NullBuffer null_buffer_;
+    std::ostream null_out_;
+    std::unique_ptr<SyzygyTablebase> tablebase_;
+    std::unique_ptr<Engine> engine_;
+    uint64_t book_seed_ = 0;  ///< 0: the book keeps its random seed.
+};
+
+// ---------------------------------------------------------------------------
+// Child process
+// ---------------------------------------------------------------------------
+
+/// Two pipes to a child's stdin / stdout; stderr is inherited.
+class ChildProcess {
+public:
+    ChildProcess() = default;
+    ChildProcess(const ChildProcess&) = delete;
+    ChildProcess& operator=(const ChildProcess&) = delete;
+    ~ChildProcess() { stop(); }
+
+    bool start(const std::string& command);
+    bool write_line(const std::string& line);
+    /// Next line without its terminator; false on timeout or end of output.
+    bool read_line(std::string& line, int64_t timeout_ms);
+    bool eof() const { return eof_; }
+    void stop();
+
+private:
+    bool take_line(std::string& line);
+    /// Append whatever arrives within @p timeout_ms; false on end of output.
+    bool fill(int64_t timeout_ms);
+
+    std::string buffer_;
+    bool eof_ = false;
+#ifdef _WIN32
+    HANDLE process_ = nullptr;
+    HANDLE in_w_ = nullptr;
+    HANDLE out_r_ = nullptr;
+#else
+    pid_t pid_ = -1;
+    int in_fd_ = -1;
+    int out_fd_ = -1;
+#endif
+};
+
+bool ChildProcess::take_line(std::string& line) {
+    const size_t nl = buffer_.find('\n');
+    if (nl == std::string::npos) return false;
+    line.assign(buffer_, 0, nl);
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    buffer_.erase(0, nl + 1);
+    return true;
+}
+
+bool ChildProcess::read_line(std::string& line, int64_t timeout_ms) {
+    const auto deadline = Clock::now() + std::chrono::milliseconds(std::max<int64_t>(timeout_ms, 0));
+    while (!take_line(line)) {
+        if (eof_) return false;
+        const int64_t left = ms_until(deadline);
+        if (left < 0) return false;
+        if (!fill(left)) eof_ = true;
+    }
+    return true;
+}
+
+#ifdef _WIN32
+
+bool ChildProcess::start(const std::string& command) {
+    SECURITY_ATTRIBUTES sa{sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE};
+    HANDLE out_w = nullptr, in_r = nullptr;
+    if (!CreatePipe(&out_r_, &out_w, &sa, 0)) return false;
+    SetHandleInformation(out_r_, HANDLE_FLAG_INHERIT, 0);
+    if (!CreatePipe(&in_r, &in_w_, &sa, 0)) return false;
+    SetHandleInformation(in_w_, HANDLE_FLAG_INHERIT, 0);
+
+    STARTUPINFOA si{};
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = in_r;
+    si.hStdOutput = out_w;
+    si.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+
+    std::string cmd = command;
+    PROCESS_INFORMATION pi{};
+    const BOOL ok = CreateProcessA(nullptr, &cmd[0], nullptr, nullptr, TRUE, CREATE_NO_WINDOW,
+                                   nullptr, nullptr, &si, &pi);
+    CloseHandle(in_r);
+    CloseHandle(out_w);
+    if (!ok) return false;
+    process_ = pi.hProcess;
+    CloseHandle(pi.hThread);
+    return true;
+}
+
+bool ChildProcess::write_line(const std::string& line) {
+    const std::string data = line + "\n";
+    DWORD written = 0;
+    return in_w_ && WriteFile(in_w_, data.data(), static_cast<DWORD>(data.size()), &written, nullptr)
+           && written == data.size();
+}
+
+bool ChildProcess::fill(int64_t timeout_ms) {
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+    for (;;) {
+        DWORD avail = 0;
+        if (!PeekNamedPipe(out_r_, nullptr, 0, nullptr, &avail, nullptr)) return false;
+        if (avail > 0) {
+            char buf[4096];
+            DWORD got = 0;
+            if (!ReadFile(out_r_, buf, std::min<DWORD>(avail, sizeof(buf)), &got, nullptr) || got == 0) return false;
+            buffer_.append(buf, got);
+            return true;
+        }
+        if (ms_until(deadline) < 0) return true;
+        Sleep(1);
+    }
+}
+
+void ChildProcess::stop() {
+    if (!process_) return;
+    write_line("quit");
+    if (WaitForSingleObject(process_, static_cast<DWORD>(STOP_GRACE_MS)) != WAIT_OBJECT_0) {
+        TerminateProcess(process_, 1);
+    }
+    CloseHandle(in_w_);
+    CloseHandle(out_r_);
+    CloseHandle(process_);
+    process_ = in_w_ = out_r_ = nullptr;
+}
+
+#else
+
+bool ChildProcess::start(const std::string& command) {
+    // A child that dies mid-game must fail our write, not kill the match
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::vector<std::string> words = split_words(command);
+    if (words.empty()) return false;
+    std::vector<char*> argv;
+    for (std::string& w : words) argv.push_back(w.data());
+    argv.push_back(nullptr);
+
+    int to_child[2], from_child[2];
+    if (pipe(to_child) != 0) return false;
+    if (pipe(from_child) != 0) {
+        close(to_child[0]);
+        close(to_child[1]);
+        return false;
+    }
+    // Other slots' children must not inherit these ends
+    for (int fd : {to_child[0], to_child[1], from_child[0], from_child[1]}) fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    pid_ = fork();
+    if (pid_ == 0) {
+        dup2(to_child[0], STDIN_FILENO);
+        dup2(from_child[1], STDOUT_FILENO);
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+    close(to_child[0]);
+    close(from_child[1]);
+    if (pid_ < 0) {
+        close(to_child[1]);
+        close(from_child[0]);
+        return false;
+    }
+    in_fd_ = to_child[1];
+    out_fd_ = from_child[0];
+    return true;
+}
+
+bool ChildProcess::write_line(const std::string& line) {
+    if (in_fd_ < 0) return false;
+    const std::string data = line + "\n";
+    size_t done = 0;
+    while (done < data.size()) {
+        const ssize_t n = write(in_fd_, data.data() + done, data.size() - done);
+        if (n <= 0) return false;
+        done += size_t(n);
+    }
+    return true;
+}
+
+bool ChildProcess::fill(int64_t timeout_ms) {
+    pollfd pfd{out_fd_, POLLIN, 0};
+    const int ready = poll(&pfd, 1, int(std::min<int64_t>(timeout_ms, 1 << 30)));
+    if (ready < 0) return errno == EINTR;
+    if (ready == 0) return true;  // timeout: no data yet, not the end
+    char buf[4096];
+    const ssize_t n = read(out_fd_, buf, sizeof(buf));
+    if (n <= 0) return false;
+    buffer_.append(buf, size_t(n));
+    return true;
+}
+
+void ChildProcess::stop() {
+    if (pid_ <= 0) return;
+    write_line("quit");
+    close(in_fd_);
+    const auto deadline = Clock::now() + std::chrono::milliseconds(STOP_GRACE_MS);
+    int status = 0;
+    while (waitpid(pid_, &status, WNOHANG) == 0) {
+        if (ms_until(deadline) < 0) {
+            kill(pid_, SIGKILL);
+            waitpid(pid_, &status, 0);
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    close(out_fd_);
+    pid_ = -1;
+    in_fd_ = out_fd_ = -1;
+}
+
+#endif
+
+class ProcessPlayer : public Player {
+public:
+    explicit ProcessPlayer(const EngineConfig& config) : config_(config) {}
+
+    bool start(std::string& error) override {
+        if (!process_.start(config_.command)) {
+            error = config_.name + ": cannot start " + config_.command;
+            return false;
+        }
+        if (!process_.write_line("uci") || !wait_for("uciok", HANDSHAKE_TIMEOUT_MS)) {
+            error = config_.name + ": no uciok from " + config_.command;
+            return false;
+        }
+        for (const auto& [name, value] : config_.options) {
+            process_.write_line("setoption name " + name + " value " + value);
+        }
+        if (!sync()) {
+            error = config_.name + ": no readyok after setoption";
+            return false;
+        }
+        return true;
+    }
+
+    void new_game(uint64_t) override {
+        process_.write_line("ucinewgame");
+        sync();
+    }
+
+    MoveReply go(const MoveRequest& request, int64_t deadline_ms) override {
+        MoveReply reply;
+        std::string cmd = (*request.start_fen == START_FEN) ? "position startpos"
+                                                            : "position fen " + *request.start_fen;
+        if (!request.moves->empty()) {
+            cmd += " moves";
+            for (const std::string& m : *request.moves) cmd += " " + m;
+        }
+        std::string go;
+        for (const std::string& t : go_tokens(request)) go += (go.empty() ? "" : " ") + t;
+        if (!process_.write_line(cmd) || !process_.write_line(go)) {
+            reply.crashed = true;
+            return reply;
+        }
+
+        const auto deadline = Clock::now() + std::chrono::milliseconds(deadline_ms);
+        bool stop_sent = false;
+        std::string line;
+        for (;;) {
+            const int64_t left = ms_until(deadline);
+            if (!process_.read_line(line, stop_sent ? STOP_GRACE_MS : std::max<int64_t>(left, 0))) {
+                if (process_.eof() || stop_sent) {
+                    reply.crashed = true;
+                    return reply;
+                }
+                // Out of time: ask for the move anyway; the game loop sees the clock
+                process_.write_line("stop");
+                stop_sent = true;
+                continue;
+            }
+            if (line.rfind("info ", 0) == 0) {
+                parse_score(line, reply);
+            } else if (line.rfind("bestmove", 0) == 0) {
+                const std::vector<std::string> words = split_words(line);
+                if (words.size() > 1) {
+                    reply.text = words[1];
+                    reply.move = parse_uci_move(words[1], *request.position);
+                }
+                return reply;
+            }
+        }
+    }
+
+private:
+    bool wait_for(const std::string& token, int64_t timeout_ms) {
+        const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+        std::string line;
+        while (process_.read_line(line, ms_until(deadline))) {
+            if (line == token) return true;
+        }
+        return false;
+    }
+
+    bool sync() {
+        return process_.write_line("isready") && wait_for("readyok", HANDSHAKE_TIMEOUT_MS);
+    }
+
+    static void parse_score(const std::string& line, MoveReply& reply) {
+        const std::vector<std::string> w = split_words(line);
+        for (size_t i = 0; i + 2 < w.size(); ++i) {
+            if (w[i] != "score") continue;
+            const int v = std::atoi(w[i + 2].c_str());
+            if (w[i + 1] == "cp") {
+                reply.score = v;
+            } else if (w[i + 1] == "mate") {
+                reply.score = v > 0 ? MATE - (2 * v - 1) : -MATE - 2 * v;
+            } else {
+                return;
+            }
+            reply.has_score = true;
+            return;
+        }
+    }
+
+    EngineConfig config_;
+    ChildProcess process_;
+};
+
+} // namespace
+
+std::unique_ptr<Player> make_player(const EngineConfig& config) {
+    if (config.command.empty()) return std::make_unique<InProcessPlayer>(config);
+    return std::make_unique<ProcessPlayer>(config);
+}
+
+} // namespace Match
+} // namespace Huginn
@@ -0,0 +1,72 @@
+/**
+ * @file players.hpp
+ * @brief The two kinds of engine huginn_match can pit against each other (user-050).
+ *
+ * - In-process: a private Huginn::Engine driven the way the UCI front-end
+ *   drives it (same `go` parsing and time allocation), with its `info` output
+ *   sent to its own sink. Options are the UCI ones that change play: Hash,
+ *   SyzygyPath / SyzygyProbeDepth / SyzygyProbeLimit, EGTBFile, OwnBook /
+ *   BookFile / BookSeed. With a BookSeed the book is reseeded from it and
+ *   the game number at every new game, so a game's book moves do not depend
+ *   on which slot happened to play it.
+ * - Child process: any UCI engine, started once per game slot and spoken to
+ *   over pipes; `setoption` is sent verbatim.
+ *
+ * Each game slot owns its players, so nothing here is shared between threads.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "move.hpp"
+#include "position.hpp"
+
+namespace Huginn {
+namespace Match {
+
+/// @brief One side of the match, as given on the command line.
+struct EngineConfig {
+    std::string name;
+    std::string command;  ///< Empty: in-process Engine. Otherwise the program (and arguments) to run.
+    std::vector<std::pair<std::string, std::string>> options;  ///< UCI options, applied in order.
+};
+
+/// @brief Where a move request stands: the game so far and both clocks.
+struct MoveRequest {
+    const std::string* start_fen = nullptr;        ///< Opening position.
+    const std::vector<std::string>* moves = nullptr;  ///< Moves since it, long algebraic.
+    Position* position = nullptr;                  ///< Current position, with history for repetitions.
+    int64_t wtime_ms = 0, btime_ms = 0;
+    int64_t winc_ms = 0, binc_ms = 0;
+};
+
+struct MoveReply {
+    S_MOVE move;               ///< Null move if the engine sent none or an illegal one.
+    std::string text;          ///< The move as sent (for error reports).
+    bool has_score = false;
+    int score = 0;             ///< Last reported score, side to move's view (mate as ±(MATE - plies)).
+    bool crashed = false;      ///< The engine process is gone or stopped answering.
+};
+
+class Player {
+public:
+    virtual ~Player() = default;
+
+    /// @brief Start the engine and apply the options. False with @p error set on failure.
+    virtual bool start(std::string& error) = 0;
+    /// @brief Reset for a new game; @p game_seed (the game number) keeps
+    ///        seeded book choices repeatable across slots.
+    virtual void new_game(uint64_t game_seed) = 0;
+    /// @brief Think on @p request; must answer within @p deadline_ms of wall time
+    ///        (a child process that has not is stopped and its reply is late).
+    virtual MoveReply go(const MoveRequest& request, int64_t deadline_ms) = 0;
+};
+
+std::unique_ptr<Player> make_player(const EngineConfig& config);
+
+} // namespace Match
+} // namespace Huginn
@@ -0,0 +1,88 @@
+// Elo, LOS and SPRT arithmetic for huginn_match (user-050).
+
+#include "sprt.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace Huginn {
+namespace Match {
+
+namespace {
+
+double score_to_elo(double x) {
+    x = std::clamp(x, 1e-6, 1.0 - 1e-6);
+    return -400.0 * std::log10(1.0 / x - 1.0);
+}
+
+double elo_to_score(double elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+// Per-game variance of the score around its mean
+double score_variance(const Score& s) {
+    const double n = double(s.games());
+    if (n == 0) return 0.0;
+    const double x = s.mean();
+    return (s.wins * (1.0 - x) * (1.0 - x) + s.draws * (0.5 - x) * (0.5 - x) + s.losses * x * x) / n;
+}
+
+} // namespace
+
+EloEstimate estimate_elo(const Score& score) {
+    EloEstimate e;
+    const uint64_t n = score.games();
+    if (n == 0) return e;
+    const double x = score.mean();
+    const double sd = std::sqrt(score_variance(score) / double(n));
+    e.elo = score_to_elo(x);
+    e.error95 = (score_to_elo(x + 1.96 * sd) - score_to_elo(x - 1.96 * sd)) / 2.0;
+    const uint64_t decisive = score.wins + score.losses;
+    if (decisive > 0) {
+        e.los = 0.5 * (1.0 + std::erf((double(score.wins) - double(score.losses)) / std::sqrt(2.0 * decisive)));
+    }
+    return e;
+}
+
+double Sprt::lower_bound() const {
+    return std::log(config_.beta / (1.0 - config_.alpha));
+}
+
+double Sprt::upper_bound() const {
+    return std::log((1.0 - config_.beta) / config_.alpha);
+}
+
+double Sprt::llr(const Score& score) const {
+    const double var = score_variance(score);
+    if (var <= 0.0) return 0.0;
+    const double s0 = elo_to_score(config_.elo0);
+    const double s1 = elo_to_score(config_.elo1);
+    return double(score.games()) * (s1 - s0) * (2.0 * score.mean() - s0 - s1) / (2.0 * var);
+}
+
+Sprt::Decision Sprt::decide(const Score& score) const {
+    const double l = llr(score);
+    if (l >= upper_bound()) return Decision::AcceptH1;
+    if (l <= lower_bound()) return Decision::AcceptH0;
+    return Decision::Continue;
+}
+
+std::string format_report(const Score& score, const Sprt& sprt) {
+    const EloEstimate e = estimate_elo(score);
+    char buf[256];
+    int n = std::snprintf(buf, sizeof(buf),
+                          "Games %llu (W %llu D %llu L %llu)  Elo %.1f +/- %.1f  LOS %.1f%%",
+                          (unsigned long long)score.games(), (unsigned long long)score.wins,
+                          (unsigned long long)score.draws, (unsigned long long)score.losses,
+                          e.elo, e.error95, e.los * 100.0);
+    if (sprt.config().enabled && n > 0 && n < int(sizeof(buf))) {
+        std::snprintf(buf + n, sizeof(buf) - n, "  LLR %.2f [%.2f, %.2f] (elo0 %g, elo1 %g)",
+                      sprt.llr(score), sprt.lower_bound(), sprt.upper_bound(),
+                      sprt.config().elo0, sprt.config().elo1);
+    }
+    return buf;
+}
+
+} // namespace Match
+} // namespace Huginn
@@ -0,0 +1,73 @@
+/**
+ * @file sprt.hpp
+ * @brief Match statistics for huginn_match (user-050): Elo estimate, LOS and
+ *        the sequential probability ratio test.
+ *
+ * The SPRT is the trinomial GSPRT on logistic Elo that fishtest and
+ * cutechess-cli used before pentanomial reporting: with the per-game score
+ * mean x and variance v of N games, LLR = N (s1 - s0)(2x - s0 - s1) / (2v),
+ * where s0 / s1 are the expected scores at elo0 / elo1. The test accepts H1
+ * at LLR >= ln((1 - beta) / alpha) and H0 at LLR <= ln(beta / (1 - alpha)).
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Huginn {
+namespace Match {
+
+/// @brief Game results from the first engine's point of view.
+struct Score {
+    uint64_t wins = 0;
+    uint64_t draws = 0;
+    uint64_t losses = 0;
+
+    uint64_t games() const { return wins + draws + losses; }
+    /// @brief Mean score per game in [0, 1]; 0.5 with no games.
+    double mean() const { return games() ? (wins + 0.5 * draws) / double(games()) : 0.5; }
+};
+
+/// @brief Elo difference with its 95% confidence half-width, and the
+///        likelihood of superiority (draws ignored).
+struct EloEstimate {
+    double elo = 0.0;
+    double error95 = 0.0;
+    double los = 0.5;
+};
+
+EloEstimate estimate_elo(const Score& score);
+
+struct SprtConfig {
+    bool enabled = false;
+    double elo0 = 0.0;
+    double elo1 = 5.0;
+    double alpha = 0.05;
+    double beta = 0.05;
+};
+
+class Sprt {
+public:
+    enum class Decision { Continue, AcceptH0, AcceptH1 };
+
+    explicit Sprt(const SprtConfig& config) : config_(config) {}
+
+    double lower_bound() const;
+    double upper_bound() const;
+    /// @brief Log-likelihood ratio of H1 (elo1) over H0 (elo0); 0 until the
+    ///        results have any variance.
+    double llr(const Score& score) const;
+    Decision decide(const Score& score) const;
+
+    const SprtConfig& config() const { return config_; }
+
+private:
+    SprtConfig config_;
+};
+
+/// @brief "Games 100 (W 40 D 30 L 30)  Elo 34.9 +/- 58.1  LOS 88.4%" plus the
+///        LLR and its bounds when @p sprt is enabled.
+std::string format_report(const Score& score, const Sprt& sprt);
+
+} // namespace Match
+} // namespace Huginn